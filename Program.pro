@@ -27,12 +27,23 @@ SOURCES += \
     src/code/ui/analysispage.cpp \
     src/code/ui/processselectiondialog.cpp \
     src/code/chart/chartwidget.cpp \
+    src/code/monitor/cgroupmonitor.cpp \
     src/code/monitor/cpumonitor.cpp \
+    src/code/monitor/cpusensormonitor.cpp \
+    src/code/monitor/counterrate.cpp \
     src/code/monitor/memorymonitor.cpp \
     src/code/monitor/diskmonitor.cpp \
+    src/code/monitor/gpuprobe.cpp \
+    src/code/monitor/gputelemetry.cpp \
     src/code/monitor/networkmonitor.cpp \
+    src/code/monitor/pressuremonitor.cpp \
+    src/code/monitor/processeventsource.cpp \
     src/code/monitor/processmonitor.cpp \
+    src/code/monitor/procfsbatchreader.cpp \
+    src/code/monitor/procfsreader.cpp \
     src/code/monitor/sampler.cpp \
+    src/code/monitor/socketdiag.cpp \
+    src/code/monitor/workstealingpool.cpp \
     src/code/storage/datastorage.cpp \
     src/code/storage/exporter.cpp \
     src/code/analysis/anomalydetector.cpp \
@@ -53,12 +64,28 @@ HEADERS += \
     src/include/ui/analysispage.h \
     src/include/ui/processselectiondialog.h \
     src/include/chart/chartwidget.h \
+    src/include/common/monotonicclock.h \
+    src/include/monitor/cgroupmonitor.h \
     src/include/monitor/cpumonitor.h \
+    src/include/monitor/cpusensormonitor.h \
+    src/include/monitor/counterrate.h \
+    src/include/monitor/topkselector.h \
     src/include/monitor/memorymonitor.h \
     src/include/monitor/diskmonitor.h \
+    src/include/monitor/gpuprobe.h \
+    src/include/monitor/gputelemetry.h \
     src/include/monitor/networkmonitor.h \
+    src/include/monitor/pressuremonitor.h \
+    src/include/monitor/processeventsource.h \
     src/include/monitor/processmonitor.h \
+    src/include/monitor/procfsbatchreader.h \
+    src/include/monitor/procfsreader.h \
+    src/include/monitor/samplerecord.h \
+    src/include/monitor/spscring.h \
     src/include/monitor/sampler.h \
+    src/include/monitor/socketdiag.h \
+    src/include/monitor/workstealingpool.h \
+    src/include/monitor/systemsnapshot.h \
     src/include/storage/datastorage.h \
     src/include/storage/exporter.h \
     src/include/analysis/anomalydetector.h \
@@ -133,6 +160,9 @@ win32 {
     }
 }
 
+# NVML ʱͨ dlopen أ libnvidia-ml
+unix: LIBS += -ldl
+
 # ??????????????????????????
 OBJECTS_DIR = build/obj
 MOC_DIR = build/moc
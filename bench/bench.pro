@@ -0,0 +1,7 @@
+# 性能基准：qmake bench.pro && make，然后分别运行各子目录下的程序，结果输出到标准输出
+# 只有 Linux 下有意义，测的是 /proc 读取路径
+TEMPLATE = subdirs
+SUBDIRS += \
+    procfsread \
+    procscan \
+    procbatch
@@ -0,0 +1,29 @@
+QT += core
+QT -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = bench_procbatch
+TEMPLATE = app
+
+# 源文件按仓库根目录引用头文件
+ROOT = $$PWD/../..
+INCLUDEPATH += $$ROOT
+
+SOURCES += \
+    bench_procbatch.cpp \
+    $$ROOT/src/code/monitor/processeventsource.cpp \
+    $$ROOT/src/code/monitor/processmonitor.cpp \
+    $$ROOT/src/code/monitor/procfsbatchreader.cpp \
+    $$ROOT/src/code/monitor/procfsreader.cpp \
+    $$ROOT/src/code/monitor/socketdiag.cpp \
+    $$ROOT/src/code/monitor/workstealingpool.cpp
+
+HEADERS += \
+    $$ROOT/src/include/monitor/processeventsource.h \
+    $$ROOT/src/include/monitor/processmonitor.h \
+    $$ROOT/src/include/monitor/procfsbatchreader.h \
+    $$ROOT/src/include/monitor/procfsreader.h \
+    $$ROOT/src/include/monitor/socketdiag.h \
+    $$ROOT/src/include/monitor/workstealingpool.h
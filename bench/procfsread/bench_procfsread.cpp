@@ -0,0 +1,161 @@
+// bench_procfsread.cpp
+// 每次采样读取 /proc/stat、/proc/meminfo、/proc/diskstats、/proc/net/dev 的开销。
+// 旧路径照搬改用 ProcfsFile 之前各监视器的写法（每次构造 ifstream，逐行 istringstream 解析），
+// 新路径与现在的监视器相同（常开 fd 上 pread 到复用缓冲区，ProcfsTokenizer 原地解析）。
+// 用法：bench_procfsread [采样次数]，默认 20000
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "src/include/monitor/procfsreader.h"
+
+namespace {
+
+// 累加读到的值，防止编译器把解析优化掉
+quint64 g_sink = 0;
+
+void sampleWithStreams()
+{
+    {
+        std::ifstream file("/proc/stat");
+        std::string line;
+        std::getline(file, line);
+        std::istringstream iss(line);
+        std::string cpu;
+        quint64 user = 0, nice = 0, system = 0, idle = 0;
+        iss >> cpu >> user >> nice >> system >> idle;
+        g_sink += user + nice + system + idle;
+    }
+    {
+        std::ifstream file("/proc/meminfo");
+        std::string line;
+        long total = 0, free = 0, buffers = 0, cached = 0;
+        while (std::getline(file, line)) {
+            if (line.compare(0, 9, "MemTotal:") == 0) sscanf(line.c_str(), "MemTotal: %ld kB", &total);
+            else if (line.compare(0, 8, "MemFree:") == 0) sscanf(line.c_str(), "MemFree: %ld kB", &free);
+            else if (line.compare(0, 8, "Buffers:") == 0) sscanf(line.c_str(), "Buffers: %ld kB", &buffers);
+            else if (line.compare(0, 7, "Cached:") == 0) sscanf(line.c_str(), "Cached: %ld kB", &cached);
+        }
+        g_sink += total + free + buffers + cached;
+    }
+    {
+        std::ifstream file("/proc/diskstats");
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream iss(line);
+            std::string dev;
+            quint64 major = 0, minor = 0, reads = 0, rdMerged = 0, rdSectors = 0, rdTime = 0;
+            quint64 writes = 0, wrMerged = 0, wrSectors = 0, wrTime = 0;
+            iss >> major >> minor >> dev;
+            iss >> reads >> rdMerged >> rdSectors >> rdTime;
+            iss >> writes >> wrMerged >> wrSectors >> wrTime;
+            g_sink += rdSectors + wrSectors;
+        }
+    }
+    {
+        std::ifstream file("/proc/net/dev");
+        std::string line;
+        int lineNo = 0;
+        while (std::getline(file, line)) {
+            if (++lineNo <= 2) continue;
+            std::istringstream iss(line);
+            std::string iface;
+            quint64 recvBytes = 0, sentBytes = 0;
+            iss >> iface;
+            iface = iface.substr(0, iface.find(':'));
+            iss >> recvBytes;
+            for (int i = 0; i < 7; ++i) iss >> std::ws >> sentBytes;
+            if (iface != "lo") g_sink += recvBytes + sentBytes;
+        }
+    }
+}
+
+ProcfsFile g_stat("/proc/stat");
+ProcfsFile g_meminfo("/proc/meminfo");
+ProcfsFile g_diskstats("/proc/diskstats");
+ProcfsFile g_netdev("/proc/net/dev");
+
+void sampleWithProcfsFile()
+{
+    const char *word;
+    size_t length;
+    if (g_stat.refresh()) {
+        ProcfsTokenizer t(g_stat);
+        quint64 user = 0, nice = 0, system = 0, idle = 0;
+        t.nextWord(word, length);
+        t.nextU64(user);
+        t.nextU64(nice);
+        t.nextU64(system);
+        t.nextU64(idle);
+        g_sink += user + nice + system + idle;
+    }
+    if (g_meminfo.refresh()) {
+        ProcfsTokenizer t(g_meminfo);
+        int found = 0;
+        do {
+            quint64 value = 0;
+            if (!t.nextWord(word, length)) continue;
+            if (ProcfsTokenizer::equals(word, length, "MemTotal") || ProcfsTokenizer::equals(word, length, "MemFree")
+                || ProcfsTokenizer::equals(word, length, "Buffers") || ProcfsTokenizer::equals(word, length, "Cached")) {
+                t.nextU64(value);
+                g_sink += value;
+                if (++found == 4) break;
+            }
+        } while (t.nextLine());
+    }
+    if (g_diskstats.refresh()) {
+        ProcfsTokenizer t(g_diskstats);
+        do {
+            quint64 rdSectors = 0, wrSectors = 0;
+            if (!t.skipFields(2) || !t.nextWord(word, length)) continue;
+            t.skipFields(2);
+            t.nextU64(rdSectors);
+            t.skipFields(3);
+            t.nextU64(wrSectors);
+            g_sink += rdSectors + wrSectors;
+        } while (t.nextLine());
+    }
+    if (g_netdev.refresh()) {
+        ProcfsTokenizer t(g_netdev);
+        t.nextLine();
+        while (t.nextLine()) {
+            quint64 recvBytes = 0, sentBytes = 0;
+            if (!t.nextWord(word, length) || !t.nextU64(recvBytes)) continue;
+            t.skipFields(7);
+            t.nextU64(sentBytes);
+            if (!ProcfsTokenizer::equals(word, length, "lo:")) g_sink += recvBytes + sentBytes;
+        }
+    }
+}
+
+// 返回每次采样的平均耗时（微秒）
+template <class Sample>
+double measure(Sample sample, int iterations)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) sample();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::micro>(elapsed).count() / iterations;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const int iterations = argc > 1 ? std::max(1, atoi(argv[1])) : 20000;
+
+    // 预热：填充页缓存，让 ProcfsFile 的缓冲区长到足够大
+    measure(sampleWithStreams, 1000);
+    measure(sampleWithProcfsFile, 1000);
+
+    const double streams = measure(sampleWithStreams, iterations);
+    const double procfs = measure(sampleWithProcfsFile, iterations);
+    printf("samples: %d\n", iterations);
+    printf("ifstream + istringstream: %8.2f us/sample\n", streams);
+    printf("pread + ProcfsTokenizer:  %8.2f us/sample\n", procfs);
+    printf("speedup:                  %8.2fx\n", streams / procfs);
+    return g_sink == 1 ? 1 : 0;
+}
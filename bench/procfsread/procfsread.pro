@@ -0,0 +1,19 @@
+QT += core
+QT -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = bench_procfsread
+TEMPLATE = app
+
+# 源文件按仓库根目录引用头文件
+ROOT = $$PWD/../..
+INCLUDEPATH += $$ROOT
+
+SOURCES += \
+    bench_procfsread.cpp \
+    $$ROOT/src/code/monitor/procfsreader.cpp
+
+HEADERS += \
+    $$ROOT/src/include/monitor/procfsreader.h
@@ -0,0 +1,76 @@
+// bench_procscan.cpp
+// ProcessMonitor::refresh() 扫描 /proc 的耗时随进程数和扫描线程数的变化。
+// fork 出空闲子进程把进程数抬高到各个目标值，每种组合先刷新一次建立进程表，再取 10 次刷新的平均值和最小值。
+// 用法：bench_procscan [目标子进程数...]，默认 0 2000 5000 10000；受 RLIMIT_NPROC 限制时停在能创建的数量
+#include <QList>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "src/include/monitor/processmonitor.h"
+
+namespace {
+
+const int Refreshes = 10;
+
+std::vector<pid_t> g_children;
+
+// 把子进程补到 count 个，返回实际个数
+int spawnChildren(int count)
+{
+    while (static_cast<int>(g_children.size()) < count) {
+        const pid_t pid = fork();
+        if (pid == 0) {
+            pause();
+            _exit(0);
+        }
+        if (pid < 0) {
+            perror("fork");
+            break;
+        }
+        g_children.push_back(pid);
+    }
+    return static_cast<int>(g_children.size());
+}
+
+void killChildren()
+{
+    for (pid_t pid : g_children) kill(pid, SIGKILL);
+    for (pid_t pid : g_children) waitpid(pid, nullptr, 0);
+    g_children.clear();
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QList<int> targets;
+    for (int i = 1; i < argc; ++i) targets.append(atoi(argv[i]));
+    if (targets.isEmpty()) targets = {0, 2000, 5000, 10000};
+
+    printf("%8s %8s %12s %12s\n", "procs", "threads", "mean (ms)", "best (ms)");
+    for (int target : targets) {
+        const int spawned = spawnChildren(target);
+        for (int threads : {1, 2, 4, 8}) {
+            ProcessMonitor monitor;
+            monitor.setScanThreadCount(threads);
+            monitor.refresh();
+
+            qint64 total = 0;
+            qint64 best = 0;
+            for (int i = 0; i < Refreshes; ++i) {
+                monitor.refresh();
+                total += monitor.lastScanNs();
+                if (i == 0 || monitor.lastScanNs() < best) best = monitor.lastScanNs();
+            }
+            printf("%8d %8d %12.2f %12.2f\n", monitor.processCount(), threads,
+                   total / Refreshes / 1e6, best / 1e6);
+        }
+        if (spawned < target) break;
+    }
+
+    killChildren();
+    return 0;
+}
@@ -7,6 +7,7 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QStringList>
 
 AnomalyDetector::AnomalyDetector(QObject *parent)
     : QObject(parent)
@@ -18,30 +19,40 @@ AnomalyDetector::~AnomalyDetector()
 {
 }
 
-void AnomalyDetector::addCpuDataPoint(double value, const QDateTime& timestamp)
+void AnomalyDetector::addCpuDataPoint(double value, MonotonicNs timestamp)
 {
     m_cpuHistory.append(qMakePair(timestamp, value));
     cleanupOldData();
 }
 
-void AnomalyDetector::addMemoryDataPoint(double value, const QDateTime& timestamp)
+void AnomalyDetector::addMemoryDataPoint(double value, MonotonicNs timestamp)
 {
     m_memoryHistory.append(qMakePair(timestamp, value));
     cleanupOldData();
 }
 
-void AnomalyDetector::addDiskDataPoint(double value, const QDateTime& timestamp)
+void AnomalyDetector::addDiskDataPoint(double value, MonotonicNs timestamp)
 {
     m_diskHistory.append(qMakePair(timestamp, value));
     cleanupOldData();
 }
 
-void AnomalyDetector::addNetworkDataPoint(double value, const QDateTime& timestamp)
+void AnomalyDetector::addNetworkDataPoint(double value, MonotonicNs timestamp)
 {
     m_networkHistory.append(qMakePair(timestamp, value));
     cleanupOldData();
 }
 
+void AnomalyDetector::addPagingDataPoint(double majorFaults, double swapPages, double directReclaimPages, double oomKills,
+                                         MonotonicNs timestamp)
+{
+    m_pagingHistory[PagingMajorFaults].append(qMakePair(timestamp, majorFaults));
+    m_pagingHistory[PagingSwap].append(qMakePair(timestamp, swapPages));
+    m_pagingHistory[PagingDirectReclaim].append(qMakePair(timestamp, directReclaimPages));
+    m_pagingHistory[PagingOomKills].append(qMakePair(timestamp, oomKills));
+    cleanupOldData();
+}
+
 bool AnomalyDetector::detectCpuAnomaly(double threshold)
 {
     if (m_cpuHistory.size() < 10) {
@@ -69,7 +80,7 @@ bool AnomalyDetector::detectCpuAnomaly(double threshold)
                             .arg(zScore, 0, 'f', 2)
                             .arg(threshold, 0, 'f', 2);
         m_anomalyDetails["CPU"] = details;
-        emit anomalyDetected("CPU", latestValue, threshold, m_cpuHistory.last().first);
+        emit anomalyDetected("CPU", latestValue, threshold, MonotonicClock::toDateTime(m_cpuHistory.last().first));
     }
     
     return isAnomaly;
@@ -102,7 +113,7 @@ bool AnomalyDetector::detectMemoryAnomaly(double threshold)
                             .arg(zScore, 0, 'f', 2)
                             .arg(threshold, 0, 'f', 2);
         m_anomalyDetails["Memory"] = details;
-        emit anomalyDetected("Memory", latestValue, threshold, m_memoryHistory.last().first);
+        emit anomalyDetected("Memory", latestValue, threshold, MonotonicClock::toDateTime(m_memoryHistory.last().first));
     }
     
     return isAnomaly;
@@ -135,7 +146,7 @@ bool AnomalyDetector::detectDiskAnomaly(double threshold)
                             .arg(zScore, 0, 'f', 2)
                             .arg(threshold, 0, 'f', 2);
         m_anomalyDetails["Disk"] = details;
-        emit anomalyDetected("Disk", latestValue, threshold, m_diskHistory.last().first);
+        emit anomalyDetected("Disk", latestValue, threshold, MonotonicClock::toDateTime(m_diskHistory.last().first));
     }
     
     return isAnomaly;
@@ -168,12 +179,80 @@ bool AnomalyDetector::detectNetworkAnomaly(double threshold)
                             .arg(zScore, 0, 'f', 2)
                             .arg(threshold, 0, 'f', 2);
         m_anomalyDetails["Network"] = details;
-        emit anomalyDetected("Network", latestValue, threshold, m_networkHistory.last().first);
+        emit anomalyDetected("Network", latestValue, threshold, MonotonicClock::toDateTime(m_networkHistory.last().first));
     }
     
     return isAnomaly;
 }
 
+bool AnomalyDetector::detectPagingAnomaly(double threshold)
+{
+    const QVector<QPair<MonotonicNs, double>> &oomHistory = m_pagingHistory[PagingOomKills];
+    if (oomHistory.isEmpty()) {
+        return false;
+    }
+    
+    // OOM kill 无论历史如何都是异常
+    if (oomHistory.last().second > 0.0) {
+        m_anomalyDetails["Paging"] = QString("内存不足: 内核 OOM killer 终止了进程 (%1 次/秒)")
+                                        .arg(oomHistory.last().second, 0, 'f', 2);
+        emit anomalyDetected("Paging", oomHistory.last().second, 0.0, MonotonicClock::toDateTime(oomHistory.last().first));
+        return true;
+    }
+    
+    if (oomHistory.size() < 10) {
+        return false; // 数据点太少，无法进行有效分析
+    }
+    
+    // 空闲系统上这些速率长期为 0，标准差极小，偶尔几个缺页就会得到很大的 Z 分数，
+    // 所以只有速率本身超过最小值才参与判断
+    static const double minimumRates[PagingOomKills] = {
+        50.0,    // 主缺页 (次/秒)
+        256.0,   // 换入 + 换出 (页/秒)，4K 页约 1 MB/s
+        1000.0   // 直接回收扫描 (页/秒)
+    };
+    static const char *const metricNames[PagingOomKills] = { "主缺页", "换页", "直接回收" };
+    
+    QStringList parts;
+    double worstZScore = 0.0;
+    double worstValue = 0.0;
+    for (int i = 0; i < PagingOomKills; ++i) {
+        const QVector<QPair<MonotonicNs, double>> &history = m_pagingHistory[i];
+        const double latestValue = history.last().second;
+        if (latestValue < minimumRates[i]) {
+            continue;
+        }
+        
+        QVector<double> historicalValues;
+        historicalValues.reserve(history.size());
+        for (const auto& pair : history) {
+            historicalValues.append(pair.second);
+        }
+        
+        const double zScore = calculateZScore(historicalValues, latestValue);
+        if (zScore > threshold) {
+            parts.append(QString("%1 %2/秒 (Z分数 %3)")
+                            .arg(metricNames[i])
+                            .arg(latestValue, 0, 'f', 0)
+                            .arg(zScore, 0, 'f', 2));
+            if (zScore > worstZScore) {
+                worstZScore = zScore;
+                worstValue = latestValue;
+            }
+        }
+    }
+    
+    if (parts.isEmpty()) {
+        return false;
+    }
+    
+    m_anomalyDetails["Paging"] = QString("分页与回收异常: %1 (阈值: %2)")
+                                    .arg(parts.join(", "))
+                                    .arg(threshold, 0, 'f', 2);
+    emit anomalyDetected("Paging", worstValue, threshold, MonotonicClock::toDateTime(oomHistory.last().first));
+    return true;
+}
+
 QString AnomalyDetector::getAnomalyDetails() const
 {
     if (m_anomalyDetails.isEmpty()) {
@@ -194,6 +273,9 @@ void AnomalyDetector::clearHistory()
     m_memoryHistory.clear();
     m_diskHistory.clear();
     m_networkHistory.clear();
+    for (int i = 0; i < PagingMetricCount; ++i) {
+        m_pagingHistory[i].clear();
+    }
     m_anomalyDetails.clear();
 }
 
@@ -486,7 +568,7 @@ void AnomalyDetector::resetToDefaultThresholds()
 
 void AnomalyDetector::cleanupOldData()
 {
-    QDateTime cutoffTime = QDateTime::currentDateTime().addSecs(-m_retentionHours * 3600);
+    MonotonicNs cutoffTime = MonotonicClock::now() - MonotonicClock::fromSecs(m_retentionHours * 3600LL);
     
     // 清理CPU历史数据
     while (!m_cpuHistory.isEmpty() && m_cpuHistory.first().first < cutoffTime) {
@@ -507,4 +589,11 @@ void AnomalyDetector::cleanupOldData()
     while (!m_networkHistory.isEmpty() && m_networkHistory.first().first < cutoffTime) {
         m_networkHistory.removeFirst();
     }
+    
+    // 清理分页与回收历史数据
+    for (int i = 0; i < PagingMetricCount; ++i) {
+        while (!m_pagingHistory[i].isEmpty() && m_pagingHistory[i].first().first < cutoffTime) {
+            m_pagingHistory[i].removeFirst();
+        }
+    }
 }
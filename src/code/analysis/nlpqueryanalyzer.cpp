@@ -498,6 +498,22 @@ QVariant NLPQueryAnalyzer::processDiskQuery(const QString &query, const QDateTim
         result["disks"] = diskList;
     }
     
+    // 如果查询包含进程相关关键词，添加磁盘读写最多的进程
+    if (query.contains("进程") || query.contains("process") || 
+        query.contains("应用") || query.contains("程序")) {
+        QList<QPair<QString, double>> highIoProcesses = m_performanceAnalyzer->getHighIoProcesses();
+        QVariantList processList;
+        
+        for (const auto &process : highIoProcesses) {
+            QVariantMap processInfo;
+            processInfo["name"] = process.first;
+            processInfo["usage"] = process.second;
+            processList.append(processInfo);
+        }
+        
+        result["processes"] = processList;
+    }
+    
     return result;
 }
 
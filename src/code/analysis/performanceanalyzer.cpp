@@ -29,14 +29,23 @@ PerformanceAnalyzer::PerformanceAnalyzer(QObject *parent)
     , m_memoryBottleneckThreshold(90.0) // 内存使用率超过90%视为瓶颈
     , m_diskBottleneckThreshold(80.0) // 磁盘I/O使用率超过80%视为瓶颈
     , m_networkBottleneckThreshold(70.0) // 网络使用率超过70%视为瓶颈
+    , m_processMonitor(nullptr)
 {
+    m_pressureThresholds[PressureCpu] = 20.0;    // 10 秒内有 20% 的时间存在等待 CPU 的任务
+    m_pressureThresholds[PressureMemory] = 10.0; // 内存回收、换页造成的停顿比 CPU 排队代价高得多
+    m_pressureThresholds[PressureIo] = 20.0;
 }
 
 PerformanceAnalyzer::~PerformanceAnalyzer()
 {
 }
 
-void PerformanceAnalyzer::addDataPoint(double cpuUsage, double memoryUsage, double diskIO, double networkUsage, const QDateTime& timestamp)
+void PerformanceAnalyzer::setProcessMonitor(ProcessMonitor *monitor)
+{
+    m_processMonitor = monitor;
+}
+
+void PerformanceAnalyzer::addDataPoint(double cpuUsage, double memoryUsage, double diskIO, double networkUsage, MonotonicNs timestamp)
 {
     m_cpuHistory.append(qMakePair(timestamp, cpuUsage));
     m_memoryHistory.append(qMakePair(timestamp, memoryUsage));
@@ -85,29 +94,46 @@ PerformanceAnalyzer::BottleneckType PerformanceAnalyzer::analyzeBottleneck()
     double diskIO = m_diskHistory.last().second;
     double networkUsage = m_networkHistory.last().second;
     
+    // 有 PSI 时 CPU、内存和磁盘以停顿时间为准，没有时退回使用率阈值；网络没有对应的 PSI。
+    // 三个 PSI 文件分别读取，可能只有部分有效，每种资源只看自己的读数
+    const bool cpuPressure = m_pressure[PressureCpu].valid;
+    const bool memoryPressure = m_pressure[PressureMemory].valid;
+    const bool ioPressure = m_pressure[PressureIo].valid;
+    const bool cpuBottleneck = cpuPressure ? isPressureBottleneck(PressureCpu) : cpuUsage >= m_cpuBottleneckThreshold;
+    const bool memoryBottleneck = memoryPressure ? isPressureBottleneck(PressureMemory) : memoryUsage >= m_memoryBottleneckThreshold;
+    const bool diskBottleneck = ioPressure ? isPressureBottleneck(PressureIo) : diskIO >= m_diskBottleneckThreshold;
+    
     // 检查是否有多个瓶颈
     int bottleneckCount = 0;
     QString details;
     
-    if (cpuUsage >= m_cpuBottleneckThreshold) {
+    if (cpuBottleneck) {
         bottleneckCount++;
+        if (cpuPressure) details += pressureDetails("CPU", PressureCpu);
         details += QString("CPU使用率: %1% (阈值: %2%)\n")
                     .arg(cpuUsage, 0, 'f', 2)
                     .arg(m_cpuBottleneckThreshold, 0, 'f', 2);
     }
     
-    if (memoryUsage >= m_memoryBottleneckThreshold) {
+    if (memoryBottleneck) {
         bottleneckCount++;
+        if (memoryPressure) details += pressureDetails("内存", PressureMemory);
         details += QString("内存使用率: %1% (阈值: %2%)\n")
                     .arg(memoryUsage, 0, 'f', 2)
                     .arg(m_memoryBottleneckThreshold, 0, 'f', 2);
     }
     
-    if (diskIO >= m_diskBottleneckThreshold) {
+    if (diskBottleneck) {
         bottleneckCount++;
+        if (ioPressure) details += pressureDetails("I/O", PressureIo);
         details += QString("磁盘I/O使用率: %1 MB/s (阈值: %2 MB/s)\n")
                     .arg(diskIO, 0, 'f', 2)
                     .arg(m_diskBottleneckThreshold, 0, 'f', 2);
+        // 附上读写最多的进程
+        const QList<QPair<QString, double>> ioProcesses = getHighIoProcesses();
+        for (int i = 0; i < qMin(3, ioProcesses.size()); ++i) {
+            details += QString("  %1: %2 MB/s\n").arg(ioProcesses[i].first).arg(ioProcesses[i].second, 0, 'f', 2);
+        }
     }
     
     if (networkUsage >= m_networkBottleneckThreshold) {
@@ -115,6 +141,11 @@ PerformanceAnalyzer::BottleneckType PerformanceAnalyzer::analyzeBottleneck()
         details += QString("网络使用率: %1 MB/s (阈值: %2 MB/s)\n")
                     .arg(networkUsage, 0, 'f', 2)
                     .arg(m_networkBottleneckThreshold, 0, 'f', 2);
+        // 附上收发最多的进程
+        const QList<QPair<QString, double>> netProcesses = getHighNetworkProcesses();
+        for (int i = 0; i < qMin(3, netProcesses.size()); ++i) {
+            details += QString("  %1: %2 MB/s\n").arg(netProcesses[i].first).arg(netProcesses[i].second, 0, 'f', 2);
+        }
     }
     
     // 确定瓶颈类型
@@ -123,13 +154,13 @@ PerformanceAnalyzer::BottleneckType PerformanceAnalyzer::analyzeBottleneck()
     if (bottleneckCount > 1) {
         result = Multiple;
         m_bottleneckDetails = "检测到多个性能瓶颈:\n" + details;
-    } else if (cpuUsage >= m_cpuBottleneckThreshold) {
+    } else if (cpuBottleneck) {
         result = CPU;
         m_bottleneckDetails = "检测到CPU瓶颈:\n" + details;
-    } else if (memoryUsage >= m_memoryBottleneckThreshold) {
+    } else if (memoryBottleneck) {
         result = Memory;
         m_bottleneckDetails = "检测到内存瓶颈:\n" + details;
-    } else if (diskIO >= m_diskBottleneckThreshold) {
+    } else if (diskBottleneck) {
         result = Disk;
         m_bottleneckDetails = "检测到磁盘I/O瓶颈:\n" + details;
     } else if (networkUsage >= m_networkBottleneckThreshold) {
@@ -140,6 +171,26 @@ PerformanceAnalyzer::BottleneckType PerformanceAnalyzer::analyzeBottleneck()
     return result;
 }
 
+bool PerformanceAnalyzer::isPressureBottleneck(PressureResource resource) const
+{
+    // full 表示所有任务同时停顿，意味着整机都在空等，阈值减半
+    const PressureStats &stats = m_pressure[resource];
+    const double threshold = m_pressureThresholds[resource];
+    return stats.valid && (stats.someAvg10 >= threshold || stats.fullAvg10 >= threshold / 2.0);
+}
+
+QString PerformanceAnalyzer::pressureDetails(const QString &name, PressureResource resource) const
+{
+    const PressureStats &stats = m_pressure[resource];
+    return QString("%1压力 (PSI): some %2% / %3%, full %4% / %5% (10秒/60秒平均, 阈值: %6%)\n")
+            .arg(name)
+            .arg(stats.someAvg10, 0, 'f', 2)
+            .arg(stats.someAvg60, 0, 'f', 2)
+            .arg(stats.fullAvg10, 0, 'f', 2)
+            .arg(stats.fullAvg60, 0, 'f', 2)
+            .arg(m_pressureThresholds[resource], 0, 'f', 2);
+}
+
 QString PerformanceAnalyzer::getBottleneckDetails() const
 {
     if (m_bottleneckDetails.isEmpty()) {
@@ -159,7 +210,7 @@ PerformanceAnalyzer::TrendType PerformanceAnalyzer::analyzeCpuTrend(int timeWind
     
     // 提取最近的值用于计算变异系数
     QVector<double> recentValues;
-    QDateTime cutoffTime = QDateTime::currentDateTime().addSecs(-timeWindowMinutes * 60);
+    MonotonicNs cutoffTime = MonotonicClock::now() - MonotonicClock::fromSecs(timeWindowMinutes * 60LL);
     for (const auto& pair : m_cpuHistory) {
         if (pair.first >= cutoffTime) {
             recentValues.append(pair.second);
@@ -199,7 +250,7 @@ PerformanceAnalyzer::TrendType PerformanceAnalyzer::analyzeMemoryTrend(int timeW
     
     // 提取最近的值用于计算变异系数
     QVector<double> recentValues;
-    QDateTime cutoffTime = QDateTime::currentDateTime().addSecs(-timeWindowMinutes * 60);
+    MonotonicNs cutoffTime = MonotonicClock::now() - MonotonicClock::fromSecs(timeWindowMinutes * 60LL);
     for (const auto& pair : m_memoryHistory) {
         if (pair.first >= cutoffTime) {
             recentValues.append(pair.second);
@@ -239,7 +290,7 @@ PerformanceAnalyzer::TrendType PerformanceAnalyzer::analyzeDiskTrend(int timeWin
     
     // 提取最近的值用于计算变异系数
     QVector<double> recentValues;
-    QDateTime cutoffTime = QDateTime::currentDateTime().addSecs(-timeWindowMinutes * 60);
+    MonotonicNs cutoffTime = MonotonicClock::now() - MonotonicClock::fromSecs(timeWindowMinutes * 60LL);
     for (const auto& pair : m_diskHistory) {
         if (pair.first >= cutoffTime) {
             recentValues.append(pair.second);
@@ -279,7 +330,7 @@ PerformanceAnalyzer::TrendType PerformanceAnalyzer::analyzeNetworkTrend(int time
     
     // 提取最近的值用于计算变异系数
     QVector<double> recentValues;
-    QDateTime cutoffTime = QDateTime::currentDateTime().addSecs(-timeWindowMinutes * 60);
+    MonotonicNs cutoffTime = MonotonicClock::now() - MonotonicClock::fromSecs(timeWindowMinutes * 60LL);
     for (const auto& pair : m_networkHistory) {
         if (pair.first >= cutoffTime) {
             recentValues.append(pair.second);
@@ -615,17 +666,17 @@ void PerformanceAnalyzer::setBottleneckThresholds(double cpuThreshold, double me
     }
 }
 
-double PerformanceAnalyzer::calculateSlope(const QVector<QPair<QDateTime, double>>& data, int timeWindowMinutes)
+double PerformanceAnalyzer::calculateSlope(const QVector<QPair<MonotonicNs, double>>& data, int timeWindowMinutes)
 {
     if (data.size() < 2) {
         return 0.0;
     }
     
     // 只考虑时间窗口内的数据点
-    QDateTime cutoffTime = QDateTime::currentDateTime().addSecs(-timeWindowMinutes * 60);
+    MonotonicNs cutoffTime = MonotonicClock::now() - MonotonicClock::fromSecs(timeWindowMinutes * 60LL);
     
     QVector<QPair<double, double>> points; // <x, y> 其中x是时间（秒），y是值
-    QDateTime firstTime; // 用于计算相对时间
+    MonotonicNs firstTime = 0; // 用于计算相对时间
     
     bool isFirst = true;
     for (const auto& pair : data) {
@@ -636,7 +687,7 @@ double PerformanceAnalyzer::calculateSlope(const QVector<QPair<QDateTime, double
             }
             
             // 将时间转换为相对于第一个点的秒数
-            double x = firstTime.secsTo(pair.first);
+            double x = MonotonicClock::toSecs(pair.first - firstTime);
             double y = pair.second;
             
             points.append(qMakePair(x, y));
@@ -695,7 +746,7 @@ double PerformanceAnalyzer::calculateCoefficientOfVariation(const QVector<double
 
 void PerformanceAnalyzer::cleanupOldData()
 {
-    QDateTime cutoffTime = QDateTime::currentDateTime().addSecs(-m_retentionHours * 3600);
+    MonotonicNs cutoffTime = MonotonicClock::now() - MonotonicClock::fromSecs(m_retentionHours * 3600LL);
     
     // 清理CPU历史数据
     while (!m_cpuHistory.isEmpty() && m_cpuHistory.first().first < cutoffTime) {
@@ -865,13 +916,13 @@ QMap<QString, QVariant> PerformanceAnalyzer::analyzePerformanceHistory(int days)
     QMap<QString, QVariant> result;
     
     // 设置时间窗口
-    QDateTime cutoffTime = QDateTime::currentDateTime().addDays(-days);
+    MonotonicNs cutoffTime = MonotonicClock::now() - MonotonicClock::fromSecs(days * 86400LL);
     
     // 提取时间窗口内的数据
-    QVector<QPair<QDateTime, double>> filteredCpuHistory;
-    QVector<QPair<QDateTime, double>> filteredMemoryHistory;
-    QVector<QPair<QDateTime, double>> filteredDiskHistory;
-    QVector<QPair<QDateTime, double>> filteredNetworkHistory;
+    QVector<QPair<MonotonicNs, double>> filteredCpuHistory;
+    QVector<QPair<MonotonicNs, double>> filteredMemoryHistory;
+    QVector<QPair<MonotonicNs, double>> filteredDiskHistory;
+    QVector<QPair<MonotonicNs, double>> filteredNetworkHistory;
     
     for (const auto& pair : m_cpuHistory) {
         if (pair.first >= cutoffTime) {
@@ -993,7 +1044,7 @@ QMap<QString, QVariant> PerformanceAnalyzer::predictPerformanceTrend(int hours)
     QMap<QString, QVariant> result;
     
     // 获取当前时间作为参考点
-    QDateTime now = QDateTime::currentDateTime();
+    MonotonicNs now = MonotonicClock::now();
     
     // 将历史数据转换为数据点
     QVector<QPair<double, double>> cpuPoints;
@@ -1004,28 +1055,28 @@ QMap<QString, QVariant> PerformanceAnalyzer::predictPerformanceTrend(int hours)
     int i = 0;
     for (const auto& pair : m_cpuHistory) {
         // 将时间转换为小时数（相对于当前时间）
-        double hoursDiff = pair.first.secsTo(now) / 3600.0;
+        double hoursDiff = MonotonicClock::toSecs(now - pair.first) / 3600.0;
         cpuPoints.append(qMakePair(-hoursDiff, pair.second));
         i++;
     }
     
     i = 0;
     for (const auto& pair : m_memoryHistory) {
-        double hoursDiff = pair.first.secsTo(now) / 3600.0;
+        double hoursDiff = MonotonicClock::toSecs(now - pair.first) / 3600.0;
         memPoints.append(qMakePair(-hoursDiff, pair.second));
         i++;
     }
     
     i = 0;
     for (const auto& pair : m_diskHistory) {
-        double hoursDiff = pair.first.secsTo(now) / 3600.0;
+        double hoursDiff = MonotonicClock::toSecs(now - pair.first) / 3600.0;
         diskPoints.append(qMakePair(-hoursDiff, pair.second));
         i++;
     }
     
     i = 0;
     for (const auto& pair : m_networkHistory) {
-        double hoursDiff = pair.first.secsTo(now) / 3600.0;
+        double hoursDiff = MonotonicClock::toSecs(now - pair.first) / 3600.0;
         netPoints.append(qMakePair(-hoursDiff, pair.second));
         i++;
     }
@@ -1190,24 +1241,14 @@ QList<QPair<QString, double>> PerformanceAnalyzer::getHighCpuProcesses() const
     for (int i = 0; i < qMin(10, cpuUsages.size()); ++i) {
         result.append(cpuUsages[i]);
     }
-#else
-    // Linux实现
-    QProcess process;
-    process.start("ps", QStringList() << "-eo" << "pid,pcpu,comm" << "--sort=-pcpu" << "--no-headers");
-    if (process.waitForFinished()) {
-        QString output = process.readAllStandardOutput();
-        QTextStream stream(&output);
-        int count = 0;
-        while (!stream.atEnd() && count < 10) {
-            QString line = stream.readLine().trimmed();
-            QStringList parts = line.split(QRegExp("\\s+"), QString::SkipEmptyParts);
-            if (parts.size() >= 3) {
-                QString processName = parts[2];
-                double cpuUsage = parts[1].toDouble();
-                result.append(qMakePair(processName, cpuUsage));
-                count++;
-            }
-        }
+#elif defined(Q_OS_LINUX)
+    // Linux实现：进程表由采样器每个周期刷新，这里不再额外刷新；首次刷新之前没有 CPU 基线，返回空列表
+    if (!m_processMonitor || !m_processMonitor->hasCpuBaseline()) {
+        return result;
+    }
+    const QList<ProcessInfo> top = m_processMonitor->getTopProcesses(10, ProcessMonitor::RankByCpu);
+    for (const ProcessInfo &info : top) {
+        result.append(qMakePair(info.name, info.cpuPercent));
     }
 #endif
     
@@ -1365,64 +1406,53 @@ QList<QPair<QString, double>> PerformanceAnalyzer::getHighMemoryProcesses() cons
 {
     QList<QPair<QString, double>> result;
     
-#ifdef Q_OS_WIN
-    HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
-    if (hSnapshot == INVALID_HANDLE_VALUE) {
+    if (!m_processMonitor) {
         return result;
     }
     
-    PROCESSENTRY32 pe32;
-    pe32.dwSize = sizeof(PROCESSENTRY32);
-    
-    if (!Process32First(hSnapshot, &pe32)) {
-        CloseHandle(hSnapshot);
-        return result;
+    // 返回内存占用（MB）最高的前10个，扫描时只保留前 10 名
+    const QList<ProcessInfo> top = m_processMonitor->getTopProcesses(10, ProcessMonitor::RankByMemory);
+    for (const ProcessInfo &info : top) {
+        result.append(qMakePair(info.name, info.memoryMB));
     }
     
-    QList<QPair<QString, double>> memUsages;
-    do {
-        HANDLE hProcess = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE, pe32.th32ProcessID);
-        if (hProcess) {
-            PROCESS_MEMORY_COUNTERS pmc;
-            if (GetProcessMemoryInfo(hProcess, &pmc, sizeof(pmc))) {
-                // 获取内存使用量（MB）
-                double memUsage = static_cast<double>(pmc.WorkingSetSize) / (1024 * 1024);
-                memUsages.append(qMakePair(QString::fromWCharArray(pe32.szExeFile), memUsage));
-            }
-            CloseHandle(hProcess);
-        }
-    } while (Process32Next(hSnapshot, &pe32));
+    return result;
+}
+
+QList<QPair<QString, double>> PerformanceAnalyzer::getHighIoProcesses() const
+{
+    QList<QPair<QString, double>> result;
     
-    CloseHandle(hSnapshot);
+#ifdef Q_OS_LINUX
+    // 读写速率来自 /proc/[pid]/io 的 read_bytes / write_bytes，首次刷新没有基线，全部为 0
+    if (!m_processMonitor) {
+        return result;
+    }
+    const QList<ProcessInfo> top = m_processMonitor->getTopProcesses(10, ProcessMonitor::RankByIo);
+    for (const ProcessInfo &info : top) {
+        const double mbPerSec = (info.diskReadBytesPerSec + info.diskWriteBytesPerSec) / (1024.0 * 1024.0);
+        if (mbPerSec <= 0.0) break;
+        result.append(qMakePair(info.name, mbPerSec));
+    }
+#endif
     
-    // 按内存使用率排序
-    std::sort(memUsages.begin(), memUsages.end(), 
-             [](const QPair<QString, double>& a, const QPair<QString, double>& b) {
-                 return a.second > b.second;
-             });
+    return result;
+}
+
+QList<QPair<QString, double>> PerformanceAnalyzer::getHighNetworkProcesses() const
+{
+    QList<QPair<QString, double>> result;
     
-    // 返回最高的前10个
-    for (int i = 0; i < qMin(10, memUsages.size()); ++i) {
-        result.append(memUsages[i]);
+#ifdef Q_OS_LINUX
+    // 收发速率来自 sock_diag 的 tcp_info 字节计数，首次刷新没有基线，全部为 0
+    if (!m_processMonitor) {
+        return result;
     }
-#else
-    // Linux实现
-    QProcess process;
-    process.start("ps", QStringList() << "-eo" << "pid,pmem,comm" << "--sort=-pmem" << "--no-headers");
-    if (process.waitForFinished()) {
-        QString output = process.readAllStandardOutput();
-        QTextStream stream(&output);
-        int count = 0;
-        while (!stream.atEnd() && count < 10) {
-            QString line = stream.readLine().trimmed();
-            QStringList parts = line.split(QRegExp("\\s+"), QString::SkipEmptyParts);
-            if (parts.size() >= 3) {
-                QString processName = parts[2];
-                double memUsage = parts[1].toDouble();
-                result.append(qMakePair(processName, memUsage));
-                count++;
-            }
-        }
+    const QList<ProcessInfo> top = m_processMonitor->getTopProcesses(10, ProcessMonitor::RankByNetwork);
+    for (const ProcessInfo &info : top) {
+        const double mbPerSec = (info.netRxBytesPerSec + info.netTxBytesPerSec) / (1024.0 * 1024.0);
+        if (mbPerSec <= 0.0) break;
+        result.append(qMakePair(info.name, mbPerSec));
     }
 #endif
     
@@ -1469,12 +1499,33 @@ bool PerformanceAnalyzer::terminateProcess(const QString &processName) const
 #endif
 }
 
+void PerformanceAnalyzer::setPressureThresholds(double cpuThreshold, double memoryThreshold, double ioThreshold)
+{
+    const double thresholds[PressureResourceCount] = { cpuThreshold, memoryThreshold, ioThreshold };
+    for (int i = 0; i < PressureResourceCount; ++i) {
+        if (thresholds[i] > 0.0 && thresholds[i] <= 100.0) {
+            m_pressureThresholds[i] = thresholds[i];
+        }
+    }
+}
+
 void PerformanceAnalyzer::resetToDefaultThresholds()
 {
     m_cpuBottleneckThreshold = 85.0;
     m_memoryBottleneckThreshold = 90.0;
     m_diskBottleneckThreshold = 80.0;
     m_networkBottleneckThreshold = 70.0;
+    m_pressureThresholds[PressureCpu] = 20.0;
+    m_pressureThresholds[PressureMemory] = 10.0;
+    m_pressureThresholds[PressureIo] = 20.0;
+}
+
+void PerformanceAnalyzer::updatePressure(const PressureStats &cpu, const PressureStats &memory, const PressureStats &io)
+{
+    // 只保存数据，瓶颈在随后的使用率更新中一起判断
+    m_pressure[PressureCpu] = cpu;
+    m_pressure[PressureMemory] = memory;
+    m_pressure[PressureIo] = io;
 }
 
 void PerformanceAnalyzer::updateCpuUsage(double usage) {
@@ -1484,7 +1535,7 @@ void PerformanceAnalyzer::updateCpuUsage(double usage) {
     m_cpuUsage = normalizedUsage;
     
     // 使用当前时间戳添加数据点
-    QDateTime now = QDateTime::currentDateTime();
+    MonotonicNs now = MonotonicClock::now();
     m_cpuHistory.append(qMakePair(now, normalizedUsage));
     
     // 保持历史数据合理长度
@@ -1515,7 +1566,7 @@ void PerformanceAnalyzer::updateMemoryUsage(double usage) {
     m_memoryUsage = normalizedUsage;
     
     // 使用当前时间戳添加数据点
-    QDateTime now = QDateTime::currentDateTime();
+    MonotonicNs now = MonotonicClock::now();
     m_memoryHistory.append(qMakePair(now, normalizedUsage));
     
     // 保持历史数据合理长度
@@ -1544,7 +1595,7 @@ void PerformanceAnalyzer::updateDiskUsage(double usage) {
     m_diskIO = usage;
     
     // 使用当前时间戳添加数据点
-    QDateTime now = QDateTime::currentDateTime();
+    MonotonicNs now = MonotonicClock::now();
     m_diskHistory.append(qMakePair(now, usage));
     
     // 保持历史数据合理长度
@@ -1573,7 +1624,7 @@ void PerformanceAnalyzer::updateNetworkUsage(double usage) {
     m_networkUsage = usage;
     
     // 使用当前时间戳添加数据点
-    QDateTime now = QDateTime::currentDateTime();
+    MonotonicNs now = MonotonicClock::now();
     m_networkHistory.append(qMakePair(now, usage));
     
     // 保持历史数据合理长度
@@ -8,7 +8,7 @@
 #include <QJsonObject>
 
 VirtualizationMonitor::VirtualizationMonitor(QObject *parent)
-    : QObject(parent), m_detectedType(None) {
+    : QObject(parent), m_detectedType(None), m_cgroupAvailable(m_cgroupMonitor.isAvailable()) {
     // 在构造时执行一次检测并缓存结果
     detectVirtualizationType();
 }
@@ -369,6 +369,23 @@ QMap<QString, QVariant> VirtualizationMonitor::getContainerResources(const QStri
     return QMap<QString, QVariant>();
 }
 
+QMap<QString, QMap<QString, QVariant>> VirtualizationMonitor::getAllContainerResources(ResourceType type) const {
+    QMap<QString, QMap<QString, QVariant>> result;
+    if (m_cgroupAvailable) {
+        m_cgroupMonitor.refresh();
+        for (const ContainerStats &stats : m_cgroupMonitor.containers()) {
+            result[stats.id] = filterContainerResources(containerStatsToResources(stats), type);
+        }
+        return result;
+    }
+
+    // cgroup v1、macOS 和 Windows 上只能逐个调用 docker stats
+    for (const QString &containerId : getContainerList()) {
+        result[containerId] = getContainerResources(containerId, type);
+    }
+    return result;
+}
+
 // 获取虚拟机/容器的性能历史数据 (占位)
 QList<QPair<QString, QVariant>> VirtualizationMonitor::getVirtualMachineHistory(const QString &vmName, ResourceType type, int hours) const {
     Q_UNUSED(vmName);
@@ -416,6 +433,14 @@ QString VirtualizationMonitor::getVirtualizationOptimizationSuggestions() const
 
 QStringList VirtualizationMonitor::getDockerContainers() const {
     QStringList containerIds;
+    if (m_cgroupAvailable) {
+        // cgroup v2 下容器 ID 直接来自 cgroup 目录名
+        refreshContainerStatsIfStale();
+        for (const ContainerStats &stats : m_cgroupMonitor.containers()) {
+            if (stats.runtime == QStringLiteral("docker")) containerIds.append(stats.id);
+        }
+        return containerIds;
+    }
 #if defined(Q_OS_LINUX) || defined(Q_OS_MACOS) // Docker CLI在Linux和macOS上行为相似
     // 使用 docker ps 命令获取正在运行的容器ID
     // docker ps -q --no-trunc
@@ -437,6 +462,15 @@ QStringList VirtualizationMonitor::getDockerContainers() const {
 }
 
 QMap<QString, QVariant> VirtualizationMonitor::getDockerContainerResources(const QString &containerNameOrId, ResourceType requestedType) const {
+    // cgroup v2 下按容器 ID 直接读取 cgroup，不再为每个容器阻塞约 2 秒执行一次 docker stats；
+    // 只有按容器名称查询时（cgroup 中没有名称）才退回 docker CLI
+    if (m_cgroupAvailable) {
+        refreshContainerStatsIfStale();
+        if (const ContainerStats *stats = m_cgroupMonitor.find(containerNameOrId, QStringLiteral("docker"))) {
+            return filterContainerResources(containerStatsToResources(*stats), requestedType);
+        }
+    }
+
     QMap<QString, QVariant> allResources;
 #if defined(Q_OS_LINUX) || defined(Q_OS_MACOS) || defined(Q_OS_WIN)
     // 使用 docker stats 命令获取容器资源使用情况
@@ -505,6 +539,47 @@ QMap<QString, QVariant> VirtualizationMonitor::getDockerContainerResources(const
     }
 #endif
 
+    return filterContainerResources(allResources, requestedType);
+}
+
+void VirtualizationMonitor::refreshContainerStatsIfStale() const {
+    if (MonotonicClock::now() - m_cgroupMonitor.lastRefresh() > MonotonicClock::fromMSecs(500)) {
+        m_cgroupMonitor.refresh();
+    }
+}
+
+QMap<QString, QVariant> VirtualizationMonitor::containerStatsToResources(const ContainerStats &stats) const {
+    QMap<QString, QVariant> resources;
+    // cgroup 中没有容器名称，使用 docker ps 显示的 12 位短 ID
+    resources["Name"] = stats.id.left(12);
+    resources["ContainerId"] = stats.id;
+    resources["Runtime"] = stats.runtime;
+    resources["CgroupPath"] = stats.cgroupPath;
+    resources["PIDs"] = static_cast<qulonglong>(stats.pids);
+
+    resources["CPUUsagePercentage"] = stats.cpuPercent;
+    resources["CPUThrottledPercentage"] = stats.cpuThrottledPercent;
+    if (stats.cpuLimitCores > 0.0) resources["CPULimitCores"] = stats.cpuLimitCores;
+
+    // 与 docker stats 一致，内存用量不计入可以随时回收的 inactive_file
+    resources["MemUsedBytes"] = static_cast<qint64>(stats.memoryWorkingSet);
+    resources["MemCurrentBytes"] = static_cast<qint64>(stats.memoryCurrent);
+    resources["MemAnonBytes"] = static_cast<qint64>(stats.memoryAnon);
+    resources["MemFileBytes"] = static_cast<qint64>(stats.memoryFile);
+    if (stats.memoryLimit > 0) {
+        resources["MemLimitBytes"] = static_cast<qint64>(stats.memoryLimit);
+        resources["MemoryUsagePercentage"] = stats.memoryWorkingSet * 100.0 / stats.memoryLimit;
+    }
+
+    resources["BlockInputBytes"] = static_cast<qint64>(stats.ioReadBytes);
+    resources["BlockOutputBytes"] = static_cast<qint64>(stats.ioWriteBytes);
+    resources["BlockInputBytesPerSec"] = stats.ioReadBytesPerSec;
+    resources["BlockOutputBytesPerSec"] = stats.ioWriteBytesPerSec;
+    // 网络计数在容器的网络命名空间里，cgroup 中没有，这里不提供 NetInputBytes / NetOutputBytes
+    return resources;
+}
+
+QMap<QString, QVariant> VirtualizationMonitor::filterContainerResources(const QMap<QString, QVariant> &allResources, ResourceType requestedType) const {
     if (requestedType == All) {
         return allResources;
     }
@@ -515,12 +590,17 @@ QMap<QString, QVariant> VirtualizationMonitor::getDockerContainerResources(const
     if (requestedType == CPU) {
         if (allResources.contains("CPUUsagePercentage")) filteredResources["CPUUsagePercentage"] = allResources["CPUUsagePercentage"];
         if (allResources.contains("CPUPercRaw")) filteredResources["CPUPercRaw"] = allResources["CPUPercRaw"];
+        if (allResources.contains("CPUThrottledPercentage")) filteredResources["CPUThrottledPercentage"] = allResources["CPUThrottledPercentage"];
+        if (allResources.contains("CPULimitCores")) filteredResources["CPULimitCores"] = allResources["CPULimitCores"];
     } else if (requestedType == Memory) {
         if (allResources.contains("MemUsedBytes")) filteredResources["MemUsedBytes"] = allResources["MemUsedBytes"];
         if (allResources.contains("MemLimitBytes")) filteredResources["MemLimitBytes"] = allResources["MemLimitBytes"];
         if (allResources.contains("MemoryUsagePercentage")) filteredResources["MemoryUsagePercentage"] = allResources["MemoryUsagePercentage"];
         if (allResources.contains("MemUsageRaw")) filteredResources["MemUsageRaw"] = allResources["MemUsageRaw"];
         if (allResources.contains("MemPercRaw")) filteredResources["MemPercRaw"] = allResources["MemPercRaw"];
+        if (allResources.contains("MemCurrentBytes")) filteredResources["MemCurrentBytes"] = allResources["MemCurrentBytes"];
+        if (allResources.contains("MemAnonBytes")) filteredResources["MemAnonBytes"] = allResources["MemAnonBytes"];
+        if (allResources.contains("MemFileBytes")) filteredResources["MemFileBytes"] = allResources["MemFileBytes"];
     } else if (requestedType == Network) {
         if (allResources.contains("NetInputBytes")) filteredResources["NetInputBytes"] = allResources["NetInputBytes"];
         if (allResources.contains("NetOutputBytes")) filteredResources["NetOutputBytes"] = allResources["NetOutputBytes"];
@@ -529,6 +609,8 @@ QMap<QString, QVariant> VirtualizationMonitor::getDockerContainerResources(const
         if (allResources.contains("BlockInputBytes")) filteredResources["BlockInputBytes"] = allResources["BlockInputBytes"];
         if (allResources.contains("BlockOutputBytes")) filteredResources["BlockOutputBytes"] = allResources["BlockOutputBytes"];
         if (allResources.contains("BlockIORaw")) filteredResources["BlockIORaw"] = allResources["BlockIORaw"];
+        if (allResources.contains("BlockInputBytesPerSec")) filteredResources["BlockInputBytesPerSec"] = allResources["BlockInputBytesPerSec"];
+        if (allResources.contains("BlockOutputBytesPerSec")) filteredResources["BlockOutputBytesPerSec"] = allResources["BlockOutputBytesPerSec"];
     }
     // Always include PIDs if available
     if (allResources.contains("PIDs")) filteredResources["PIDs"] = allResources["PIDs"]; 
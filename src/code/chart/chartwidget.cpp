@@ -129,6 +129,66 @@ void ChartWidget::updateValue(qreal value)
     }
 }
 
+void ChartWidget::setSeriesCount(int count, const QString &namePrefix)
+{
+    QStringList names;
+    for (int i = 0; i < count; ++i) {
+        names.append(QString("%1%2").arg(namePrefix).arg(i));
+    }
+    setSeriesNames(names);
+    m_multiPrefix = namePrefix;
+}
+
+void ChartWidget::setSeriesNames(const QStringList &names)
+{
+    for (QLineSeries *series : m_multiSeries) {
+        m_chart->removeSeries(series);
+        delete series;
+    }
+    m_multiSeries.clear();
+    m_multiData.clear();
+    m_multiPrefix.clear();
+
+    const int count = names.size();
+    m_series->setVisible(count <= 0);
+    for (int i = 0; i < count; ++i) {
+        QLineSeries *series = new QLineSeries(this);
+        series->setName(names[i]);
+        m_chart->addSeries(series);
+        series->attachAxis(m_axisX);
+        series->attachAxis(m_axisY);
+        m_multiSeries.append(series);
+    }
+    m_multiData.resize(count);
+
+    // 曲线太多时图例会挤占绘图区，只在少量曲线时显示
+    m_chart->legend()->setVisible(count > 1 && count <= 16);
+}
+
+void ChartWidget::updateValues(const QVector<qreal> &values)
+{
+    if (values.size() != m_multiSeries.size()) {
+        setSeriesCount(values.size(), m_multiPrefix);
+    }
+
+    // 每条曲线整体替换一次，避免逐点 replace 触发大量重绘
+    QList<QPointF> points;
+    for (int s = 0; s < values.size(); ++s) {
+        QVector<qreal> &data = m_multiData[s];
+        if (data.size() >= m_maxPoints) {
+            data.removeFirst();
+        }
+        data.append(values[s]);
+
+        points.clear();
+        points.reserve(data.size());
+        for (int i = 0; i < data.size(); ++i) {
+            points.append(QPointF(i, data[i]));
+        }
+        m_multiSeries[s]->replace(points);
+    }
+}
+
 void ChartWidget::resetZoom()
 {
     m_minY = 0;
@@ -75,6 +75,8 @@ MainWindow::MainWindow(QWidget *parent)
     m_sampler->setStorage(m_storage);
     m_sampler->setChartWidgets(m_cpuChart, m_memoryChart, m_gpuChart, m_wifiChart);
     m_sampler->startSampling();
+    // 资源出现明显停顿时立即采集一次，不等下一个周期
+    m_sampler->enablePressureTriggers();
 }
 
 MainWindow::~MainWindow()
@@ -376,11 +378,18 @@ void MainWindow::setupConnections()
 
     // Connect sampler signals to page updates
     connect(m_sampler, &Sampler::cpuUsageUpdated, m_cpuPage, &CpuPage::updateCpuData);
+    connect(m_sampler, &Sampler::cpuCoreStatsUpdated, m_cpuPage, &CpuPage::updateCoreData);
+    connect(m_sampler, &Sampler::cpuSensorStatsUpdated, m_cpuPage, &CpuPage::updateSensorData);
     connect(m_sampler, &Sampler::gpuStatsUpdated, m_gpuPage, &GpuPage::updateGpuData);
+    connect(m_sampler, &Sampler::gpuTelemetryUpdated, m_gpuPage, &GpuPage::updateGpuTelemetry);
     connect(m_sampler, &Sampler::gpuAvailabilityChanged, m_gpuPage, &GpuPage::handleGpuAvailabilityChange);
     connect(m_sampler, &Sampler::memoryStatsUpdated, m_memoryPage, &MemoryPage::updateLabels);
+    connect(m_sampler, &Sampler::vmstatUpdated, m_memoryPage, &MemoryPage::updateVmstat);
     connect(m_sampler, &Sampler::diskStatsUpdated, m_diskPage, &DiskPage::updateDiskData);
+    connect(m_sampler, &Sampler::diskDeviceStatsUpdated, m_diskPage, &DiskPage::updateDeviceData);
     connect(m_sampler, &Sampler::networkStatsUpdated, m_networkPage, &NetworkPage::updateNetworkData);
+    connect(m_sampler, &Sampler::networkInterfaceStatsUpdated, m_networkPage, &NetworkPage::updateInterfaceData);
+    connect(m_sampler, &Sampler::processNetworkStatsUpdated, m_networkPage, &NetworkPage::updateProcessData);
     connect(m_sampler, &Sampler::performanceDataUpdated, m_processPage, &ProcessPage::updateProcessList);
     
     // 确保概览页图表和单独页面图表同步
@@ -419,7 +428,15 @@ void MainWindow::setupConnections()
     }
     #endif
     
+    // 进程表只有采样器中的一份，每个周期刷新一次，各页面和分析模块只读取
+#ifdef Q_OS_LINUX
+    m_processPage->setProcessMonitor(m_sampler->processMonitor());
+    m_memoryPage->setProcessMonitor(m_sampler->processMonitor());
+#endif
+    
     // 连接性能数据到PerformanceAnalyzer
+    m_analysisPage->getPerformanceAnalyzer()->setProcessMonitor(m_sampler->processMonitor());
+    connect(m_sampler, &Sampler::pressureStatsUpdated, m_analysisPage->getPerformanceAnalyzer(), &PerformanceAnalyzer::updatePressure);
     connect(m_sampler, &Sampler::cpuUsageUpdated, m_analysisPage->getPerformanceAnalyzer(), &PerformanceAnalyzer::updateCpuUsage);
     connect(m_sampler, &Sampler::memoryStatsUpdated, 
         [this](quint64 total, quint64 used, quint64 free) {
@@ -445,6 +462,9 @@ void MainWindow::setupConnections()
         m_analysisPage->updatePerformanceData(cpuUsage, memoryUsage, diskIO, networkUsage);
         m_analysisPage->updateAnomalyData(cpuUsage, memoryUsage, diskIO, networkUsage);
     });
+    connect(m_sampler, &Sampler::vmstatUpdated, m_analysisPage, [this](const VmstatRates &rates) {
+        m_analysisPage->updatePagingData(rates.majorFaults, rates.swapIns + rates.swapOuts, rates.directScanned, rates.oomKills);
+    });
 
     // Export connection using custom signal-slot
     connect(m_exportButton, &QPushButton::clicked, this, &MainWindow::exportData);
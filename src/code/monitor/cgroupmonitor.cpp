@@ -0,0 +1,270 @@
+// cgroupmonitor.cpp
+#include "src/include/monitor/cgroupmonitor.h"
+#include <algorithm>
+#ifdef Q_OS_LINUX
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+// 容器 ID 为 64 位十六进制
+static const size_t ContainerIdLength = 64;
+// docker ps 显示的短 ID 为 12 位，更短的前缀容易同时匹配多个容器
+static const int MinIdPrefixLength = 12;
+
+static bool isLowerHex(const char *text, size_t length)
+{
+    for (size_t i = 0; i < length; ++i) {
+        const char c = text[i];
+        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) return false;
+    }
+    return true;
+}
+
+static bool isContainerId(const char *text, size_t length)
+{
+    return length == ContainerIdLength && isLowerHex(text, length);
+}
+
+bool CgroupMonitor::parseContainerName(const char *name, size_t length, const char *parentName,
+                                       QString &runtime, QString &id)
+{
+    // systemd 驱动：<runtime>-<id>.scope，例如 docker-<id>.scope、cri-containerd-<id>.scope
+    static const char ScopeSuffix[] = ".scope";
+    const size_t suffixLength = sizeof(ScopeSuffix) - 1;
+    if (length > suffixLength + ContainerIdLength + 1
+        && memcmp(name + length - suffixLength, ScopeSuffix, suffixLength) == 0) {
+        const size_t idStart = length - suffixLength - ContainerIdLength;
+        if (name[idStart - 1] != '-' || !isContainerId(name + idStart, ContainerIdLength)) return false;
+        // libpod-conmon-<id>.scope、crio-conmon-<id>.scope 是容器监控进程，不是容器本身
+        const size_t runtimeLength = idStart - 1;
+        static const char ConmonSuffix[] = "-conmon";
+        const size_t conmonLength = sizeof(ConmonSuffix) - 1;
+        if (runtimeLength >= conmonLength && memcmp(name + runtimeLength - conmonLength, ConmonSuffix, conmonLength) == 0) {
+            return false;
+        }
+        runtime = QString::fromLatin1(name, static_cast<int>(runtimeLength));
+        id = QString::fromLatin1(name + idStart, static_cast<int>(ContainerIdLength));
+        return true;
+    }
+
+    // cgroupfs 驱动：目录名就是 ID，上一级目录是运行时（docker/<id>）或 Kubernetes 的 pod 目录
+    if (isContainerId(name, length)) {
+        runtime = strncmp(parentName, "pod", 3) == 0 ? QStringLiteral("kubepods") : QString::fromLatin1(parentName);
+        id = QString::fromLatin1(name, static_cast<int>(length));
+        return true;
+    }
+    return false;
+}
+
+const ContainerStats *CgroupMonitor::find(const QString &idOrPrefix, const QString &runtime) const
+{
+    // 只有 12 到 64 位小写十六进制才当作 ID，容器名称（例如 "db"、"cafe"）不能被当成前缀去匹配
+    if (idOrPrefix.size() < MinIdPrefixLength || idOrPrefix.size() > static_cast<int>(ContainerIdLength)) return nullptr;
+    const QByteArray prefix = idOrPrefix.toLatin1();
+    if (!isLowerHex(prefix.constData(), static_cast<size_t>(prefix.size()))) return nullptr;
+    for (const ContainerStats &stats : m_containers) {
+        if (!runtime.isEmpty() && stats.runtime != runtime) continue;
+        if (stats.id.startsWith(idOrPrefix)) return &stats;
+    }
+    return nullptr;
+}
+
+#ifdef Q_OS_LINUX
+// kubepods.slice/kubepods-burstable.slice/kubepods-burstable-pod<uid>.slice/cri-containerd-<id>.scope 深度为 4，
+// rootless podman 在 user.slice/user-<uid>.slice/user@<uid>.service/user.slice 之下，留出余量
+static const int MaxWalkDepth = 8;
+
+CgroupMonitor::CgroupMonitor(const char *root)
+    : m_file(nullptr, 4096)
+    , m_generation(0)
+    , m_lastRefresh(0)
+{
+    if (root) {
+        m_root = root;
+    } else if (access("/sys/fs/cgroup/cgroup.controllers", R_OK) == 0) {
+        m_root = "/sys/fs/cgroup";
+    } else {
+        m_root = "/sys/fs/cgroup/unified";
+    }
+}
+
+bool CgroupMonitor::isAvailable() const
+{
+    // 混合模式的 unified 层级通常没有挂载 memory 等控制器，容器的统计仍在 v1 层级里
+    ProcfsFile controllers;
+    const std::string path = m_root + "/cgroup.controllers";
+    if (!controllers.readOnce(path.c_str())) return false;
+    ProcfsTokenizer tok(controllers);
+    const char *word;
+    size_t length;
+    while (tok.nextWord(word, length)) {
+        if (ProcfsTokenizer::equals(word, length, "memory")) return true;
+    }
+    return false;
+}
+
+int CgroupMonitor::refresh()
+{
+    const MonotonicNs now = MonotonicClock::now();
+    m_containers.clear();
+
+    const int rootFd = ::open(m_root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (rootFd >= 0) {
+        walk(rootFd, std::string(), "", 0, now);
+    }
+
+    // 清除已经消失的容器的速率状态
+    for (QHash<QByteArray, RateState>::iterator it = m_rates.begin(); it != m_rates.end();) {
+        if (it->generation != m_generation) {
+            it = m_rates.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    ++m_generation;
+
+    std::sort(m_containers.begin(), m_containers.end(), [](const ContainerStats &a, const ContainerStats &b) {
+        return a.cpuPercent > b.cpuPercent;
+    });
+    m_lastRefresh = now;
+    return m_containers.size();
+}
+
+void CgroupMonitor::walk(int dirfd, const std::string &relativePath, const char *name, int depth, MonotonicNs now)
+{
+    // fdopendir 接管 dirfd，closedir 时一并关闭
+    DIR *dir = fdopendir(dirfd);
+    if (!dir) {
+        ::close(dirfd);
+        return;
+    }
+
+    while (struct dirent *entry = readdir(dir)) {
+        // cgroup 目录下绝大多数条目是接口文件，只有子目录才可能是子 cgroup
+        if (entry->d_type != DT_DIR && entry->d_type != DT_UNKNOWN) continue;
+        if (entry->d_name[0] == '.') continue;
+
+        const int childFd = ::openat(::dirfd(dir), entry->d_name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (childFd < 0) continue;
+
+        std::string childPath = relativePath;
+        if (!childPath.empty()) childPath += '/';
+        childPath += entry->d_name;
+
+        ContainerStats stats;
+        if (parseContainerName(entry->d_name, strlen(entry->d_name), name, stats.runtime, stats.id)) {
+            // cgroup 的统计包含所有子 cgroup，容器内部的嵌套层级不需要再往下遍历
+            stats.cgroupPath = QString::fromUtf8(childPath.c_str());
+            readContainer(childFd, stats, now);
+            ::close(childFd);
+            m_containers.append(stats);
+        } else if (depth + 1 < MaxWalkDepth) {
+            walk(childFd, childPath, entry->d_name, depth + 1, now);
+        } else {
+            ::close(childFd);
+        }
+    }
+    closedir(dir);
+}
+
+bool CgroupMonitor::readValue(int dirfd, const char *fileName, quint64 &value)
+{
+    // memory.max、pids.max 等文件在不限制时内容为 "max"，nextU64 失败，由调用方按 0 处理
+    value = 0;
+    if (!m_file.readOnceAt(dirfd, fileName)) return false;
+    ProcfsTokenizer tok(m_file);
+    return tok.nextU64(value);
+}
+
+void CgroupMonitor::readContainer(int dirfd, ContainerStats &stats, MonotonicNs now)
+{
+    const QByteArray key = stats.id.toLatin1();
+    QHash<QByteArray, RateState>::iterator state = m_rates.find(key);
+    if (state == m_rates.end()) {
+        state = m_rates.insert(key, RateState());
+    }
+    state->generation = m_generation;
+
+    // cpu.stat: usage_usec 123\nuser_usec ...\nthrottled_usec 0
+    if (m_file.readOnceAt(dirfd, "cpu.stat")) {
+        ProcfsTokenizer tok(m_file);
+        do {
+            const char *word;
+            size_t length;
+            quint64 value = 0;
+            if (!tok.nextWord(word, length) || !tok.nextU64(value)) continue;
+            // 每秒占用的 CPU 微秒数 / 10^4 = 占一个核的百分比
+            if (ProcfsTokenizer::equals(word, length, "usage_usec")) {
+                stats.cpuPercent = state->cpu.update(value, now) / 1e4;
+            } else if (ProcfsTokenizer::equals(word, length, "throttled_usec")) {
+                stats.cpuThrottledPercent = state->throttled.update(value, now) / 1e4;
+            }
+        } while (tok.nextLine());
+    }
+
+    // cpu.max: "max 100000" 或 "50000 100000"（配额 周期）
+    if (m_file.readOnceAt(dirfd, "cpu.max")) {
+        ProcfsTokenizer tok(m_file);
+        quint64 quota = 0, period = 0;
+        if (tok.nextU64(quota) && tok.nextU64(period) && period > 0) {
+            stats.cpuLimitCores = static_cast<double>(quota) / period;
+        }
+    }
+
+    readValue(dirfd, "memory.current", stats.memoryCurrent);
+    readValue(dirfd, "memory.max", stats.memoryLimit);
+
+    quint64 inactiveFile = 0;
+    if (m_file.readOnceAt(dirfd, "memory.stat")) {
+        ProcfsTokenizer tok(m_file);
+        do {
+            const char *word;
+            size_t length;
+            quint64 value = 0;
+            if (!tok.nextWord(word, length) || !tok.nextU64(value)) continue;
+            if (ProcfsTokenizer::equals(word, length, "anon")) {
+                stats.memoryAnon = value;
+            } else if (ProcfsTokenizer::equals(word, length, "file")) {
+                stats.memoryFile = value;
+            } else if (ProcfsTokenizer::equals(word, length, "inactive_file")) {
+                inactiveFile = value;
+            }
+        } while (tok.nextLine());
+    }
+    stats.memoryWorkingSet = stats.memoryCurrent > inactiveFile ? stats.memoryCurrent - inactiveFile : 0;
+
+    // io.stat: 每个设备一行 "8:0 rbytes=1 wbytes=2 rios=3 wios=4 dbytes=0 dios=0"
+    if (m_file.readOnceAt(dirfd, "io.stat")) {
+        ProcfsTokenizer tok(m_file);
+        do {
+            quint64 readBytes = 0, writeBytes = 0;
+            if (!tok.skipPast('=') || !tok.nextU64(readBytes)) continue;
+            if (!tok.skipPast('=') || !tok.nextU64(writeBytes)) continue;
+            stats.ioReadBytes += readBytes;
+            stats.ioWriteBytes += writeBytes;
+        } while (tok.nextLine());
+    }
+    stats.ioReadBytesPerSec = state->ioRead.update(stats.ioReadBytes, now);
+    stats.ioWriteBytesPerSec = state->ioWrite.update(stats.ioWriteBytes, now);
+
+    readValue(dirfd, "pids.current", stats.pids);
+}
+#else
+CgroupMonitor::CgroupMonitor(const char *root)
+    : m_lastRefresh(0)
+{
+    Q_UNUSED(root);
+}
+
+bool CgroupMonitor::isAvailable() const
+{
+    return false;
+}
+
+int CgroupMonitor::refresh()
+{
+    return 0;
+}
+#endif
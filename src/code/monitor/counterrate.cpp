@@ -0,0 +1,84 @@
+// counterrate.cpp
+#include "src/include/monitor/counterrate.h"
+
+CounterRate::CounterRate(int counterBits)
+    : m_mask(counterBits >= 64 ? ~0ULL : ((1ULL << counterBits) - 1))
+    , m_lastValue(0)
+    , m_lastTimestamp(0)
+    , m_lastDelta(0)
+    , m_hasBaseline(false)
+{
+}
+
+void CounterRate::reset() {
+    m_hasBaseline = false;
+    m_lastDelta = 0;
+}
+
+double CounterRate::update(quint64 value, MonotonicNs timestamp) {
+    value &= m_mask;
+    if (!m_hasBaseline || timestamp <= m_lastTimestamp) {
+        m_lastValue = value;
+        m_lastTimestamp = timestamp;
+        m_lastDelta = 0;
+        m_hasBaseline = true;
+        return 0.0;
+    }
+
+    quint64 delta;
+    if (value >= m_lastValue) {
+        delta = value - m_lastValue;
+    } else if (m_mask != ~0ULL && m_lastValue > m_mask / 2) {
+        // 窄计数器在上半区间变小：按回绕计算
+        delta = (m_mask - m_lastValue) + value + 1;
+    } else {
+        // 计数器被重置（驱动重载、接口重建等）：只能重新建立基线
+        m_lastValue = value;
+        m_lastTimestamp = timestamp;
+        m_lastDelta = 0;
+        return 0.0;
+    }
+
+    const MonotonicNs elapsed = timestamp - m_lastTimestamp;
+    m_lastValue = value;
+    m_lastTimestamp = timestamp;
+    m_lastDelta = delta;
+    return static_cast<double>(delta) * MonotonicClock::NsPerSec / elapsed;
+}
+
+CounterRateTable::CounterRateTable(int counterBits)
+    : m_counterBits(counterBits)
+    , m_generation(0)
+{
+}
+
+double CounterRateTable::update(const char *key, size_t keyLength, quint64 value, MonotonicNs timestamp) {
+    // 先用不拷贝的 QByteArray 查找，只有新来源才分配内存
+    const QByteArray lookup = QByteArray::fromRawData(key, static_cast<int>(keyLength));
+    QHash<QByteArray, Entry>::iterator it = m_entries.find(lookup);
+    if (it == m_entries.end()) {
+        Entry entry = { CounterRate(m_counterBits), m_generation };
+        it = m_entries.insert(QByteArray(key, static_cast<int>(keyLength)), entry);
+    }
+    it->generation = m_generation;
+    return it->rate.update(value, timestamp);
+}
+
+double CounterRateTable::update(const QByteArray &key, quint64 value, MonotonicNs timestamp) {
+    return update(key.constData(), static_cast<size_t>(key.size()), value, timestamp);
+}
+
+void CounterRateTable::sweep() {
+    for (QHash<QByteArray, Entry>::iterator it = m_entries.begin(); it != m_entries.end();) {
+        if (it->generation != m_generation) {
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    ++m_generation;
+}
+
+void CounterRateTable::clear() {
+    m_entries.clear();
+}
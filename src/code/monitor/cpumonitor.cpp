@@ -1,21 +1,22 @@
 // cpumonitor.cpp
 #include "src/include/monitor/cpumonitor.h"
+#include <algorithm>
 #ifdef Q_OS_WIN
 #include <windows.h>
 #include <pdh.h>
 #include <pdhmsg.h>
 #pragma comment(lib, "pdh.lib")
-#elif defined(Q_OS_LINUX)
-#include <fstream>
-#include <sstream>
 #endif
 
-CpuMonitor::CpuMonitor(QObject *parent) : QObject(parent) {
+CpuMonitor::CpuMonitor(QObject *parent)
+    : QObject(parent)
+#ifdef Q_OS_LINUX
+    , m_statFile("/proc/stat")
+#endif
+{
 #ifdef Q_OS_WIN
     initPdh();
 #elif defined(Q_OS_LINUX)
-    lastTotalUser = lastTotalUserLow = lastTotalSys = lastTotalIdle = 0;
-    initialized = false;
 #endif
 }
 
@@ -38,43 +39,155 @@ double CpuMonitor::getCpuUsage() const {
     PdhGetFormattedCounterValue((PDH_HCOUNTER)counterHandle, PDH_FMT_DOUBLE, NULL, &counterVal);
     return counterVal.doubleValue;
 #elif defined(Q_OS_LINUX)
-    std::ifstream file("/proc/stat");
-    std::string line;
-    std::getline(file, line);
-    std::istringstream iss(line);
-
-    std::string cpu;
-    quint64 user, nice, system, idle;
-    iss >> cpu >> user >> nice >> system >> idle;
-
-    quint64 totalUser = user;
-    quint64 totalUserLow = nice;
-    quint64 totalSys = system;
-    quint64 totalIdle = idle;
-
-    if (!initialized) {
-        lastTotalUser = totalUser;
-        lastTotalUserLow = totalUserLow;
-        lastTotalSys = totalSys;
-        lastTotalIdle = totalIdle;
-        initialized = true;
-        return 0.0;
-    }
+    if (!m_statFile.refresh() || !m_table.update(m_statFile.data(), m_statFile.end())) return 0.0;
+    return m_table.usage().isEmpty() ? 0.0 : m_table.usage().first();
+#endif
+    return 0.0;
+}
+
+int CpuMonitor::coreCount() const {
+#ifdef Q_OS_LINUX
+    return m_table.coreCount();
+#else
+    return 0;
+#endif
+}
 
-    quint64 diffUser = totalUser - lastTotalUser;
-    quint64 diffUserLow = totalUserLow - lastTotalUserLow;
-    quint64 diffSys = totalSys - lastTotalSys;
-    quint64 diffIdle = totalIdle - lastTotalIdle;
+QVector<double> CpuMonitor::coreUsage() const {
+#ifdef Q_OS_LINUX
+    return m_table.usage().mid(1);
+#else
+    return QVector<double>();
+#endif
+}
 
-    quint64 total = diffUser + diffUserLow + diffSys + diffIdle;
+QVector<double> CpuMonitor::coreIowait() const {
+#ifdef Q_OS_LINUX
+    return m_table.iowait().mid(1);
+#else
+    return QVector<double>();
+#endif
+}
 
-    lastTotalUser = totalUser;
-    lastTotalUserLow = totalUserLow;
-    lastTotalSys = totalSys;
-    lastTotalIdle = totalIdle;
+QVector<double> CpuMonitor::coreSteal() const {
+#ifdef Q_OS_LINUX
+    return m_table.steal().mid(1);
+#else
+    return QVector<double>();
+#endif
+}
 
-    if (total == 0) return 0.0;
-    return (double)(diffUser + diffUserLow + diffSys) / total * 100.0;
+double CpuMonitor::iowaitPercent() const {
+#ifdef Q_OS_LINUX
+    return m_table.iowait().isEmpty() ? 0.0 : m_table.iowait().first();
+#else
+    return 0.0;
 #endif
+}
+
+double CpuMonitor::stealPercent() const {
+#ifdef Q_OS_LINUX
+    return m_table.steal().isEmpty() ? 0.0 : m_table.steal().first();
+#else
     return 0.0;
+#endif
+}
+
+void CpuStatTable::resize(int rows) {
+    for (int f = 0; f < FieldCount; ++f) {
+        m_current[f].resize(rows, 0);
+        m_previous[f].resize(rows, 0);
+    }
+    m_deltaTotal.resize(rows, 0);
+    m_deltaIdle.resize(rows, 0);
+    m_deltaIowait.resize(rows, 0);
+    m_deltaSteal.resize(rows, 0);
+    m_seen.resize(rows, 0);
+    m_primed.resize(rows, 0);
+    m_usage.resize(rows);
+    m_iowait.resize(rows);
+    m_steal.resize(rows);
+    m_rows = rows;
+}
+
+bool CpuStatTable::update(const char *begin, const char *end) {
+    // 先把本次读数解析到 m_current，cpu 行在文件开头连续出现，遇到其他行即停止
+    ProcfsTokenizer tok(begin, end);
+    int rowsSeen = 0;
+    std::fill(m_seen.begin(), m_seen.end(), 0);
+    do {
+        if (!tok.startsWith("cpu")) break;
+        const char *word;
+        size_t length;
+        if (!tok.nextWord(word, length)) break;
+
+        int row = 0;
+        if (length > 3) {
+            int core = 0;
+            for (size_t i = 3; i < length; ++i) core = core * 10 + (word[i] - '0');
+            row = core + 1;
+        }
+        if (row >= m_rows) resize(row + 1);
+
+        // 旧内核可能只提供前几个字段，缺失的字段保持为 0
+        for (int f = 0; f < FieldCount; ++f) {
+            quint64 value = 0;
+            if (!tok.nextU64(value)) break;
+            m_current[f][row] = value;
+        }
+        m_seen[row] = 1;
+        ++rowsSeen;
+    } while (tok.nextLine());
+
+    if (rowsSeen == 0) return false;
+
+    const size_t n = static_cast<size_t>(m_rows);
+    if (!m_hasBaseline) {
+        for (int f = 0; f < FieldCount; ++f) m_previous[f] = m_current[f];
+        m_primed = m_seen;
+        m_usage.fill(0.0);
+        m_iowait.fill(0.0);
+        m_steal.fill(0.0);
+        m_hasBaseline = true;
+        return true;
+    }
+
+    std::fill(m_deltaTotal.begin(), m_deltaTotal.end(), 0);
+    quint64 *total = m_deltaTotal.data();
+
+    // guest/guest_nice 已计入 user/nice，不重复累加
+    for (int f = User; f <= Steal; ++f) {
+        const quint64 *cur = m_current[f].data();
+        const quint64 *prev = m_previous[f].data();
+        quint64 *delta = f == Idle ? m_deltaIdle.data()
+                       : f == IoWait ? m_deltaIowait.data()
+                       : f == Steal ? m_deltaSteal.data()
+                       : nullptr;
+        for (size_t i = 0; i < n; ++i) {
+            // 计数器回退（CPU 下线后重新上线）时按 0 处理
+            quint64 d = cur[i] >= prev[i] ? cur[i] - prev[i] : 0;
+            total[i] += d;
+            if (delta) delta[i] = d;
+        }
+    }
+
+    const quint64 *idle = m_deltaIdle.data();
+    const quint64 *iowait = m_deltaIowait.data();
+    const quint64 *steal = m_deltaSteal.data();
+    double *usageOut = m_usage.data();
+    double *iowaitOut = m_iowait.data();
+    double *stealOut = m_steal.data();
+    for (size_t i = 0; i < n; ++i) {
+        // 本次没有出现的核（已下线）以及刚上线、还没有基线的核记为 0
+        double scale = total[i] > 0 && m_seen[i] && m_primed[i] ? 100.0 / total[i] : 0.0;
+        usageOut[i] = (total[i] - idle[i] - iowait[i]) * scale;
+        iowaitOut[i] = iowait[i] * scale;
+        stealOut[i] = steal[i] * scale;
+        m_primed[i] |= m_seen[i];
+    }
+
+    // 复制而不是交换：没有出现的行在 m_current 中保留最后一次读数，下次仍与 m_previous 相同，
+    // 交换会让它们在相隔两次的旧值之间来回跳动
+    for (int f = 0; f < FieldCount; ++f) m_previous[f] = m_current[f];
+    return true;
 }
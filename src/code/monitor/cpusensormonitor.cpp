@@ -0,0 +1,281 @@
+// cpusensormonitor.cpp
+#include "src/include/monitor/cpusensormonitor.h"
+#ifdef Q_OS_LINUX
+#include <algorithm>
+#include <dirent.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+#ifdef Q_OS_LINUX
+static const MonotonicNs RescanInterval = MonotonicClock::fromSecs(60);
+
+// 温度传感器的优先级，数值越大越接近封装温度
+enum TemperaturePriority {
+    TemperatureAcpi = 1,             // acpitz：主板上的 ACPI 温度区，只在没有其他来源时使用
+    TemperatureCpuZone,              // ARM 等平台名称含 cpu / soc 的 thermal_zone
+    TemperaturePackageZone,          // Intel x86_pkg_temp
+    TemperatureTctl,                 // AMD Tctl，部分型号带有风扇控制用的偏移
+    TemperaturePackage               // coretemp Package id N、AMD Tdie
+};
+
+// "cpu12" -> 12，不是 cpuN 形式时返回 -1
+static int parseIndexedName(const char *name, const char *prefix)
+{
+    const size_t prefixLength = strlen(prefix);
+    if (strncmp(name, prefix, prefixLength) != 0 || name[prefixLength] == '\0') return -1;
+    int value = 0;
+    for (const char *p = name + prefixLength; *p; ++p) {
+        if (*p < '0' || *p > '9') return -1;
+        value = value * 10 + (*p - '0');
+    }
+    return value;
+}
+
+// 读取 name、type、label 这类单行文本文件，去掉结尾换行
+static bool readLine(ProcfsFile &scratch, const std::string &path, QString &text)
+{
+    if (!scratch.readOnce(path.c_str())) return false;
+    const char *begin = scratch.data();
+    const char *end = scratch.end();
+    while (end > begin && (end[-1] == '\n' || end[-1] == ' ')) --end;
+    text = QString::fromLatin1(begin, static_cast<int>(end - begin));
+    return true;
+}
+
+static bool readMHz(ProcfsFile &scratch, const std::string &path, double &mhz)
+{
+    quint64 khz = 0;
+    if (!scratch.readOnce(path.c_str())) return false;
+    ProcfsTokenizer tok(scratch);
+    if (!tok.nextU64(khz)) return false;
+    mhz = khz / 1000.0;
+    return true;
+}
+
+CpuSensorMonitor::CpuSensorMonitor(const char *sysfsRoot)
+    : m_root(sysfsRoot ? sysfsRoot : "/sys")
+    , m_scratch(nullptr, 256)
+    , m_lastScan(0)
+{
+    rescan();
+}
+
+bool CpuSensorMonitor::isAvailable() const
+{
+    return !m_frequencyFiles.empty() || !m_temperatureFiles.empty();
+}
+
+void CpuSensorMonitor::rescan()
+{
+    m_frequencyFiles.clear();
+    m_temperatureFiles.clear();
+    m_stats.ratedMaxFrequencyMHz = 0.0;
+    scanFrequencyFiles();
+    scanHwmonSensors();
+    scanThermalZones();
+    m_lastScan = MonotonicClock::now();
+}
+
+void CpuSensorMonitor::scanFrequencyFiles()
+{
+    const std::string cpuDirectory = m_root + "/devices/system/cpu/";
+    DIR *dir = opendir(cpuDirectory.c_str());
+    if (!dir) return;
+
+    while (struct dirent *entry = readdir(dir)) {
+        const int cpu = parseIndexedName(entry->d_name, "cpu");
+        if (cpu < 0) continue;
+        const std::string cpufreq = cpuDirectory + entry->d_name + "/cpufreq/";
+        const std::string path = cpufreq + "scaling_cur_freq";
+        // 离线的核、没有 cpufreq 驱动的虚拟机上不存在该文件
+        if (access(path.c_str(), R_OK) != 0) continue;
+
+        // 值只有十几个字节，缓冲区不必按默认的 4KB 分配
+        CoreFrequencyFile core = { cpu, ProcfsFile(path.c_str(), 32) };
+        m_frequencyFiles.push_back(std::move(core));
+
+        double ratedMax = 0.0;
+        if (readMHz(m_scratch, cpufreq + "cpuinfo_max_freq", ratedMax)) {
+            m_stats.ratedMaxFrequencyMHz = qMax(m_stats.ratedMaxFrequencyMHz, ratedMax);
+        }
+    }
+    closedir(dir);
+
+    std::sort(m_frequencyFiles.begin(), m_frequencyFiles.end(),
+              [](const CoreFrequencyFile &a, const CoreFrequencyFile &b) { return a.cpu < b.cpu; });
+}
+
+void CpuSensorMonitor::addTemperatureFile(int priority, const QString &source, const std::string &path)
+{
+    // 只保留优先级最高的一类传感器
+    if (!m_temperatureFiles.empty()) {
+        if (priority < m_temperatureFiles.front().priority) return;
+        if (priority > m_temperatureFiles.front().priority) m_temperatureFiles.clear();
+    }
+    TemperatureFile sensor = { priority, source, ProcfsFile(path.c_str(), 32) };
+    m_temperatureFiles.push_back(std::move(sensor));
+}
+
+void CpuSensorMonitor::scanHwmonSensors()
+{
+    const std::string hwmonDirectory = m_root + "/class/hwmon/";
+    DIR *dir = opendir(hwmonDirectory.c_str());
+    if (!dir) return;
+
+    while (struct dirent *entry = readdir(dir)) {
+        if (parseIndexedName(entry->d_name, "hwmon") < 0) continue;
+        const std::string base = hwmonDirectory + entry->d_name + "/";
+        QString name;
+        if (!readLine(m_scratch, base + "name", name)) continue;
+        const bool intel = name == "coretemp";
+        const bool amd = name == "k10temp" || name == "zenpower";
+        if (!intel && !amd) continue;
+
+        // 按 temp*_label 找到封装温度对应的 temp*_input
+        DIR *sensorDir = opendir(base.c_str());
+        if (!sensorDir) continue;
+        while (struct dirent *sensor = readdir(sensorDir)) {
+            const char *fileName = sensor->d_name;
+            const size_t length = strlen(fileName);
+            static const char LabelSuffix[] = "_label";
+            const size_t suffixLength = sizeof(LabelSuffix) - 1;
+            if (strncmp(fileName, "temp", 4) != 0 || length <= suffixLength
+                || strcmp(fileName + length - suffixLength, LabelSuffix) != 0) {
+                continue;
+            }
+            QString label;
+            if (!readLine(m_scratch, base + fileName, label)) continue;
+
+            int priority = 0;
+            if (intel && label.startsWith("Package id")) {
+                priority = TemperaturePackage;
+            } else if (amd && label == "Tdie") {
+                priority = TemperaturePackage;
+            } else if (amd && label == "Tctl") {
+                priority = TemperatureTctl;
+            }
+            if (priority == 0) continue;
+            const std::string input = base + std::string(fileName, length - suffixLength) + "_input";
+            addTemperatureFile(priority, name, input);
+        }
+        closedir(sensorDir);
+    }
+    closedir(dir);
+}
+
+void CpuSensorMonitor::scanThermalZones()
+{
+    const std::string thermalDirectory = m_root + "/class/thermal/";
+    DIR *dir = opendir(thermalDirectory.c_str());
+    if (!dir) return;
+
+    while (struct dirent *entry = readdir(dir)) {
+        if (parseIndexedName(entry->d_name, "thermal_zone") < 0) continue;
+        const std::string base = thermalDirectory + entry->d_name + "/";
+        QString type;
+        if (!readLine(m_scratch, base + "type", type)) continue;
+
+        int priority = 0;
+        if (type == "x86_pkg_temp") {
+            priority = TemperaturePackageZone;
+        } else if (type.contains("cpu", Qt::CaseInsensitive) || type.contains("soc", Qt::CaseInsensitive)) {
+            priority = TemperatureCpuZone;
+        } else if (type == "acpitz") {
+            priority = TemperatureAcpi;
+        }
+        if (priority == 0) continue;
+        addTemperatureFile(priority, type, base + "temp");
+    }
+    closedir(dir);
+}
+
+bool CpuSensorMonitor::refresh()
+{
+    if (MonotonicClock::now() - m_lastScan > RescanInterval) {
+        rescan();
+    }
+    const bool frequencies = readFrequencies();
+    const bool temperatures = readTemperatures();
+    return frequencies || temperatures;
+}
+
+bool CpuSensorMonitor::readFrequencies()
+{
+    CpuSensorStats &stats = m_stats;
+    stats.frequencyValid = false;
+    if (m_frequencyFiles.empty()) {
+        stats.coreFrequencyMHz.clear();
+        return false;
+    }
+
+    // 文件按 CPU 编号排序，最后一个的编号决定数组长度
+    stats.coreFrequencyMHz.fill(0.0, m_frequencyFiles.back().cpu + 1);
+    double sum = 0.0;
+    int count = 0;
+    for (CoreFrequencyFile &core : m_frequencyFiles) {
+        quint64 khz = 0;
+        if (!core.file.refresh()) continue;
+        ProcfsTokenizer tok(core.file);
+        if (!tok.nextU64(khz)) continue;
+
+        const double mhz = khz / 1000.0;
+        stats.coreFrequencyMHz[core.cpu] = mhz;
+        if (count == 0 || mhz < stats.minFrequencyMHz) stats.minFrequencyMHz = mhz;
+        if (count == 0 || mhz > stats.maxFrequencyMHz) stats.maxFrequencyMHz = mhz;
+        sum += mhz;
+        ++count;
+    }
+    stats.frequencyValid = count > 0;
+    stats.averageFrequencyMHz = count > 0 ? sum / count : 0.0;
+    if (count == 0) {
+        stats.minFrequencyMHz = 0.0;
+        stats.maxFrequencyMHz = 0.0;
+    }
+    return stats.frequencyValid;
+}
+
+bool CpuSensorMonitor::readTemperatures()
+{
+    CpuSensorStats &stats = m_stats;
+    stats.temperatureValid = false;
+    for (TemperatureFile &sensor : m_temperatureFiles) {
+        // 毫摄氏度，thermal_zone 在低温时可能为负数
+        qint64 milliCelsius = 0;
+        if (!sensor.file.refresh()) continue;
+        ProcfsTokenizer tok(sensor.file);
+        if (!tok.nextI64(milliCelsius)) continue;
+
+        const double celsius = milliCelsius / 1000.0;
+        if (!stats.temperatureValid || celsius > stats.packageTemperature) {
+            stats.packageTemperature = celsius;
+            stats.temperatureSource = sensor.source;
+        }
+        stats.temperatureValid = true;
+    }
+    if (!stats.temperatureValid) {
+        stats.packageTemperature = 0.0;
+        stats.temperatureSource.clear();
+    }
+    return stats.temperatureValid;
+}
+#else
+CpuSensorMonitor::CpuSensorMonitor(const char *sysfsRoot)
+{
+    Q_UNUSED(sysfsRoot);
+}
+
+bool CpuSensorMonitor::isAvailable() const
+{
+    return false;
+}
+
+bool CpuSensorMonitor::refresh()
+{
+    return false;
+}
+
+void CpuSensorMonitor::rescan()
+{
+}
+#endif
@@ -4,49 +4,136 @@
 #include <windows.h>
 #include <winioctl.h>
 #elif defined(Q_OS_LINUX)
-#include <fstream>
-#include <sstream>
+#include <dirent.h>
+#include <unistd.h>
+#include <cstring>
 #endif
 
-DiskMonitor::DiskMonitor(QObject *parent) : QObject(parent) {
+DiskMonitor::DiskMonitor(QObject *parent)
+    : QObject(parent)
+#ifdef Q_OS_LINUX
+    , m_diskstatsFile("/proc/diskstats")
+    , m_generation(0)
+#endif
+{
 #ifdef Q_OS_WIN
     lastReadBytes = lastWriteBytes = 0;
-#elif defined(Q_OS_LINUX)
-    lastReadSectors = lastWriteSectors = 0;
 #endif
 }
   
 double DiskMonitor::getDiskIO() const {
+    QPair<quint64, quint64> io = getDiskIODetailed();
+    return static_cast<double>(io.first + io.second) / (1024.0 * 1024.0); // MB/s
+}
+
+#ifdef Q_OS_LINUX
+// 目录不存在或只有 . 和 .. 时返回 true
+static bool isEmptyDirectory(const char *path) {
+    DIR *dir = opendir(path);
+    if (!dir) return true;
+    bool empty = true;
+    while (struct dirent *entry = readdir(dir)) {
+        if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0) {
+            empty = false;
+            break;
+        }
+    }
+    closedir(dir);
+    return empty;
+}
+
+DiskMonitor::Device &DiskMonitor::device(const char *name, size_t length) const {
+    const QByteArray lookup = QByteArray::fromRawData(name, static_cast<int>(length));
+    QHash<QByteArray, Device>::iterator it = m_devices.find(lookup);
+    if (it == m_devices.end()) {
+        // /sys/block 只列出整盘设备，分区只出现在 /sys/block/<disk>/ 下面；
+        // dm、md 等设备的 slaves 目录指向下层设备，只统计叶子设备才不会重复计算同一份 I/O
+        const QByteArray key(name, static_cast<int>(length));
+        const QByteArray sysPath = "/sys/block/" + key;
+        Device dev;
+        dev.generation = m_generation;
+        dev.wholeDisk = access(sysPath.constData(), F_OK) == 0;
+        dev.loopLike = key.startsWith("loop") || key.startsWith("ram") || key.startsWith("zram");
+        dev.physical = dev.wholeDisk && !dev.loopLike && isEmptyDirectory((sysPath + "/slaves").constData());
+        it = m_devices.insert(key, dev);
+    }
+    it->generation = m_generation;
+    return *it;
+}
+
+void DiskMonitor::sweepDevices() const {
+    for (QHash<QByteArray, Device>::iterator it = m_devices.begin(); it != m_devices.end();) {
+        if (it->generation != m_generation) {
+            it = m_devices.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    ++m_generation;
+}
+#endif
+
+QPair<quint64, quint64> DiskMonitor::getDiskIODetailed() const {
 #ifdef Q_OS_WIN
-    static ULARGE_INTEGER idleTime, kernelTime, userTime;
-    static FILETIME idle, kernel, user;
-    GetSystemTimes(&idle, &kernel, &user);
-    return 0.0; // Windows实现通常较复杂，可考虑查询性能计数器
+    return QPair<quint64, quint64>(0, 0); // Windows实现通常较复杂，可考虑查询性能计数器
 #elif defined(Q_OS_LINUX)
-    std::ifstream file("/proc/diskstats");
-    std::string line;
-    quint64 totalRead = 0, totalWrite = 0;
-    while (std::getline(file, line)) {
-        std::istringstream iss(line);
-        std::string dev;
-        quint64 major, minor, reads, rdMerged, rdSectors, rdTime;
-        quint64 writes, wrMerged, wrSectors, wrTime;
-        iss >> major >> minor >> dev;
-        iss >> reads >> rdMerged >> rdSectors >> rdTime;
-        iss >> writes >> wrMerged >> wrSectors >> wrTime;
-
-        if (dev.find("sd") == 0 || dev.find("nvme") == 0) {
-            totalRead += rdSectors;
-            totalWrite += wrSectors;
+    if (!m_diskstatsFile.refresh()) return QPair<quint64, quint64>(0, 0);
+
+    const MonotonicNs now = MonotonicClock::now();
+    ProcfsTokenizer tok(m_diskstatsFile);
+    QVector<DiskDeviceStats> stats;
+    stats.reserve(m_deviceStats.size());
+    double readRate = 0.0, writeRate = 0.0;
+    do {
+        // major minor name reads rd_merged rd_sectors rd_ticks writes wr_merged wr_sectors wr_ticks
+        //                  in_flight io_ticks time_in_queue [discard ... flush ...]
+        enum { Reads, ReadMerged, ReadSectors, ReadTicks, Writes, WriteMerged, WriteSectors, WriteTicks,
+               InFlight, IoTicks, TimeInQueue, FieldCount };
+        const char *name;
+        size_t nameLength;
+        quint64 f[FieldCount];
+        if (!tok.skipFields(2) || !tok.nextWord(name, nameLength)) continue;
+        int n = 0;
+        while (n < FieldCount && tok.nextU64(f[n])) ++n;
+        if (n < FieldCount) continue;
+
+        Device &dev = device(name, nameLength);
+        if (!dev.wholeDisk) continue;
+
+        DiskDeviceStats s;
+        s.name = QString::fromLatin1(name, static_cast<int>(nameLength));
+        s.physical = dev.physical;
+        s.readIops = dev.reads.update(f[Reads], now);
+        s.writeIops = dev.writes.update(f[Writes], now);
+        // 扇区固定为512B
+        s.readBytesPerSec = dev.readSectors.update(f[ReadSectors], now) * 512.0;
+        s.writeBytesPerSec = dev.writeSectors.update(f[WriteSectors], now) * 512.0;
+        dev.readTicks.update(f[ReadTicks], now);
+        dev.writeTicks.update(f[WriteTicks], now);
+        // io_ticks 是设备有请求在处理的毫秒数，每秒增加的毫秒数 / 10 即为忙碌百分比
+        s.utilization = qMin(100.0, dev.ioTicks.update(f[IoTicks], now) / 10.0);
+        // time_in_queue 按在途请求数加权，每秒增加的毫秒数 / 1000 即为平均队列深度
+        s.queueDepth = dev.weightedTicks.update(f[TimeInQueue], now) / 1000.0;
+        if (dev.reads.lastDelta() > 0) {
+            s.readAwaitMs = static_cast<double>(dev.readTicks.lastDelta()) / dev.reads.lastDelta();
+        }
+        if (dev.writes.lastDelta() > 0) {
+            s.writeAwaitMs = static_cast<double>(dev.writeTicks.lastDelta()) / dev.writes.lastDelta();
         }
-    }
 
-    quint64 readDiff = totalRead - lastReadSectors;
-    quint64 writeDiff = totalWrite - lastWriteSectors;
-    lastReadSectors = totalRead;
-    lastWriteSectors = totalWrite;
+        // 逐设备计算速率再求和，设备增减不会让总和出现跳变
+        if (dev.physical) {
+            readRate += s.readBytesPerSec;
+            writeRate += s.writeBytesPerSec;
+        }
+        // 未使用过的 loop/ram 设备数量很多，不显示
+        if (dev.loopLike && f[Reads] == 0 && f[Writes] == 0) continue;
+        stats.append(s);
+    } while (tok.nextLine());
+    sweepDevices();
+    m_deviceStats.swap(stats);
 
-    return static_cast<double>(readDiff + writeDiff) / 2048.0; // 假设扇区512B -> MB/s
+    return QPair<quint64, quint64>(static_cast<quint64>(readRate), static_cast<quint64>(writeRate));
 #endif
-    return 0.0;
+    return QPair<quint64, quint64>(0, 0);
 }
@@ -0,0 +1,478 @@
+// gpuprobe.cpp
+#include "src/include/monitor/gpuprobe.h"
+#include <QProcess>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QTextStream>
+#include <QRegularExpression>
+#include <QStringList>
+#ifdef Q_OS_LINUX
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+static GpuVendor vendorFromName(const QString &name)
+{
+    if (name.contains("NVIDIA", Qt::CaseInsensitive)) return GpuVendorNvidia;
+    if (name.contains("AMD", Qt::CaseInsensitive) || name.contains("Radeon", Qt::CaseInsensitive)) return GpuVendorAmd;
+    if (name.contains("Intel", Qt::CaseInsensitive)) return GpuVendorIntel;
+    return GpuVendorUnknown;
+}
+
+static GpuInfo finishDetection(GpuInfo &info)
+{
+    info.available = true;
+    if (info.vendor == GpuVendorUnknown) {
+        info.vendor = vendorFromName(info.name);
+    }
+    return info;
+}
+
+#ifdef Q_OS_LINUX
+static QString readSysfsLine(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) return QString();
+    return QString::fromUtf8(file.readLine()).trimmed();
+}
+
+// sysfs 探测结果的可信程度，数值越大越优先
+enum SysfsRank {
+    SysfsNotFound = 0,
+    SysfsUnknownVendor = 1,  // BMC 显示控制器（ASPEED）、virtio-gpu、QXL、VMware SVGA 等，只在工具也找不到时使用
+    SysfsIntegrated = 2,
+    SysfsDiscrete = 3
+};
+
+// 遍历 /sys/class/drm/card*，按 PCI 厂商 ID 识别显卡，不启动任何进程
+// 同时有独立显卡和集成显卡时优先独立显卡，返回选中设备的 SysfsRank
+static int detectFromSysfs(GpuInfo &result)
+{
+    QDir drm("/sys/class/drm");
+    const QStringList cards = drm.entryList(QStringList() << "card*", QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
+
+    int bestRank = 0;
+    for (const QString &card : cards) {
+        // card0-HDMI-A-1 这类是显示接口，不是设备
+        if (card.contains('-')) continue;
+
+        const QString devicePath = drm.filePath(card) + "/device";
+        const QString vendorId = readSysfsLine(devicePath + "/vendor");
+        GpuInfo info;
+        int rank = SysfsUnknownVendor;
+        if (vendorId == "0x10de") {
+            info.vendor = GpuVendorNvidia;
+            rank = SysfsDiscrete;
+        } else if (vendorId == "0x1002") {
+            info.vendor = GpuVendorAmd;
+            rank = SysfsDiscrete;
+        } else if (vendorId == "0x8086") {
+            info.vendor = GpuVendorIntel;
+            rank = SysfsIntegrated;
+        } else if (vendorId.isEmpty()) {
+            continue;
+        }
+        if (rank <= bestRank) continue;
+
+        info.devicePath = devicePath;
+        info.pciAddress = QFileInfo(QFileInfo(devicePath).canonicalFilePath()).fileName();
+        const QString driver = QFileInfo(QFileInfo(devicePath + "/driver").canonicalFilePath()).fileName();
+
+        // 树外驱动（nvidia）在 /sys/module 下有版本号，树内驱动（amdgpu、i915）跟随内核，只显示驱动名
+        const QString moduleVersion = driver.isEmpty() ? QString() : readSysfsLine("/sys/module/" + driver + "/version");
+        if (!moduleVersion.isEmpty()) {
+            info.driverVersion = moduleVersion;
+        } else if (!driver.isEmpty()) {
+            info.driverVersion = driver;
+        } else {
+            info.driverVersion = "未知";
+        }
+
+        // 型号名称：NVIDIA 驱动在 /proc 中提供，部分 amdgpu 设备有 product_name，其余用 lspci 查询这一个设备
+        if (info.vendor == GpuVendorNvidia) {
+            QFile information("/proc/driver/nvidia/gpus/" + info.pciAddress + "/information");
+            if (information.open(QIODevice::ReadOnly | QIODevice::Text)) {
+                QTextStream in(&information);
+                QString line;
+                while (in.readLineInto(&line)) {
+                    if (line.startsWith("Model:")) {
+                        info.name = line.section(':', 1).trimmed();
+                        break;
+                    }
+                }
+            }
+        }
+        if (info.name.isEmpty()) {
+            info.name = readSysfsLine(devicePath + "/product_name");
+        }
+        if (info.name.isEmpty() && !info.pciAddress.isEmpty()) {
+            QProcess lspciProcess;
+            lspciProcess.start("lspci", QStringList() << "-s" << info.pciAddress);
+            if (lspciProcess.waitForFinished(3000) && lspciProcess.exitCode() == 0) {
+                // 01:00.0 VGA compatible controller: Advanced Micro Devices, Inc. [AMD/ATI] Navi 21 ...
+                info.name = QString::fromUtf8(lspciProcess.readAllStandardOutput()).section(": ", 1).trimmed();
+            }
+        }
+        if (info.name.isEmpty()) {
+            info.name = QString("GPU %1").arg(info.pciAddress.isEmpty() ? card : info.pciAddress);
+        }
+
+        bestRank = rank;
+        result = info;
+        finishDetection(result);
+    }
+    return bestRank;
+}
+#endif
+
+// 依次调用平台工具探测：Windows 为 nvidia-smi、WMI、dxdiag，Linux 为 rocm-smi、lspci
+static GpuInfo detectWithTools()
+{
+    GpuInfo info;
+#ifdef Q_OS_WIN
+    // Windows平台：优先使用nvidia-smi，然后WMI，最后dxdiag
+    
+    // 1. 尝试nvidia-smi（适用于NVIDIA GPU）
+    QProcess nvidiaProcess;
+    nvidiaProcess.start("nvidia-smi", QStringList() << "--query-gpu=name,driver_version" << "--format=csv,noheader");
+    
+    if (nvidiaProcess.waitForFinished(3000) && nvidiaProcess.exitCode() == 0) {
+        QString output = nvidiaProcess.readAllStandardOutput().trimmed();
+        if (!output.isEmpty()) {
+            QStringList parts = output.split(",");
+            if (parts.size() >= 2) {
+                info.name = parts[0].trimmed();
+                info.driverVersion = parts[1].trimmed();
+                return finishDetection(info);
+            }
+        }
+    }
+    
+    // 2. 尝试WMI查询（适用于所有GPU）
+    QProcess wmiProcess;
+    wmiProcess.start("wmic", QStringList() << "path" << "win32_VideoController" 
+                     << "get" << "Name,DriverVersion,AdapterRAM" << "/format:csv");
+    
+    if (wmiProcess.waitForFinished(5000) && wmiProcess.exitCode() == 0) {
+        QString output = wmiProcess.readAllStandardOutput();
+        QStringList lines = output.split("\n");
+        
+        QString bestGpuName, bestDriverVersion;
+        quint64 bestMemory = 0;
+        
+        for (int i = 1; i < lines.size(); i++) {
+            QString line = lines[i].trimmed();
+            if (line.isEmpty()) continue;
+            
+            QStringList parts = line.split(",");
+            if (parts.size() < 4) continue;
+            
+            QString name = parts[2].trimmed();
+            QString driver = parts[1].trimmed();
+            
+            // 过滤掉虚拟显示适配器
+            if (name.contains("Microsoft Basic Display", Qt::CaseInsensitive) ||
+                name.contains("Remote Display", Qt::CaseInsensitive) ||
+                name.contains("VNC", Qt::CaseInsensitive) ||
+                name.isEmpty()) {
+                continue;
+            }
+            
+            // 解析内存大小
+            quint64 memory = 0;
+            if (parts.size() >= 4) {
+                bool ok;
+                memory = parts[0].trimmed().toULongLong(&ok);
+                if (!ok) memory = 0;
+            }
+            
+            // GPU优先级：独立显卡 > 集成显卡
+            bool isDiscrete = name.contains("NVIDIA", Qt::CaseInsensitive) || 
+                             name.contains("AMD", Qt::CaseInsensitive) ||
+                             name.contains("Radeon", Qt::CaseInsensitive);
+            
+            bool isIntegrated = name.contains("Intel", Qt::CaseInsensitive) ||
+                               name.contains("UHD", Qt::CaseInsensitive) ||
+                               name.contains("HD Graphics", Qt::CaseInsensitive) ||
+                               name.contains("Iris", Qt::CaseInsensitive);
+            
+            // 优先选择独立显卡
+            if (isDiscrete) {
+                if (bestGpuName.isEmpty() || memory > bestMemory || 
+                    (!bestGpuName.contains("NVIDIA", Qt::CaseInsensitive) && 
+                     !bestGpuName.contains("AMD", Qt::CaseInsensitive) &&
+                     !bestGpuName.contains("Radeon", Qt::CaseInsensitive))) {
+                    bestGpuName = name;
+                    bestDriverVersion = driver;
+                    bestMemory = memory;
+                }
+            }
+            // 如果没有独立显卡，选择集成显卡
+            else if ((isIntegrated || bestGpuName.isEmpty()) && 
+                    (!bestGpuName.contains("NVIDIA", Qt::CaseInsensitive) && 
+                     !bestGpuName.contains("AMD", Qt::CaseInsensitive) &&
+                     !bestGpuName.contains("Radeon", Qt::CaseInsensitive))) {
+                if (bestGpuName.isEmpty() || memory > bestMemory) {
+                    bestGpuName = name;
+                    bestDriverVersion = driver;
+                    bestMemory = memory;
+                }
+            }
+        }
+        
+        if (!bestGpuName.isEmpty()) {
+            info.name = bestGpuName;
+            info.driverVersion = bestDriverVersion;
+            return finishDetection(info);
+        }
+    }
+    
+    // 3. 最后尝试dxdiag
+    QProcess dxdiagProcess;
+    dxdiagProcess.start("dxdiag", QStringList() << "/t" << "gpuinfo.txt");
+    
+    if (dxdiagProcess.waitForFinished(10000)) {
+        QThread::msleep(500);
+        
+        QFile file("gpuinfo.txt");
+        if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            QTextStream in(&file);
+            QString content = in.readAll();
+            file.close();
+            file.remove();
+            
+            QRegularExpression nameRx("Card name: (.+)");
+            QRegularExpression driverRx("Driver Version: (.+)");
+            
+            QRegularExpressionMatch nameMatch = nameRx.match(content);
+            if (nameMatch.hasMatch()) {
+                info.name = nameMatch.captured(1).trimmed();
+                
+                QRegularExpressionMatch driverMatch = driverRx.match(content);
+                if (driverMatch.hasMatch()) {
+                    info.driverVersion = driverMatch.captured(1).trimmed();
+                } else {
+                    info.driverVersion = "未知";
+                }
+                
+                return finishDetection(info);
+            }
+        }
+    }
+    
+#elif defined(Q_OS_LINUX)
+    // sysfs 中没有找到已知厂商的 drm 设备时的后备：rocm-smi 和 lspci
+    
+    // 1. 尝试rocm-smi（AMD GPU）
+    QProcess amdProcess;
+    amdProcess.start("rocm-smi", QStringList() << "--showproductname" << "--showdriverversion");
+    
+    if (amdProcess.waitForFinished(3000) && amdProcess.exitCode() == 0) {
+        QString output = amdProcess.readAllStandardOutput().trimmed();
+        
+        if (!output.isEmpty()) {
+            QStringList lines = output.split("\n");
+            QString gpuName, driverVersion;
+            
+            for (const QString& line : lines) {
+                if (line.contains("GPU Product Name")) {
+                    gpuName = line.section(':', 1).trimmed();
+                } else if (line.contains("Driver Version")) {
+                    driverVersion = line.section(':', 1).trimmed();
+                }
+            }
+            
+            if (!gpuName.isEmpty()) {
+                info.name = gpuName;
+                info.driverVersion = driverVersion;
+                return finishDetection(info);
+            }
+        }
+    }
+    
+    // 2. 尝试lspci查询GPU
+    QProcess lspciProcess;
+    lspciProcess.start("lspci", QStringList() << "-v");
+    
+    if (lspciProcess.waitForFinished(3000) && lspciProcess.exitCode() == 0) {
+        QString output = lspciProcess.readAllStandardOutput().trimmed();
+        QStringList lines = output.split("\n");
+        
+        QString gpuInfo;
+        for (int i = 0; i < lines.size(); i++) {
+            if (lines[i].contains("VGA compatible controller") || 
+                lines[i].contains("3D controller")) {
+                gpuInfo = lines[i].section(':', 1).trimmed();
+                
+                // 查找驱动信息
+                for (int j = i + 1; j < qMin(i + 10, lines.size()); j++) {
+                    if (lines[j].contains("Kernel driver in use") || 
+                        lines[j].contains("Module")) {
+                        info.driverVersion = lines[j].section(':', 1).trimmed();
+                        break;
+                    }
+                }
+                break;
+            }
+        }
+        
+        if (!gpuInfo.isEmpty()) {
+            info.name = gpuInfo;
+            if (info.driverVersion.isEmpty()) {
+                info.driverVersion = "未知";
+            }
+            return finishDetection(info);
+        }
+    }
+#endif
+    return GpuInfo();
+}
+
+GpuInfo GpuProbe::detect()
+{
+#ifdef Q_OS_LINUX
+    // 厂商不认识的 drm 设备不能跳过工具探测：服务器上的 BMC 显示控制器和虚拟机的虚拟显卡都是这一类，
+    // 真正的计算卡可能还没有加载 drm 驱动，只有 rocm-smi / lspci 能找到
+    GpuInfo info;
+    const int rank = detectFromSysfs(info);
+    if (rank > SysfsUnknownVendor) {
+        return info;
+    }
+    const GpuInfo tools = detectWithTools();
+    if (tools.available || rank == SysfsNotFound) {
+        return tools;
+    }
+    return info;
+#else
+    return detectWithTools();
+#endif
+}
+
+GpuProbe::GpuProbe(QObject *parent)
+    : QObject(parent)
+#ifdef Q_OS_LINUX
+    , m_ueventFd(-1)
+    , m_ueventNotifier(nullptr)
+#endif
+    , m_recheckTimer(new QTimer(this))
+    , m_debounceTimer(new QTimer(this))
+    , m_worker(nullptr)
+    , m_probePending(false)
+    , m_hasResult(false)
+{
+    m_debounceTimer->setSingleShot(true);
+    m_debounceTimer->setInterval(1000);
+    connect(m_debounceTimer, &QTimer::timeout, this, &GpuProbe::launchProbe);
+    connect(m_recheckTimer, &QTimer::timeout, this, &GpuProbe::launchProbe);
+}
+
+GpuProbe::~GpuProbe()
+{
+    // 探测线程中的 nvidia-smi 等最多阻塞几秒，等它结束；尚未投递的结果随本对象一起丢弃
+    if (m_worker) {
+        m_worker->wait();
+        delete m_worker;
+    }
+#ifdef Q_OS_LINUX
+    if (m_ueventFd >= 0) {
+        ::close(m_ueventFd);
+    }
+#endif
+}
+
+void GpuProbe::start(int recheckIntervalMs)
+{
+    m_recheckTimer->start(recheckIntervalMs);
+    if (m_hasResult || m_worker) return;
+
+#ifdef Q_OS_LINUX
+    openUeventSocket();
+#endif
+    launchProbe();
+}
+
+void GpuProbe::requestProbe()
+{
+    m_debounceTimer->start();
+}
+
+void GpuProbe::launchProbe()
+{
+    if (m_worker) {
+        m_probePending = true;
+        return;
+    }
+
+    m_worker = QThread::create([this]() {
+        const GpuInfo info = detect();
+        QMetaObject::invokeMethod(this, [this, info]() { applyResult(info); }, Qt::QueuedConnection);
+    });
+    // 结果先于 finished 投递，applyResult 总是在线程清理之前执行
+    connect(m_worker, &QThread::finished, this, [this]() {
+        m_worker->deleteLater();
+        m_worker = nullptr;
+        if (m_probePending) {
+            m_probePending = false;
+            launchProbe();
+        }
+    });
+    m_worker->start(QThread::LowPriority);
+}
+
+void GpuProbe::applyResult(const GpuInfo &info)
+{
+    const bool first = !m_hasResult;
+    m_hasResult = true;
+    if (first || info != m_info) {
+        m_info = info;
+        emit gpuInfoChanged(m_info);
+    }
+}
+
+#ifdef Q_OS_LINUX
+void GpuProbe::openUeventSocket()
+{
+    // 订阅内核的设备事件广播（与 udevadm monitor --kernel 相同），不需要 root 权限；
+    // 在没有 netlink 的容器中失败时只依靠定时复查
+    m_ueventFd = ::socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_KOBJECT_UEVENT);
+    if (m_ueventFd < 0) return;
+
+    struct sockaddr_nl address;
+    memset(&address, 0, sizeof(address));
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = 1;
+    if (::bind(m_ueventFd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) < 0) {
+        ::close(m_ueventFd);
+        m_ueventFd = -1;
+        return;
+    }
+
+    m_ueventNotifier = new QSocketNotifier(m_ueventFd, QSocketNotifier::Read, this);
+    connect(m_ueventNotifier, &QSocketNotifier::activated, this, &GpuProbe::readUevents);
+}
+
+void GpuProbe::readUevents()
+{
+    // 每条消息为 "add@/devices/...\0ACTION=add\0SUBSYSTEM=drm\0..."
+    // 只关心 drm 设备的增加和移除；显示器插拔产生的 change 事件不影响 GPU 本身
+    char buffer[8192];
+    for (;;) {
+        const ssize_t length = ::recv(m_ueventFd, buffer, sizeof(buffer) - 1, 0);
+        if (length <= 0) break;
+        buffer[length] = '\0';
+
+        const bool added = strncmp(buffer, "add@", 4) == 0;
+        const bool removed = strncmp(buffer, "remove@", 7) == 0;
+        if (!added && !removed) continue;
+
+        // 连同结尾的 '\0' 一起匹配，排除 SUBSYSTEM=drm_dp_aux_dev 这类名称
+        static const char DrmSubsystem[] = "SUBSYSTEM=drm";
+        if (memmem(buffer, static_cast<size_t>(length), DrmSubsystem, sizeof(DrmSubsystem)) != nullptr) {
+            requestProbe();
+        }
+    }
+}
+#endif
@@ -0,0 +1,468 @@
+// gputelemetry.cpp
+#include "src/include/monitor/gputelemetry.h"
+#include <QDir>
+#include <QStringList>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#ifdef Q_OS_WIN
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+static const int InitialRestartDelayMs = 1000;
+static const int MaxRestartDelayMs = 60000;
+
+std::unique_ptr<GpuTelemetrySource> GpuTelemetrySource::create(const GpuInfo &info)
+{
+    if (!info.available) return nullptr;
+
+    if (info.vendor == GpuVendorNvidia) {
+        std::unique_ptr<NvmlTelemetry> nvml(new NvmlTelemetry);
+        if (nvml->open(info.pciAddress)) return nvml;
+        // 与 NVML 一样按探测到的 PCI 地址选择设备，多卡时不会固定读 0 号卡
+        return std::unique_ptr<GpuTelemetrySource>(new NvidiaSmiTelemetry(info.pciAddress));
+    }
+    if (info.vendor == GpuVendorAmd && !info.devicePath.isEmpty()) {
+        return std::unique_ptr<GpuTelemetrySource>(new AmdSysfsTelemetry(info.devicePath));
+    }
+    return nullptr;
+}
+
+NvidiaSmiTelemetry::NvidiaSmiTelemetry(const QString &device, QObject *parent)
+    : QObject(parent)
+    , m_process(nullptr)
+    , m_restartTimer(new QTimer(this))
+    , m_watchdogTimer(new QTimer(this))
+    , m_intervalMs(1000)
+    , m_device(device)
+    , m_backoffMs(InitialRestartDelayMs)
+    , m_running(false)
+{
+    m_restartTimer->setSingleShot(true);
+    m_watchdogTimer->setSingleShot(true);
+    connect(m_restartTimer, &QTimer::timeout, this, &NvidiaSmiTelemetry::launch);
+    connect(m_watchdogTimer, &QTimer::timeout, this, [this]() {
+        if (m_process) m_process->kill();
+    });
+}
+
+NvidiaSmiTelemetry::~NvidiaSmiTelemetry()
+{
+    stop();
+}
+
+QString NvidiaSmiTelemetry::program()
+{
+    const QString overridden = qEnvironmentVariable("MONITOR_NVIDIA_SMI");
+    return overridden.isEmpty() ? QStringLiteral("nvidia-smi") : overridden;
+}
+
+void NvidiaSmiTelemetry::start(int intervalMs)
+{
+    if (m_running && qMax(100, intervalMs) == m_intervalMs) return;
+    stop();
+    m_intervalMs = qMax(100, intervalMs);
+    m_backoffMs = InitialRestartDelayMs;
+    m_running = true;
+    launch();
+}
+
+void NvidiaSmiTelemetry::stop()
+{
+    m_running = false;
+    m_restartTimer->stop();
+    m_watchdogTimer->stop();
+    if (m_process) {
+        // 先断开信号，结束进程时不再触发重启
+        m_process->disconnect(this);
+        m_process->kill();
+        m_process->waitForFinished(1000);
+        delete m_process;
+        m_process = nullptr;
+    }
+    m_buffer.clear();
+    m_latest = GpuSample();
+}
+
+bool NvidiaSmiTelemetry::read(GpuSample &sample)
+{
+    sample = latest();
+    return sample.valid;
+}
+
+GpuSample NvidiaSmiTelemetry::latest() const
+{
+    // 子进程重启期间保留的旧读数不能当作当前值
+    const MonotonicNs maxAge = MonotonicClock::fromMSecs(3 * m_intervalMs + 1000);
+    if (!m_latest.valid || MonotonicClock::now() - m_latest.timestamp > maxAge) {
+        return GpuSample();
+    }
+    return m_latest;
+}
+
+void NvidiaSmiTelemetry::launch()
+{
+    if (!m_running) return;
+
+    delete m_process;
+    m_process = new QProcess(this);
+    m_buffer.clear();
+    // 错误输出不读取，直接丢弃，避免在 QProcess 内部无限累积
+    m_process->setStandardErrorFile(QProcess::nullDevice());
+    connect(m_process, &QProcess::readyReadStandardOutput, this, &NvidiaSmiTelemetry::readOutput);
+    connect(m_process, &QProcess::finished, this, &NvidiaSmiTelemetry::handleExit);
+    connect(m_process, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error) {
+        // 启动失败时不会发出 finished
+        if (error == QProcess::FailedToStart) handleExit();
+    });
+
+    QStringList arguments;
+    if (!m_device.isEmpty()) arguments << "-i" << m_device;
+    arguments << "--query-gpu=index,utilization.gpu,temperature.gpu,memory.used,memory.total"
+              << "--format=csv,noheader,nounits"
+              << "-lms" << QString::number(m_intervalMs);
+    m_process->start(program(), arguments);
+    m_watchdogTimer->start(qMax(5000, 5 * m_intervalMs));
+}
+
+void NvidiaSmiTelemetry::readOutput()
+{
+    m_buffer += m_process->readAllStandardOutput();
+
+    // 只处理完整的行，最后不完整的部分留到下一次
+    const char *begin = m_buffer.constData();
+    const char *end = begin + m_buffer.size();
+    const char *lineStart = begin;
+    for (const char *p = begin; p < end; ++p) {
+        if (*p != '\n') continue;
+        int index = -1;
+        GpuSample sample;
+        // 指定了 -i 时只会输出这一个设备，它在 nvidia-smi 中的序号不一定是 0
+        if (parseLine(lineStart, p, index, sample) && (!m_device.isEmpty() || index == 0)) {
+            sample.timestamp = MonotonicClock::now();
+            m_latest = sample;
+            m_backoffMs = InitialRestartDelayMs;
+            m_watchdogTimer->start();
+            emit sampleReady(sample);
+        }
+        lineStart = p + 1;
+    }
+
+    if (lineStart == end) {
+        m_buffer.clear();
+    } else if (end - lineStart > 4096) {
+        // 一直没有换行说明不是预期的输出，丢弃以免无限增长
+        m_buffer.clear();
+    } else {
+        m_buffer.remove(0, static_cast<int>(lineStart - begin));
+    }
+}
+
+void NvidiaSmiTelemetry::handleExit()
+{
+    m_watchdogTimer->stop();
+    if (m_running) scheduleRestart();
+}
+
+void NvidiaSmiTelemetry::scheduleRestart()
+{
+    if (m_restartTimer->isActive()) return;
+    m_restartTimer->start(m_backoffMs);
+    m_backoffMs = qMin(m_backoffMs * 2, MaxRestartDelayMs);
+}
+
+bool NvidiaSmiTelemetry::parseLine(const char *begin, const char *end, int &index, GpuSample &sample)
+{
+    // 0, 35, 61, 1234, 8192
+    if (end > begin && end[-1] == '\r') --end;
+    ProcfsTokenizer tok(begin, end);
+    quint64 gpuIndex = 0;
+    if (!tok.nextU64(gpuIndex)) return false;
+
+    double values[4] = { 0.0, 0.0, 0.0, 0.0 };
+    for (double &value : values) {
+        if (!tok.skipPast(',')) return false;
+        if (!tok.nextDouble(value)) value = 0.0;
+    }
+
+    index = static_cast<int>(gpuIndex);
+    sample.valid = true;
+    sample.usage = values[0];
+    sample.temperature = values[1];
+    sample.memoryUsed = static_cast<quint64>(values[2]) * 1024 * 1024;
+    sample.memoryTotal = static_cast<quint64>(values[3]) * 1024 * 1024;
+    return true;
+}
+
+AmdSysfsTelemetry::AmdSysfsTelemetry(const QString &devicePath)
+{
+    const QByteArray base = devicePath.toUtf8();
+    m_busyFile.setPath((base + "/gpu_busy_percent").constData());
+    m_vramUsedFile.setPath((base + "/mem_info_vram_used").constData());
+    m_vramTotalFile.setPath((base + "/mem_info_vram_total").constData());
+
+    // hwmon 编号在每次启动时可能不同，只在构造时查找一次；temp1 为 edge 温度
+    QDir hwmon(devicePath + "/hwmon");
+    const QStringList entries = hwmon.entryList(QStringList() << "hwmon*", QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
+    if (!entries.isEmpty()) {
+        m_temperatureFile.setPath(hwmon.filePath(entries.first() + "/temp1_input").toUtf8().constData());
+    }
+}
+
+static bool readSysfsValue(ProcfsFile &file, quint64 &value)
+{
+    if (file.path().empty() || !file.refresh()) return false;
+    ProcfsTokenizer tok(file);
+    return tok.nextU64(value);
+}
+
+bool AmdSysfsTelemetry::read(GpuSample &sample)
+{
+    sample = GpuSample();
+    quint64 busy = 0;
+    if (!readSysfsValue(m_busyFile, busy)) return false;
+
+    quint64 value = 0;
+    sample.valid = true;
+    sample.usage = static_cast<double>(busy);
+    if (readSysfsValue(m_vramUsedFile, value)) sample.memoryUsed = value;
+    if (readSysfsValue(m_vramTotalFile, value)) sample.memoryTotal = value;
+    if (readSysfsValue(m_temperatureFile, value)) sample.temperature = value / 1000.0;
+    sample.timestamp = MonotonicClock::now();
+    return true;
+}
+
+// NVML 中用到的类型和函数按 nvml.h 的 ABI 声明，编译时不需要 CUDA 开发包
+typedef int nvmlReturn_t;
+typedef struct nvmlDevice_st *nvmlDevice_t;
+
+struct nvmlUtilization_t {
+    unsigned int gpu;
+    unsigned int memory;
+};
+
+struct nvmlMemory_t {
+    unsigned long long total;
+    unsigned long long free;
+    unsigned long long used;
+};
+
+// 进程信息的各个版本只在末尾追加字段，pid 和 usedGpuMemory 的偏移不变
+struct nvmlProcessInfo_v1_t {
+    unsigned int pid;
+    unsigned long long usedGpuMemory;
+};
+
+// _v2 和 _v3 查询都填这个布局（nvml.h 中的 nvmlProcessInfo_t，24 字节）；
+// 带 usedGpuCcProtectedMemory 的 nvmlProcessDetail_v1_t 只属于 nvmlDeviceGetRunningProcessDetailList
+struct nvmlProcessInfo_v2_t {
+    unsigned int pid;
+    unsigned long long usedGpuMemory;
+    unsigned int gpuInstanceId;
+    unsigned int computeInstanceId;
+};
+
+static const nvmlReturn_t NVML_SUCCESS = 0;
+static const nvmlReturn_t NVML_ERROR_INSUFFICIENT_SIZE = 7;
+static const unsigned int NVML_TEMPERATURE_GPU = 0;
+static const unsigned long long NVML_VALUE_NOT_AVAILABLE = ~0ULL;
+
+typedef nvmlReturn_t (*NvmlProcessQuery)(nvmlDevice_t, unsigned int *, void *);
+
+#ifdef Q_OS_WIN
+static void *loadLibrary(const char *path) { return reinterpret_cast<void *>(LoadLibraryA(path)); }
+static void *resolveSymbol(void *library, const char *symbol)
+{
+    return reinterpret_cast<void *>(GetProcAddress(static_cast<HMODULE>(library), symbol));
+}
+static void unloadLibrary(void *library) { FreeLibrary(static_cast<HMODULE>(library)); }
+#else
+static void *loadLibrary(const char *path) { return dlopen(path, RTLD_NOW | RTLD_LOCAL); }
+static void *resolveSymbol(void *library, const char *symbol) { return dlsym(library, symbol); }
+static void unloadLibrary(void *library) { dlclose(library); }
+#endif
+
+template <typename Function>
+static bool resolve(void *library, const char *symbol, Function &function)
+{
+    function = reinterpret_cast<Function>(resolveSymbol(library, symbol));
+    return function != nullptr;
+}
+
+struct NvmlLibrary {
+    void *library = nullptr;
+    bool initialized = false;
+    nvmlDevice_t device = nullptr;
+
+    nvmlReturn_t (*shutdown)() = nullptr;
+    nvmlReturn_t (*getUtilizationRates)(nvmlDevice_t, nvmlUtilization_t *) = nullptr;
+    nvmlReturn_t (*getMemoryInfo)(nvmlDevice_t, nvmlMemory_t *) = nullptr;
+    nvmlReturn_t (*getTemperature)(nvmlDevice_t, unsigned int, unsigned int *) = nullptr;
+    nvmlReturn_t (*getPowerUsage)(nvmlDevice_t, unsigned int *) = nullptr;     // 可选，部分消费级显卡不支持
+    NvmlProcessQuery getComputeProcesses = nullptr;                            // 可选
+    NvmlProcessQuery getGraphicsProcesses = nullptr;
+    size_t processInfoSize = sizeof(nvmlProcessInfo_v1_t);
+    std::vector<unsigned char> processBuffer;    // 两次查询共用，只在进程数超过容量时扩大
+
+    ~NvmlLibrary()
+    {
+        if (initialized) shutdown();
+        if (library) unloadLibrary(library);
+    }
+};
+
+NvmlTelemetry::NvmlTelemetry()
+{
+}
+
+NvmlTelemetry::~NvmlTelemetry()
+{
+}
+
+QByteArray NvmlTelemetry::libraryPath()
+{
+    const QByteArray overridden = qgetenv("MONITOR_NVML_LIBRARY");
+    if (!overridden.isEmpty()) return overridden;
+#ifdef Q_OS_WIN
+    return QByteArrayLiteral("nvml.dll");
+#else
+    return QByteArrayLiteral("libnvidia-ml.so.1");
+#endif
+}
+
+bool NvmlTelemetry::open(const QString &pciAddress)
+{
+    close();
+
+    std::unique_ptr<NvmlLibrary> nvml(new NvmlLibrary);
+    nvml->library = loadLibrary(libraryPath().constData());
+    if (!nvml->library) return false;
+
+    nvmlReturn_t (*init)() = nullptr;
+    nvmlReturn_t (*getHandleByIndex)(unsigned int, nvmlDevice_t *) = nullptr;
+    nvmlReturn_t (*getHandleByPciBusId)(const char *, nvmlDevice_t *) = nullptr;
+    if (!resolve(nvml->library, "nvmlInit_v2", init)
+        || !resolve(nvml->library, "nvmlShutdown", nvml->shutdown)
+        || !resolve(nvml->library, "nvmlDeviceGetHandleByIndex_v2", getHandleByIndex)
+        || !resolve(nvml->library, "nvmlDeviceGetUtilizationRates", nvml->getUtilizationRates)
+        || !resolve(nvml->library, "nvmlDeviceGetMemoryInfo", nvml->getMemoryInfo)
+        || !resolve(nvml->library, "nvmlDeviceGetTemperature", nvml->getTemperature)) {
+        return false;
+    }
+    resolve(nvml->library, "nvmlDeviceGetPowerUsage", nvml->getPowerUsage);
+    resolve(nvml->library, "nvmlDeviceGetHandleByPciBusId_v2", getHandleByPciBusId);
+
+    // 进程查询按新到旧尝试；不带版本号的符号是最早的 v1 布局
+    if (resolve(nvml->library, "nvmlDeviceGetComputeRunningProcesses_v3", nvml->getComputeProcesses)
+        && resolve(nvml->library, "nvmlDeviceGetGraphicsRunningProcesses_v3", nvml->getGraphicsProcesses)) {
+        nvml->processInfoSize = sizeof(nvmlProcessInfo_v2_t);
+    } else if (resolve(nvml->library, "nvmlDeviceGetComputeRunningProcesses_v2", nvml->getComputeProcesses)
+        && resolve(nvml->library, "nvmlDeviceGetGraphicsRunningProcesses_v2", nvml->getGraphicsProcesses)) {
+        nvml->processInfoSize = sizeof(nvmlProcessInfo_v2_t);
+    } else {
+        resolve(nvml->library, "nvmlDeviceGetComputeRunningProcesses", nvml->getComputeProcesses);
+        resolve(nvml->library, "nvmlDeviceGetGraphicsRunningProcesses", nvml->getGraphicsProcesses);
+        nvml->processInfoSize = sizeof(nvmlProcessInfo_v1_t);
+    }
+    nvml->processBuffer.resize(32 * nvml->processInfoSize);
+
+    if (init() != NVML_SUCCESS) return false;
+    nvml->initialized = true;
+
+    // 探测结果带有 PCI 地址时按地址取设备，多卡时与界面上显示的名称一致
+    const QByteArray busId = pciAddress.toLatin1();
+    if (busId.isEmpty() || !getHandleByPciBusId
+        || getHandleByPciBusId(busId.constData(), &nvml->device) != NVML_SUCCESS) {
+        if (getHandleByIndex(0, &nvml->device) != NVML_SUCCESS) return false;
+    }
+
+    m_nvml = std::move(nvml);
+    return true;
+}
+
+void NvmlTelemetry::close()
+{
+    m_nvml.reset();
+}
+
+static void appendProcesses(NvmlLibrary &nvml, NvmlProcessQuery query, QVector<GpuProcessMemory> &processes)
+{
+    if (!query) return;
+
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        unsigned int count = static_cast<unsigned int>(nvml.processBuffer.size() / nvml.processInfoSize);
+        const nvmlReturn_t result = query(nvml.device, &count, nvml.processBuffer.data());
+        if (result == NVML_ERROR_INSUFFICIENT_SIZE) {
+            // count 为实际需要的条目数，多留一些余量应对两次调用之间新启动的进程
+            nvml.processBuffer.resize((count + 8) * nvml.processInfoSize);
+            continue;
+        }
+        if (result != NVML_SUCCESS) return;
+
+        for (unsigned int i = 0; i < count; ++i) {
+            const unsigned char *entry = nvml.processBuffer.data() + i * nvml.processInfoSize;
+            unsigned int pid = 0;
+            unsigned long long used = 0;
+            std::memcpy(&pid, entry + offsetof(nvmlProcessInfo_v1_t, pid), sizeof(pid));
+            std::memcpy(&used, entry + offsetof(nvmlProcessInfo_v1_t, usedGpuMemory), sizeof(used));
+            if (used == NVML_VALUE_NOT_AVAILABLE) used = 0;
+
+            // 同一个进程可能同时出现在计算和图形两个列表中，显存是同一份，取较大值
+            bool merged = false;
+            for (GpuProcessMemory &process : processes) {
+                if (process.pid == pid) {
+                    process.memoryUsed = qMax(process.memoryUsed, static_cast<quint64>(used));
+                    merged = true;
+                    break;
+                }
+            }
+            if (!merged) {
+                GpuProcessMemory process;
+                process.pid = pid;
+                process.memoryUsed = used;
+                processes.append(process);
+            }
+        }
+        return;
+    }
+}
+
+bool NvmlTelemetry::read(GpuSample &sample)
+{
+    sample = GpuSample();
+    if (!m_nvml) return false;
+    NvmlLibrary &nvml = *m_nvml;
+
+    // 利用率读取失败说明设备已不可用（GPU 掉卡、驱动重载）；其余字段各自失败时按 0 处理
+    nvmlUtilization_t utilization;
+    if (nvml.getUtilizationRates(nvml.device, &utilization) != NVML_SUCCESS) return false;
+    sample.valid = true;
+    sample.usage = utilization.gpu;
+
+    nvmlMemory_t memory;
+    if (nvml.getMemoryInfo(nvml.device, &memory) == NVML_SUCCESS) {
+        sample.memoryUsed = memory.used;
+        sample.memoryTotal = memory.total;
+    }
+
+    unsigned int temperature = 0;
+    if (nvml.getTemperature(nvml.device, NVML_TEMPERATURE_GPU, &temperature) == NVML_SUCCESS) {
+        sample.temperature = temperature;
+    }
+
+    unsigned int milliwatts = 0;
+    if (nvml.getPowerUsage && nvml.getPowerUsage(nvml.device, &milliwatts) == NVML_SUCCESS) {
+        sample.power = milliwatts / 1000.0;
+    }
+
+    appendProcesses(nvml, nvml.getComputeProcesses, sample.processes);
+    appendProcesses(nvml, nvml.getGraphicsProcesses, sample.processes);
+    std::sort(sample.processes.begin(), sample.processes.end(),
+              [](const GpuProcessMemory &a, const GpuProcessMemory &b) { return a.memoryUsed > b.memoryUsed; });
+
+    sample.timestamp = MonotonicClock::now();
+    return true;
+}
@@ -3,11 +3,16 @@
 #ifdef Q_OS_WIN
 #include <windows.h>
 #elif defined(Q_OS_LINUX)
-#include <fstream>
-#include <string>
+#include <cstring>
 #endif
 
-MemoryMonitor::MemoryMonitor(QObject *parent) : QObject(parent) {
+MemoryMonitor::MemoryMonitor(QObject *parent)
+    : QObject(parent)
+#ifdef Q_OS_LINUX
+    , m_meminfoFile("/proc/meminfo")
+    , m_vmstatFile("/proc/vmstat", 8192)
+#endif
+{
 #ifdef Q_OS_WIN
     // 初始化内存状态结构
     memoryStatus.dwLength = sizeof(MEMORYSTATUSEX);
@@ -23,21 +28,10 @@ double MemoryMonitor::getMemoryUsage() const {
     }
     return 0.0;
 #elif defined(Q_OS_LINUX)
-    std::ifstream file("/proc/meminfo");
-    std::string line;
-    long totalMem = 0, freeMem = 0, buffers = 0, cached = 0;
-    while (std::getline(file, line)) {
-        if (line.find("MemTotal:") == 0)
-            sscanf(line.c_str(), "MemTotal: %ld kB", &totalMem);
-        else if (line.find("MemFree:") == 0)
-            sscanf(line.c_str(), "MemFree: %ld kB", &freeMem);
-        else if (line.find("Buffers:") == 0)
-            sscanf(line.c_str(), "Buffers: %ld kB", &buffers);
-        else if (line.find("Cached:") == 0)
-            sscanf(line.c_str(), "Cached: %ld kB", &cached);
-    }
-    long used = totalMem - freeMem - buffers - cached;
-    if (totalMem == 0) return 0.0;
+    quint64 totalMem = 0, freeMem = 0, buffers = 0, cached = 0;
+    if (!readMeminfo(totalMem, freeMem, buffers, cached) || totalMem == 0) return 0.0;
+    quint64 reclaimable = freeMem + buffers + cached;
+    quint64 used = totalMem > reclaimable ? totalMem - reclaimable : 0;
     return used * 100.0 / totalMem;
 #endif
 }
@@ -51,16 +45,9 @@ quint64 MemoryMonitor::getTotalMemory() const {
     }
     return 0;
 #elif defined(Q_OS_LINUX)
-    std::ifstream file("/proc/meminfo");
-    std::string line;
-    long totalMem = 0;
-    while (std::getline(file, line)) {
-        if (line.find("MemTotal:") == 0) {
-            sscanf(line.c_str(), "MemTotal: %ld kB", &totalMem);
-            break;
-        }
-    }
-    return static_cast<quint64>(totalMem) * 1024; // 转换为字节
+    quint64 totalMem = 0, freeMem = 0, buffers = 0, cached = 0;
+    readMeminfo(totalMem, freeMem, buffers, cached);
+    return totalMem * 1024; // 转换为字节
 #endif
 }
 
@@ -73,20 +60,115 @@ quint64 MemoryMonitor::getUsedMemory() const {
     }
     return 0;
 #elif defined(Q_OS_LINUX)
-    std::ifstream file("/proc/meminfo");
-    std::string line;
-    long totalMem = 0, freeMem = 0, buffers = 0, cached = 0;
-    while (std::getline(file, line)) {
-        if (line.find("MemTotal:") == 0)
-            sscanf(line.c_str(), "MemTotal: %ld kB", &totalMem);
-        else if (line.find("MemFree:") == 0)
-            sscanf(line.c_str(), "MemFree: %ld kB", &freeMem);
-        else if (line.find("Buffers:") == 0)
-            sscanf(line.c_str(), "Buffers: %ld kB", &buffers);
-        else if (line.find("Cached:") == 0)
-            sscanf(line.c_str(), "Cached: %ld kB", &cached);
+    quint64 totalMem = 0, freeMem = 0, buffers = 0, cached = 0;
+    readMeminfo(totalMem, freeMem, buffers, cached);
+    quint64 reclaimable = freeMem + buffers + cached;
+    quint64 used = totalMem > reclaimable ? totalMem - reclaimable : 0;
+    return used * 1024; // 转换为字节
+#endif
+}
+
+bool MemoryMonitor::getMemoryStats(quint64 &total, quint64 &used) const {
+#ifdef Q_OS_WIN
+    MEMORYSTATUSEX memStatus;
+    memStatus.dwLength = sizeof(memStatus);
+    if (GlobalMemoryStatusEx(&memStatus)) {
+        total = memStatus.ullTotalPhys;
+        used = memStatus.ullTotalPhys - memStatus.ullAvailPhys;
+        return true;
+    }
+#elif defined(Q_OS_LINUX)
+    quint64 totalMem = 0, freeMem = 0, buffers = 0, cached = 0;
+    if (readMeminfo(totalMem, freeMem, buffers, cached)) {
+        quint64 reclaimable = freeMem + buffers + cached;
+        total = totalMem * 1024;
+        used = totalMem > reclaimable ? (totalMem - reclaimable) * 1024 : 0;
+        return true;
     }
-    long used = totalMem - freeMem - buffers - cached;
-    return static_cast<quint64>(used) * 1024; // 转换为字节
 #endif
+    total = used = 0;
+    return false;
 }
+
+bool MemoryMonitor::getVmstatRates(VmstatRates &rates) const {
+    rates = VmstatRates();
+#ifdef Q_OS_LINUX
+    if (!m_vmstatFile.refresh()) return false;
+    const MonotonicNs now = MonotonicClock::now();
+
+    // 回收计数在不同内核版本中拆分方式不同（按 zone、按 kswapd / direct / khugepaged / proactive），
+    // 把除 _anon / _file（另一种拆分）和 pgscan_direct_throttle（次数而非页数）以外的 pgscan_* 和 pgsteal_* 全部加起来
+    quint64 totals[VmstatCounterCount] = {};
+    ProcfsTokenizer tok(m_vmstatFile);
+    do {
+        const char *key;
+        size_t length;
+        quint64 value = 0;
+        if (!tok.nextWord(key, length) || !tok.nextU64(value)) continue;
+
+        if (ProcfsTokenizer::equals(key, length, "pgmajfault")) {
+            totals[VmstatMajorFaults] = value;
+        } else if (ProcfsTokenizer::equals(key, length, "pswpin")) {
+            totals[VmstatSwapIns] = value;
+        } else if (ProcfsTokenizer::equals(key, length, "pswpout")) {
+            totals[VmstatSwapOuts] = value;
+        } else if (ProcfsTokenizer::equals(key, length, "compact_stall")) {
+            totals[VmstatCompactStalls] = value;
+        } else if (ProcfsTokenizer::equals(key, length, "oom_kill")) {
+            totals[VmstatOomKills] = value;
+        } else if (length > 7 && key[0] == 'p' && key[1] == 'g' && key[2] == 's') {
+            const bool scan = length > 7 && memcmp(key, "pgscan_", 7) == 0;
+            const bool steal = length > 8 && memcmp(key, "pgsteal_", 8) == 0;
+            if (!scan && !steal) continue;
+            const char *suffix = key + (scan ? 7 : 8);
+            const size_t suffixLength = length - (scan ? 7 : 8);
+            if (ProcfsTokenizer::equals(suffix, suffixLength, "anon") || ProcfsTokenizer::equals(suffix, suffixLength, "file")
+                || ProcfsTokenizer::equals(suffix, suffixLength, "direct_throttle")) continue;
+            totals[scan ? VmstatScanned : VmstatStolen] += value;
+            if (scan && suffixLength >= 6 && memcmp(suffix, "direct", 6) == 0) totals[VmstatDirectScanned] += value;
+        }
+    } while (tok.nextLine());
+
+    double values[VmstatCounterCount];
+    for (int i = 0; i < VmstatCounterCount; ++i) {
+        values[i] = m_vmstatRates[i].update(totals[i], now);
+    }
+    rates.valid = true;
+    rates.majorFaults = values[VmstatMajorFaults];
+    rates.swapIns = values[VmstatSwapIns];
+    rates.swapOuts = values[VmstatSwapOuts];
+    rates.pagesScanned = values[VmstatScanned];
+    rates.pagesStolen = values[VmstatStolen];
+    rates.directScanned = values[VmstatDirectScanned];
+    rates.compactStalls = values[VmstatCompactStalls];
+    rates.oomKills = values[VmstatOomKills];
+    rates.oomKillTotal = totals[VmstatOomKills];
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef Q_OS_LINUX
+bool MemoryMonitor::readMeminfo(quint64 &totalKb, quint64 &freeKb, quint64 &buffersKb, quint64 &cachedKb) const {
+    totalKb = freeKb = buffersKb = cachedKb = 0;
+    if (!m_meminfoFile.refresh()) return false;
+
+    ProcfsTokenizer tok(m_meminfoFile);
+    int found = 0;
+    do {
+        const char *key;
+        size_t length;
+        if (!tok.nextWord(key, length)) continue;
+
+        quint64 *target = nullptr;
+        if (ProcfsTokenizer::equals(key, length, "MemTotal")) target = &totalKb;
+        else if (ProcfsTokenizer::equals(key, length, "MemFree")) target = &freeKb;
+        else if (ProcfsTokenizer::equals(key, length, "Buffers")) target = &buffersKb;
+        else if (ProcfsTokenizer::equals(key, length, "Cached")) target = &cachedKb;
+
+        if (target && tok.nextU64(*target) && ++found == 4) break;
+    } while (tok.nextLine());
+    return totalKb > 0;
+}
+#endif
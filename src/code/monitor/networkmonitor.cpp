@@ -6,17 +6,34 @@
 #pragma comment(lib, "iphlpapi.lib")
 #endif
 #elif defined(Q_OS_LINUX)
-#include <fstream>
-#include <sstream>
+#include <net/if.h>
+#include <unistd.h>
 #endif
 
-NetworkMonitor::NetworkMonitor(QObject *parent) : QObject(parent) {
-    lastRecvBytes = lastSentBytes = 0;
+NetworkMonitor::NetworkMonitor(QObject *parent)
+    : QObject(parent)
+#ifdef Q_OS_LINUX
+    , m_netDevFile("/proc/net/dev")
+    , m_generation(0)
+#endif
+#ifdef Q_OS_WIN
+    , m_recvRates(32) // MIB_IFROW 的字节计数器只有 32 位
+    , m_sentRates(32)
+#endif
+{
 }
 
 double NetworkMonitor::getNetworkUsage() const {
     QPair<quint64, quint64> usage = getNetworkUsageDetailed();
-    return static_cast<double>(usage.first + usage.second) / (1024.0 * 1024.0); // MB
+    return static_cast<double>(usage.first + usage.second) / (1024.0 * 1024.0); // MB/s
+}
+
+QVector<ProcessNetworkStats> NetworkMonitor::getProcessNetworkStats() const {
+#ifdef Q_OS_LINUX
+    if (!m_socketDiag) m_socketDiag.reset(new SocketDiagCollector);
+    if (m_socketDiag->refresh()) return m_socketDiag->processStats();
+#endif
+    return QVector<ProcessNetworkStats>();
 }
 
 QPair<quint64, quint64> NetworkMonitor::getNetworkUsageDetailed() const {
@@ -31,7 +48,8 @@ QPair<quint64, quint64> NetworkMonitor::getNetworkUsageDetailed() const {
     }
     
     if (GetIfTable(pIfTable, &dwSize, TRUE) == NO_ERROR) {
-        quint64 totalRecv = 0, totalSent = 0;
+        const MonotonicNs now = MonotonicClock::now();
+        double recvRate = 0.0, sentRate = 0.0;
         
         // 获取活跃网络接口
         DWORD activeInterface = getActiveNetworkInterface();
@@ -40,8 +58,9 @@ QPair<quint64, quint64> NetworkMonitor::getNetworkUsageDetailed() const {
         if (activeInterface != 0) {
             for (DWORD i = 0; i < pIfTable->dwNumEntries; i++) {
                 if (pIfTable->table[i].dwIndex == activeInterface) {
-                    totalRecv = pIfTable->table[i].dwInOctets;
-                    totalSent = pIfTable->table[i].dwOutOctets;
+                    QByteArray key = QByteArray::number(static_cast<uint>(pIfTable->table[i].dwIndex));
+                    recvRate = m_recvRates.update(key, pIfTable->table[i].dwInOctets, now);
+                    sentRate = m_sentRates.update(key, pIfTable->table[i].dwOutOctets, now);
                     break;
                 }
             }
@@ -49,51 +68,83 @@ QPair<quint64, quint64> NetworkMonitor::getNetworkUsageDetailed() const {
             // 如果没有找到活跃接口，统计所有非回环接口的流量
             for (DWORD i = 0; i < pIfTable->dwNumEntries; i++) {
                 if (pIfTable->table[i].dwType != IF_TYPE_SOFTWARE_LOOPBACK) {
-                    totalRecv += pIfTable->table[i].dwInOctets;
-                    totalSent += pIfTable->table[i].dwOutOctets;
+                    QByteArray key = QByteArray::number(static_cast<uint>(pIfTable->table[i].dwIndex));
+                    recvRate += m_recvRates.update(key, pIfTable->table[i].dwInOctets, now);
+                    sentRate += m_sentRates.update(key, pIfTable->table[i].dwOutOctets, now);
                 }
             }
         }
         
         free(pIfTable);
+        m_recvRates.sweep();
+        m_sentRates.sweep();
         
-        quint64 diffRecv = totalRecv - lastRecvBytes;
-        quint64 diffSent = totalSent - lastSentBytes;
-        lastRecvBytes = totalRecv;
-        lastSentBytes = totalSent;
-        return QPair<quint64, quint64>(diffSent, diffRecv); // 返回上传和下载速率
+        return QPair<quint64, quint64>(static_cast<quint64>(sentRate), static_cast<quint64>(recvRate)); // 返回上传和下载速率
     }
     free(pIfTable);
     return QPair<quint64, quint64>(0, 0);
 #elif defined(Q_OS_LINUX)
-    std::ifstream file("/proc/net/dev");
-    std::string line;
-    quint64 totalRecv = 0, totalSent = 0;
-    int lineNum = 0;
-    while (std::getline(file, line)) {
-        lineNum++;
-        if (lineNum <= 2) continue; // 跳过标题行
+    if (!m_netDevFile.refresh()) return QPair<quint64, quint64>(0, 0);
 
-        std::istringstream iss(line);
-        std::string iface;
-        quint64 recvBytes = 0, sentBytes = 0;
+    const MonotonicNs now = MonotonicClock::now();
+    ProcfsTokenizer tok(m_netDevFile);
+    QVector<NetworkInterfaceStats> stats;
+    stats.reserve(m_interfaceStats.size());
+    double recvRate = 0.0, sentRate = 0.0;
+    double allRecvRate = 0.0, allSentRate = 0.0;
+    bool hasPhysical = false;
+    tok.nextLine(); // 跳过两行标题
+    while (tok.nextLine()) {
+        // "  eth0: rx_bytes rx_packets rx_errs rx_drop rx_fifo rx_frame rx_compressed rx_multicast tx_bytes ..."
+        const char *name;
+        size_t nameLength;
+        quint64 f[NetDevFieldCount];
+        if (!tok.nextWord(name, nameLength)) continue;
+        int n = 0;
+        while (n < NetDevFieldCount && tok.nextU64(f[n])) ++n;
+        if (n < NetDevFieldCount) continue;
 
-        iss >> iface;
-        iface = iface.substr(0, iface.find(':'));
-        iss >> recvBytes;
-        for (int i = 0; i < 7; ++i) iss >> std::ws >> sentBytes; // Skip to transmitted bytes
+        Interface &iface = networkInterface(name, nameLength);
+        double rate[NetDevFieldCount];
+        for (int i = 0; i < NetDevFieldCount; ++i) {
+            rate[i] = iface.rates[i].update(f[i], now);
+        }
+
+        NetworkInterfaceStats s;
+        s.name = QString::fromLatin1(name, static_cast<int>(nameLength));
+        s.isVirtual = iface.isVirtual;
+        s.rxBytesPerSec = rate[RxBytes];
+        s.txBytesPerSec = rate[TxBytes];
+        s.rxPacketsPerSec = rate[RxPackets];
+        s.txPacketsPerSec = rate[TxPackets];
+        s.rxErrorsPerSec = rate[RxErrors];
+        s.txErrorsPerSec = rate[TxErrors];
+        s.rxDropsPerSec = rate[RxDrops];
+        s.txDropsPerSec = rate[TxDrops];
+        s.rxBytesTotal = f[RxBytes];
+        s.txBytesTotal = f[TxBytes];
+        stats.append(s);
 
-        if (iface != "lo") {
-            totalRecv += recvBytes;
-            totalSent += sentBytes;
+        // 逐接口计算速率再求和，接口增减不会让总和出现跳变
+        if (!iface.isVirtual) {
+            hasPhysical = true;
+            recvRate += rate[RxBytes];
+            sentRate += rate[TxBytes];
+        }
+        if (!ProcfsTokenizer::equals(name, nameLength, "lo")) {
+            allRecvRate += rate[RxBytes];
+            allSentRate += rate[TxBytes];
         }
     }
-    quint64 diffRecv = totalRecv - lastRecvBytes;
-    quint64 diffSent = totalSent - lastSentBytes;
-    lastRecvBytes = totalRecv;
-    lastSentBytes = totalSent;
+    sweepInterfaces();
+    m_interfaceStats.swap(stats);
 
-    return QPair<quint64, quint64>(diffSent, diffRecv); // 返回上传和下载速率
+    // 容器内通常只有 veth，此时退回到统计除 lo 外的全部接口
+    if (!hasPhysical) {
+        recvRate = allRecvRate;
+        sentRate = allSentRate;
+    }
+    return QPair<quint64, quint64>(static_cast<quint64>(sentRate), static_cast<quint64>(recvRate)); // 返回上传和下载速率
 #endif
     return QPair<quint64, quint64>(0, 0);
 }
@@ -136,8 +187,49 @@ DWORD NetworkMonitor::getActiveNetworkInterface() const {
     free(pIfTable);
     return 0; // 如果没有找到活跃接口，返回0
 }
+#elif defined(Q_OS_LINUX)
+unsigned long NetworkMonitor::getActiveNetworkInterface() const {
+    // 使用最近一次采样的结果，不重新读取 /proc/net/dev（否则会移动速率基线）
+    const NetworkInterfaceStats *active = nullptr;
+    for (const NetworkInterfaceStats &s : m_interfaceStats) {
+        if (s.isVirtual) continue;
+        if (!active || s.rxBytesPerSec + s.txBytesPerSec > active->rxBytesPerSec + active->txBytesPerSec
+            || (s.rxBytesPerSec + s.txBytesPerSec == active->rxBytesPerSec + active->txBytesPerSec
+                && s.rxBytesTotal + s.txBytesTotal > active->rxBytesTotal + active->txBytesTotal)) {
+            active = &s;
+        }
+    }
+    return active ? if_nametoindex(active->name.toLatin1().constData()) : 0;
+}
+
+NetworkMonitor::Interface &NetworkMonitor::networkInterface(const char *name, size_t length) const {
+    const QByteArray lookup = QByteArray::fromRawData(name, static_cast<int>(length));
+    QHash<QByteArray, Interface>::iterator it = m_interfaces.find(lookup);
+    if (it == m_interfaces.end()) {
+        // 物理网卡（包括 virtio 等虚拟机网卡）在 /sys/class/net/<if>/device 下有对应的设备，
+        // lo、veth、网桥、bond、tun/tap、wireguard 等纯软件接口没有
+        const QByteArray key(name, static_cast<int>(length));
+        Interface iface;
+        iface.generation = m_generation;
+        iface.isVirtual = key == "lo" || access(("/sys/class/net/" + key + "/device").constData(), F_OK) != 0;
+        it = m_interfaces.insert(key, iface);
+    }
+    it->generation = m_generation;
+    return *it;
+}
+
+void NetworkMonitor::sweepInterfaces() const {
+    for (QHash<QByteArray, Interface>::iterator it = m_interfaces.begin(); it != m_interfaces.end();) {
+        if (it->generation != m_generation) {
+            it = m_interfaces.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    ++m_generation;
+}
 #else
 unsigned long NetworkMonitor::getActiveNetworkInterface() const {
-    return 0; // 非Windows平台暂不支持此功能
+    return 0; // 其他平台暂不支持此功能
 }
 #endif
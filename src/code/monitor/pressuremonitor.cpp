@@ -0,0 +1,158 @@
+// pressuremonitor.cpp
+#include "src/include/monitor/pressuremonitor.h"
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#endif
+
+#ifdef Q_OS_LINUX
+static const char *const PressureFileNames[PressureResourceCount] = { "cpu", "memory", "io" };
+
+PressureMonitor::PressureMonitor(const QString &cgroupPath)
+    : m_cgroup(!cgroupPath.isEmpty())
+{
+    if (m_cgroup) {
+        m_directory = "/sys/fs/cgroup/" + std::string(cgroupPath.toUtf8().constData());
+        if (m_directory.back() != '/') m_directory += '/';
+    } else {
+        m_directory = "/proc/pressure/";
+    }
+    for (int i = 0; i < PressureResourceCount; ++i) {
+        m_files[i].setPath(resourcePath(i).c_str());
+    }
+}
+
+PressureMonitor::~PressureMonitor()
+{
+    clearTriggers();
+}
+
+std::string PressureMonitor::resourcePath(int resource) const
+{
+    // 整机为 /proc/pressure/cpu，cgroup 为 <dir>/cpu.pressure
+    std::string path = m_directory + PressureFileNames[resource];
+    if (m_cgroup) path += ".pressure";
+    return path;
+}
+
+bool PressureMonitor::isAvailable() const
+{
+    for (int i = 0; i < PressureResourceCount; ++i) {
+        if (m_stats[i].valid) return true;
+    }
+    return access(resourcePath(PressureMemory).c_str(), R_OK) == 0;
+}
+
+bool PressureMonitor::refresh()
+{
+    const MonotonicNs now = MonotonicClock::now();
+    bool any = false;
+    for (int i = 0; i < PressureResourceCount; ++i) {
+        any |= readResource(i, now);
+    }
+    return any;
+}
+
+bool PressureMonitor::readResource(int resource, MonotonicNs now)
+{
+    PressureStats &stats = m_stats[resource];
+    if (!m_files[resource].refresh()) {
+        stats = PressureStats();
+        return false;
+    }
+
+    // some avg10=0.00 avg60=0.00 avg300=0.00 total=0
+    // full avg10=0.00 avg60=0.00 avg300=0.00 total=0
+    ProcfsTokenizer tok(m_files[resource]);
+    bool hasSome = false;
+    do {
+        const char *kind;
+        size_t kindLength;
+        if (!tok.nextWord(kind, kindLength)) continue;
+        const bool some = ProcfsTokenizer::equals(kind, kindLength, "some");
+        if (!some && !ProcfsTokenizer::equals(kind, kindLength, "full")) continue;
+
+        double avg10 = 0.0, avg60 = 0.0;
+        quint64 total = 0;
+        if (!tok.skipPast('=') || !tok.nextDouble(avg10)) continue;
+        if (!tok.skipPast('=') || !tok.nextDouble(avg60)) continue;
+        if (!tok.skipPast('=') || !tok.skipPast('=') || !tok.nextU64(total)) continue; // 跳过 avg300
+
+        // 每秒停顿的微秒数 / 10^4 = 停顿时间占比 (%)
+        if (some) {
+            stats.someAvg10 = avg10;
+            stats.someAvg60 = avg60;
+            stats.someTotalUs = total;
+            stats.someStallPercent = m_someRates[resource].update(total, now) / 1e4;
+            hasSome = true;
+        } else {
+            stats.fullAvg10 = avg10;
+            stats.fullAvg60 = avg60;
+            stats.fullTotalUs = total;
+            stats.fullStallPercent = m_fullRates[resource].update(total, now) / 1e4;
+        }
+    } while (tok.nextLine());
+    stats.valid = hasSome;
+    return hasSome;
+}
+
+int PressureMonitor::addTrigger(PressureResource resource, bool full, int stallMs, int windowMs)
+{
+    // 每个触发器需要单独打开一次压力文件，写入阈值后该 fd 只用于 poll
+    const int fd = ::open(resourcePath(resource).c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) return -1;
+
+    char spec[64];
+    const int length = snprintf(spec, sizeof(spec), "%s %lld %lld", full ? "full" : "some",
+                                static_cast<long long>(stallMs) * 1000, static_cast<long long>(windowMs) * 1000);
+    // 内核要求写入内容包含结尾的 '\0'
+    if (::write(fd, spec, static_cast<size_t>(length) + 1) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    m_triggerFds.push_back(fd);
+    return fd;
+}
+
+void PressureMonitor::clearTriggers()
+{
+    for (int fd : m_triggerFds) {
+        ::close(fd);
+    }
+    m_triggerFds.clear();
+}
+#else
+PressureMonitor::PressureMonitor(const QString &cgroupPath)
+{
+    Q_UNUSED(cgroupPath);
+}
+
+PressureMonitor::~PressureMonitor()
+{
+}
+
+bool PressureMonitor::isAvailable() const
+{
+    return false;
+}
+
+bool PressureMonitor::refresh()
+{
+    return false;
+}
+
+int PressureMonitor::addTrigger(PressureResource resource, bool full, int stallMs, int windowMs)
+{
+    Q_UNUSED(resource);
+    Q_UNUSED(full);
+    Q_UNUSED(stallMs);
+    Q_UNUSED(windowMs);
+    return -1;
+}
+
+void PressureMonitor::clearTriggers()
+{
+}
+#endif
@@ -0,0 +1,152 @@
+// processeventsource.cpp
+#include "src/include/monitor/processeventsource.h"
+#include <QSocketNotifier>
+#ifdef Q_OS_LINUX
+#include <linux/cn_proc.h>
+#include <linux/connector.h>
+#include <linux/netlink.h>
+#include <sys/socket.h>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+// uapi 6.6 起事件类型放在文件作用域的 enum proc_cn_event 中（同时新增了 PROC_EVENT_ALL），
+// 更早的头文件里是 struct proc_event 的嵌套枚举，C++ 中必须带结构体名限定
+#ifdef PROC_EVENT_ALL
+#define PROC_EVENT_TYPE(name) name
+#else
+#define PROC_EVENT_TYPE(name) proc_event::name
+#endif
+#endif
+
+ProcessEventSource::ProcessEventSource(QObject *parent)
+    : QObject(parent)
+    , m_socket(-1)
+    , m_notifier(nullptr)
+{
+}
+
+ProcessEventSource::~ProcessEventSource()
+{
+    stop();
+}
+
+bool ProcessEventSource::start() {
+#ifdef Q_OS_LINUX
+    if (m_socket >= 0) return true;
+
+    m_socket = socket(PF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_CONNECTOR);
+    if (m_socket < 0) return false;
+
+    // 事件量大时（例如并行编译）默认接收缓冲区容易溢出，尽量调大；失败不影响使用
+    const int bufferSize = 1024 * 1024;
+    setsockopt(m_socket, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+
+    struct sockaddr_nl addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = CN_IDX_PROC;
+    addr.nl_pid = 0; // 由内核分配端口号
+    if (bind(m_socket, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0 || !subscribe(true)) {
+        // 没有 CAP_NET_ADMIN 时 bind 返回 EPERM
+        close(m_socket);
+        m_socket = -1;
+        return false;
+    }
+
+    m_notifier = new QSocketNotifier(m_socket, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &ProcessEventSource::readEvents);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ProcessEventSource::stop() {
+#ifdef Q_OS_LINUX
+    if (m_socket < 0) return;
+    delete m_notifier;
+    m_notifier = nullptr;
+    subscribe(false);
+    close(m_socket);
+    m_socket = -1;
+#endif
+}
+
+bool ProcessEventSource::subscribe(bool listen) {
+#ifdef Q_OS_LINUX
+    // nlmsghdr + cn_msg + proc_cn_mcast_op，按 netlink 对齐规则放在同一个缓冲区里
+    alignas(struct nlmsghdr) char buffer[NLMSG_SPACE(sizeof(struct cn_msg) + sizeof(enum proc_cn_mcast_op))];
+    memset(buffer, 0, sizeof(buffer));
+
+    struct nlmsghdr *header = reinterpret_cast<struct nlmsghdr *>(buffer);
+    header->nlmsg_len = NLMSG_LENGTH(sizeof(struct cn_msg) + sizeof(enum proc_cn_mcast_op));
+    header->nlmsg_type = NLMSG_DONE;
+    header->nlmsg_pid = 0;
+
+    struct cn_msg *message = static_cast<struct cn_msg *>(NLMSG_DATA(header));
+    message->id.idx = CN_IDX_PROC;
+    message->id.val = CN_VAL_PROC;
+    message->len = sizeof(enum proc_cn_mcast_op);
+
+    const enum proc_cn_mcast_op op = listen ? PROC_CN_MCAST_LISTEN : PROC_CN_MCAST_IGNORE;
+    memcpy(message->data, &op, sizeof(op));
+    return send(m_socket, header, header->nlmsg_len, 0) == static_cast<ssize_t>(header->nlmsg_len);
+#else
+    Q_UNUSED(listen);
+    return false;
+#endif
+}
+
+void ProcessEventSource::readEvents() {
+#ifdef Q_OS_LINUX
+    alignas(struct nlmsghdr) char buffer[8192];
+    for (;;) {
+        const ssize_t received = recv(m_socket, buffer, sizeof(buffer), 0);
+        if (received < 0) {
+            if (errno == EINTR) continue;
+            if (errno == ENOBUFS) {
+                emit eventsLost();
+                continue;
+            }
+            return; // EAGAIN：已读完
+        }
+        if (received == 0) return;
+
+        int remaining = static_cast<int>(received);
+        for (struct nlmsghdr *header = reinterpret_cast<struct nlmsghdr *>(buffer);
+             NLMSG_OK(header, remaining); header = NLMSG_NEXT(header, remaining)) {
+            if (header->nlmsg_type == NLMSG_ERROR || header->nlmsg_type == NLMSG_NOOP) continue;
+
+            const struct cn_msg *message = static_cast<const struct cn_msg *>(NLMSG_DATA(header));
+            if (message->id.idx != CN_IDX_PROC || message->id.val != CN_VAL_PROC) continue;
+            if (message->len < sizeof(struct proc_event)) continue;
+
+            // 消息体没有对齐保证，拷贝出来再访问
+            struct proc_event event;
+            memcpy(&event, message->data, sizeof(event));
+            switch (event.what) {
+            case PROC_EVENT_TYPE(PROC_EVENT_FORK):
+                // child_pid != child_tgid 表示创建的是线程
+                if (event.event_data.fork.child_pid == event.event_data.fork.child_tgid) {
+                    emit processForked(static_cast<quint32>(event.event_data.fork.parent_tgid),
+                                       static_cast<quint32>(event.event_data.fork.child_tgid));
+                }
+                break;
+            case PROC_EVENT_TYPE(PROC_EVENT_EXEC):
+                emit processExeced(static_cast<quint32>(event.event_data.exec.process_tgid));
+                break;
+            case PROC_EVENT_TYPE(PROC_EVENT_EXIT):
+                // 只关心线程组组长退出，即整个进程结束
+                if (event.event_data.exit.process_pid == event.event_data.exit.process_tgid) {
+                    emit processExited(static_cast<quint32>(event.event_data.exit.process_tgid),
+                                       static_cast<int>(event.event_data.exit.exit_code));
+                }
+                break;
+            default:
+                break;
+            }
+        }
+    }
+#endif
+}
@@ -1,5 +1,7 @@
 // processmonitor.cpp
 #include "src/include/monitor/processmonitor.h"
+#include "src/include/monitor/topkselector.h"
+#include "src/include/monitor/processeventsource.h"
 #ifdef Q_OS_WIN
 #include <windows.h>
 #include <psapi.h>
@@ -8,24 +10,617 @@
 #elif defined(Q_OS_LINUX)
 #include <dirent.h>
 #include <unistd.h>
-#include <fstream>
-#include <sstream>
-#include <string>
+#include <cerrno>
+#include <cstdio>
 #endif
 
-ProcessMonitor::ProcessMonitor(QObject *parent) : QObject(parent) {}
+ProcessMonitor::ProcessMonitor(QObject *parent)
+    : QObject(parent)
+#ifdef Q_OS_LINUX
+    , m_generation(0)
+    , m_lastRefresh(0)
+    , m_ticksPerSecond(sysconf(_SC_CLK_TCK))
+    , m_pageMB(sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0))
+    , m_procDir(nullptr)
+    , m_workers(1)
+    , m_scanThreadCount(1)
+    , m_scanBackend(ScanWithPread)
+    , m_lastScanNs(0)
+    , m_smapsTopN(0)
+    , m_smapsMinIntervalNs(0)
+    , m_nextSmapsRead(0)
+    , m_events(nullptr)
+    , m_reconcileIntervalNs(0)
+    , m_lastFullScan(0)
+    , m_fullScanPending(true)
+    , m_exitedNext(0)
+#endif
+{
+}
+
+ProcessMonitor::~ProcessMonitor()
+{
+#ifdef Q_OS_LINUX
+    if (m_procDir) closedir(m_procDir);
+#endif
+}
+
+#ifdef Q_OS_LINUX
+// 进程数达到该值才启用并行扫描；每个任务包含的 PID 数
+static const size_t ParallelScanThreshold = 2048;
+static const size_t PidsPerTask = 256;
+// io_uring 每次提交的 PID 数
+static const int PidsPerBatch = 128;
+// 其他用户的进程在没有 CAP_SYS_PTRACE 时不允许读取 /proc/[pid]/io
+static bool isAccessDenied(int error) {
+    return error == EACCES || error == EPERM;
+}
+
+// smaps_rollup 的读取间隔至少是单次读取耗时的这个倍数
+static const qint64 SmapsCostRatio = 100;
+
+// 最多保留的已退出进程数
+static const int RecentExitCapacity = 256;
+
+void ProcessMonitor::setScanThreadCount(int count) {
+    count = qMax(1, count);
+    if (count == m_scanThreadCount) return;
+    m_scanThreadCount = count;
+    m_pool.reset();
+    m_workers.resize(static_cast<size_t>(count));
+    if (m_scanBackend == ScanWithIoUring && !attachBatchReaders()) setScanBackend(ScanWithPread);
+}
+
+bool ProcessMonitor::setScanBackend(ScanBackend backend) {
+    if (backend == ScanWithIoUring && attachBatchReaders()) {
+        m_scanBackend = ScanWithIoUring;
+        return true;
+    }
+    for (ScanWorker &worker : m_workers) {
+        worker.batch.reset();
+    }
+    m_scanBackend = ScanWithPread;
+    return backend == ScanWithPread;
+}
+
+void ProcessMonitor::setNetworkAttributionEnabled(bool enabled) {
+    if (!enabled) {
+        m_socketDiag.reset();
+    } else if (!m_socketDiag) {
+        m_socketDiag.reset(new SocketDiagCollector);
+    }
+}
+
+QVector<ProcessNetworkStats> ProcessMonitor::networkStats() const {
+    return m_socketDiag ? m_socketDiag->processStats() : QVector<ProcessNetworkStats>();
+}
+
+void ProcessMonitor::setAccurateMemoryEnabled(bool enabled, int topN, int minIntervalMs) {
+    m_smapsTopN = enabled ? qMax(1, topN) : 0;
+    m_smapsMinIntervalNs = MonotonicClock::fromMSecs(qMax(0, minIntervalMs));
+    m_nextSmapsRead = 0; // 下一次刷新立即读取
+}
+
+bool ProcessMonitor::attachBatchReaders() {
+    for (ScanWorker &worker : m_workers) {
+        if (!worker.batch) worker.batch.reset(new ProcfsBatchReader(PidsPerBatch));
+        if (!worker.batch->isAvailable()) return false;
+    }
+    return true;
+}
+
+bool ProcessMonitor::openProcDirectory() {
+    if (m_procDir) {
+        rewinddir(m_procDir);
+        return true;
+    }
+    m_procDir = opendir("/proc");
+    return m_procDir != nullptr;
+}
+
+void ProcessMonitor::listPids() {
+    m_pids.clear();
+    struct dirent *entry;
+    while ((entry = readdir(m_procDir)) != nullptr) {
+        if (entry->d_type != DT_DIR) continue;
+        const char *p = entry->d_name;
+        if (*p < '0' || *p > '9') continue;
+        quint32 pid = 0;
+        while (*p >= '0' && *p <= '9') pid = pid * 10 + static_cast<quint32>(*p++ - '0');
+        m_pids.push_back(pid);
+    }
+}
+
+void ProcessMonitor::listKnownPids() {
+    m_pids.clear();
+    for (QHash<quint64, ProcessEntry>::const_iterator it = m_table.constBegin(); it != m_table.constEnd(); ++it) {
+        m_pids.push_back(static_cast<quint32>(it.key()));
+    }
+}
+
+void ProcessMonitor::refresh() {
+    if (!openProcDirectory()) return;
+
+    // 两次刷新之间经过的时钟滴答数，用于把 CPU 时间增量换算成百分比
+    const MonotonicNs now = MonotonicClock::now();
+    const double elapsedTicks = m_lastRefresh > 0 ? MonotonicClock::toSecs(now - m_lastRefresh) * m_ticksPerSecond : 0.0;
+    m_lastRefresh = now;
+
+    // 有进程事件时新进程已经由 fork 事件加入进程表，只需读取已知进程；
+    // 定期全量扫描一次，补上订阅之前就存在的进程和可能丢失的事件
+    if (processEventsActive() && !m_fullScanPending && now - m_lastFullScan < m_reconcileIntervalNs) {
+        listKnownPids();
+    } else {
+        listPids();
+        m_lastFullScan = now;
+        m_fullScanPending = false;
+    }
+    for (ScanWorker &worker : m_workers) {
+        worker.sampleCount = 0;
+    }
+
+    if (m_scanThreadCount > 1 && m_pids.size() >= ParallelScanThreshold) {
+        // PID 列表按块拆成任务交给工作窃取线程池，各线程只读进程表、写自己的结果数组
+        if (!m_pool) m_pool.reset(new WorkStealingPool(m_scanThreadCount));
+        const size_t pidCount = m_pids.size();
+        const int taskCount = static_cast<int>((pidCount + PidsPerTask - 1) / PidsPerTask);
+        m_pool->run(taskCount, [this, pidCount](int task, int worker) {
+            const size_t begin = static_cast<size_t>(task) * PidsPerTask;
+            scanPids(begin, qMin(begin + PidsPerTask, pidCount), m_workers[static_cast<size_t>(worker)]);
+        });
+    } else {
+        scanPids(0, m_pids.size(), m_workers[0]);
+    }
+
+    // 串行合并各线程的结果
+    bool batchReadersLost = false;
+    for (const ScanWorker &worker : m_workers) {
+        for (size_t i = 0; i < worker.sampleCount; ++i) {
+            applySample(worker.samples[i], elapsedTicks);
+        }
+        batchReadersLost |= worker.batch && !worker.batch->isAvailable();
+    }
+    // 提交失败后批量读取器会关闭自己的 io_uring，此后每次扫描都在逐个读取；
+    // 整体切回 pread，让 scanBackend() 反映实际使用的方式
+    if (m_scanBackend == ScanWithIoUring && batchReadersLost) setScanBackend(ScanWithPread);
+
+    // 本轮没有出现的进程已经退出
+    for (QHash<quint64, ProcessEntry>::iterator it = m_table.begin(); it != m_table.end();) {
+        if (it->generation != m_generation) {
+            it = m_table.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    ++m_generation;
+    if (m_socketDiag) m_socketDiag->refresh();
+    m_lastScanNs = MonotonicClock::now() - now;
+    if (m_smapsTopN > 0 && now >= m_nextSmapsRead) readSmapsRollup(now);
+}
+
+void ProcessMonitor::scanPids(size_t begin, size_t end, ScanWorker &worker) const {
+    ProcfsBatchReader *batch = worker.batch.get();
+    if (!batch || !batch->isAvailable()) {
+        for (size_t i = begin; i < end; ++i) {
+            readSample(m_pids[i], worker);
+        }
+        return;
+    }
+
+    // 每个 PID 最多占用两个文件：stat 和 io
+    const int procFd = dirfd(m_procDir);
+    const size_t pidsPerBatch = static_cast<size_t>(qMax(1, batch->capacity() / 2));
+    char path[32];
+    for (size_t first = begin; first < end; first += pidsPerBatch) {
+        const size_t last = qMin(first + pidsPerBatch, end);
+        batch->clear();
+        worker.batchSlots.clear();
+        for (size_t i = first; i < last; ++i) {
+            snprintf(path, sizeof(path), "%u/stat", m_pids[i]);
+            const int statIndex = batch->add(path);
+            int ioIndex = -1;
+            const QHash<quint64, ProcessEntry>::const_iterator it = m_table.constFind(m_pids[i]);
+            if (it == m_table.constEnd() || !it->ioDenied) {
+                snprintf(path, sizeof(path), "%u/io", m_pids[i]);
+                ioIndex = batch->add(path);
+            }
+            worker.batchSlots.push_back(std::make_pair(statIndex, ioIndex));
+        }
+
+        const bool submitted = batch->submit(procFd);
+        for (size_t i = first; i < last; ++i) {
+            const std::pair<int, int> &slot = worker.batchSlots[i - first];
+            // 批量读取失败（进程已退出、内容被截断或 io_uring 出错）的 PID 退回逐个读取
+            if (!submitted || !batch->succeeded(slot.first)
+                || !parseSample(m_pids[i], batch->data(slot.first), batch->data(slot.first) + batch->size(slot.first), worker)) {
+                readSample(m_pids[i], worker);
+                continue;
+            }
+
+            StatSample &sample = worker.samples[worker.sampleCount - 1];
+            if (sample.ioDenied) continue;
+            if (slot.second >= 0 && batch->succeeded(slot.second)) {
+                sample.hasIo = parseIo(batch->data(slot.second), batch->data(slot.second) + batch->size(slot.second), sample);
+            } else if (slot.second >= 0 && isAccessDenied(batch->errorCode(slot.second))) {
+                sample.ioDenied = true;
+            } else {
+                readIo(m_pids[i], sample, worker);
+            }
+        }
+    }
+}
+
+bool ProcessMonitor::readSample(quint32 pidNumber, ScanWorker &worker) const {
+    char path[32];
+    snprintf(path, sizeof(path), "%u/stat", pidNumber);
+    if (!worker.file.readOnceAt(dirfd(m_procDir), path)) return false;
+    if (!parseSample(pidNumber, worker.file.data(), worker.file.end(), worker)) return false;
+
+    StatSample &sample = worker.samples[worker.sampleCount - 1];
+    if (!sample.ioDenied) readIo(pidNumber, sample, worker);
+    return true;
+}
+
+void ProcessMonitor::readIo(quint32 pidNumber, StatSample &sample, ScanWorker &worker) const {
+    char path[32];
+    snprintf(path, sizeof(path), "%u/io", pidNumber);
+    if (worker.file.readOnceAt(dirfd(m_procDir), path)) {
+        sample.hasIo = parseIo(worker.file.data(), worker.file.end(), sample);
+    } else {
+        // 权限不足的结果记在进程表里，之后的刷新直接跳过，不再发起注定失败的 open
+        sample.ioDenied = isAccessDenied(errno);
+    }
+}
+
+bool ProcessMonitor::parseIo(const char *begin, const char *end, StatSample &sample) {
+    // rchar / wchar 包含页缓存命中和管道，只有 read_bytes / write_bytes 是实际落到块设备上的量
+    ProcfsTokenizer tok(begin, end);
+    int found = 0;
+    do {
+        const char *key;
+        size_t length;
+        if (!tok.nextWord(key, length)) continue;
+
+        quint64 *target = nullptr;
+        if (ProcfsTokenizer::equals(key, length, "read_bytes")) target = &sample.ioReadBytes;
+        else if (ProcfsTokenizer::equals(key, length, "write_bytes")) target = &sample.ioWriteBytes;
+
+        if (target && tok.nextU64(*target) && ++found == 2) break;
+    } while (tok.nextLine());
+    return found == 2;
+}
+
+void ProcessMonitor::readSmapsRollup(MonotonicNs now) {
+    const MonotonicNs start = MonotonicClock::now();
+
+    // RSS 是 PSS 和 USS 的上限，按 RSS 选出前 N 名即可覆盖实际占用最大的进程；内核线程的 RSS 为 0
+    TopKSelector<ProcessEntry *> top(m_smapsTopN);
+    for (QHash<quint64, ProcessEntry>::iterator it = m_table.begin(); it != m_table.end(); ++it) {
+        if (it->rssPages > 0 && !it->smapsDenied) top.offer(static_cast<double>(it->rssPages), &*it);
+    }
+    const std::vector<TopKSelector<ProcessEntry *>::Entry> selected = top.takeSorted();
+
+    // 在调用线程中串行读取，此时没有扫描任务在使用 0 号扫描线程的缓冲区
+    ProcfsFile &file = m_workers[0].file;
+    char path[40];
+    for (const TopKSelector<ProcessEntry *>::Entry &e : selected) {
+        ProcessEntry &entry = *e.second;
+        snprintf(path, sizeof(path), "%llu/smaps_rollup", static_cast<unsigned long long>(entry.pid));
+        if (file.readOnceAt(dirfd(m_procDir), path)) {
+            entry.hasSmaps = parseSmapsRollup(file.data(), file.end(), entry);
+        } else {
+            entry.hasSmaps = false;
+            entry.smapsDenied = isAccessDenied(errno);
+        }
+    }
+
+    // 映射很多的进程读取一次可能要几毫秒，按耗时拉长间隔，把开销控制在 1% 以内
+    const MonotonicNs cost = MonotonicClock::now() - start;
+    m_nextSmapsRead = now + qMax(m_smapsMinIntervalNs, cost * SmapsCostRatio);
+}
+
+bool ProcessMonitor::parseSmapsRollup(const char *begin, const char *end, ProcessEntry &entry) {
+    // 首行是所有映射合并后的区间，之后每行 "Key:  value kB"
+    ProcfsTokenizer tok(begin, end);
+    quint64 pss = 0, privateClean = 0, privateDirty = 0, swap = 0;
+    int found = 0;
+    while (tok.nextLine()) {
+        const char *key;
+        size_t length;
+        if (!tok.nextWord(key, length)) continue;
+
+        quint64 *target = nullptr;
+        if (ProcfsTokenizer::equals(key, length, "Pss")) target = &pss;
+        else if (ProcfsTokenizer::equals(key, length, "Private_Clean")) target = &privateClean;
+        else if (ProcfsTokenizer::equals(key, length, "Private_Dirty")) target = &privateDirty;
+        else if (ProcfsTokenizer::equals(key, length, "Swap")) target = &swap;
 
-QList<ProcessInfo> ProcessMonitor::getTopProcesses(int maxCount) {
+        if (target && tok.nextU64(*target) && ++found == 4) break;
+    }
+    if (found != 4) return false;
+
+    entry.pssKb = pss;
+    entry.ussKb = privateClean + privateDirty;
+    entry.swapKb = swap;
+    return true;
+}
+
+bool ProcessMonitor::parseSample(quint32 pidNumber, const char *begin, const char *end, ScanWorker &worker) const {
+    // pid (comm) state ppid ... utime stime cutime cstime priority nice num_threads itrealvalue starttime vsize rss
+    ProcfsTokenizer tok(begin, end);
+    quint64 pid = 0;
+    if (!tok.nextU64(pid) || !tok.skipPast('(')) return false;
+    const char *commBegin = tok.position();
+    if (!tok.skipPastLast(')')) return false;
+    const char *commEnd = tok.position() - 1;
+
+    quint64 utime = 0, stime = 0, threads = 0, startTime = 0, rssPages = 0;
+    if (!tok.skipFields(11) || !tok.nextU64(utime) || !tok.nextU64(stime)) return false;
+    if (!tok.skipFields(4) || !tok.nextU64(threads)) return false;
+    if (!tok.skipFields(1) || !tok.nextU64(startTime)) return false;
+    if (!tok.skipFields(1) || !tok.nextU64(rssPages)) return false;
+
+    // 结果数组只增不减，复用上一轮的元素
+    if (worker.sampleCount == worker.samples.size()) worker.samples.emplace_back();
+    StatSample &sample = worker.samples[worker.sampleCount++];
+    sample.pid = pid;
+    sample.startTime = startTime;
+    sample.cpuTicks = utime + stime;
+    sample.rssPages = rssPages;
+    sample.threadCount = static_cast<int>(threads);
+
+    // 扫描期间进程表只读，可以在多个线程中同时查找
+    sample.hasIo = false;
+    sample.ioReadBytes = 0;
+    sample.ioWriteBytes = 0;
+
+    const QHash<quint64, ProcessEntry>::const_iterator it = m_table.constFind(pid);
+    sample.isNew = it == m_table.constEnd() || it->startTime != startTime;
+    sample.ioDenied = !sample.isNew && it->ioDenied;
+    if (!sample.isNew) return true;
+
+    // 新进程，或 pid 已被另一个进程复用：带上只需读取一次的 comm 和 cmdline
+    sample.name.assign(commBegin, commEnd);
+    sample.commandLine.clear();
+    char path[32];
+    snprintf(path, sizeof(path), "%u/cmdline", pidNumber);
+    if (worker.file.readOnceAt(dirfd(m_procDir), path) && worker.file.size() > 0) { // 内核线程没有命令行
+        // 参数之间以 '\0' 分隔
+        sample.commandLine.assign(worker.file.data(), worker.file.size());
+        while (!sample.commandLine.empty() && sample.commandLine.back() == '\0') sample.commandLine.pop_back();
+        for (char &c : sample.commandLine) {
+            if (c == '\0') c = ' ';
+        }
+    }
+    return true;
+}
+
+void ProcessMonitor::applySample(const StatSample &sample, double elapsedTicks) {
+    if (!sample.isNew) {
+        QHash<quint64, ProcessEntry>::iterator it = m_table.find(sample.pid);
+        // 已知进程：只更新会变化的字段
+        const quint64 delta = sample.cpuTicks >= it->cpuTicks ? sample.cpuTicks - it->cpuTicks : 0;
+        it->cpuPercent = elapsedTicks > 0.0 ? delta * 100.0 / elapsedTicks : 0.0;
+        it->cpuTicks = sample.cpuTicks;
+        it->rssPages = sample.rssPages;
+        it->threadCount = sample.threadCount;
+        const double elapsedSeconds = elapsedTicks / m_ticksPerSecond;
+        if (sample.hasIo && it->hasIo && elapsedSeconds > 0.0) {
+            it->ioReadRate = sample.ioReadBytes >= it->ioReadBytes ? (sample.ioReadBytes - it->ioReadBytes) / elapsedSeconds : 0.0;
+            it->ioWriteRate = sample.ioWriteBytes >= it->ioWriteBytes ? (sample.ioWriteBytes - it->ioWriteBytes) / elapsedSeconds : 0.0;
+        } else {
+            it->ioReadRate = 0.0;
+            it->ioWriteRate = 0.0;
+        }
+        it->ioReadBytes = sample.ioReadBytes;
+        it->ioWriteBytes = sample.ioWriteBytes;
+        it->hasIo = sample.hasIo;
+        it->ioDenied = sample.ioDenied;
+        it->generation = m_generation;
+        return;
+    }
+
+    // 重新建立基线，这一轮的 CPU 占用记为 0
+    ProcessEntry fresh;
+    fresh.pid = sample.pid;
+    fresh.startTime = sample.startTime;
+    fresh.name = QString::fromUtf8(sample.name.data(), static_cast<int>(sample.name.size()));
+    fresh.commandLine = QString::fromUtf8(sample.commandLine.data(), static_cast<int>(sample.commandLine.size()));
+    fresh.cpuTicks = sample.cpuTicks;
+    fresh.cpuPercent = 0.0;
+    fresh.rssPages = sample.rssPages;
+    fresh.threadCount = sample.threadCount;
+    fresh.ioReadBytes = sample.ioReadBytes;
+    fresh.ioWriteBytes = sample.ioWriteBytes;
+    fresh.ioReadRate = 0.0;
+    fresh.ioWriteRate = 0.0;
+    fresh.hasIo = sample.hasIo;
+    fresh.ioDenied = sample.ioDenied;
+    fresh.pssKb = 0;
+    fresh.ussKb = 0;
+    fresh.swapKb = 0;
+    fresh.hasSmaps = false;
+    fresh.smapsDenied = false;
+    fresh.generation = m_generation;
+    m_table.insert(sample.pid, fresh);
+}
+
+double ProcessMonitor::rankValue(const ProcessEntry &entry, RankKey key) const {
+    switch (key) {
+    case RankByCpu: return entry.cpuPercent;
+    case RankByMemory: return static_cast<double>(entry.rssPages);
+    case RankByThreads: return entry.threadCount;
+    case RankByNetwork: {
+        const ProcessNetworkStats *net = m_socketDiag ? m_socketDiag->find(entry.pid) : nullptr;
+        return net ? net->rxBytesPerSec + net->txBytesPerSec : 0.0;
+    }
+    case RankByIo: return entry.ioReadRate + entry.ioWriteRate;
+    case RankByPss: return entry.hasSmaps ? entry.pssKb * 1024.0 : entry.rssPages * m_pageMB * 1024.0 * 1024.0;
+    }
+    return 0.0;
+}
+
+ProcessInfo ProcessMonitor::toProcessInfo(const ProcessEntry &entry) const {
+    const double mem = entry.rssPages * m_pageMB; // 转换为MB
+    ProcessInfo info;
+    info.name = entry.name;
+    info.pid = entry.pid;
+    info.cpuPercent = entry.cpuPercent;
+    info.memoryMB = mem;
+    info.usage = mem; // 设置通用usage字段为内存使用量
+    info.usageString = QString::number(mem, 'f', 1) + " MB";
+    info.commandLine = entry.commandLine;
+    info.threadCount = entry.threadCount;
+    info.diskReadBytesPerSec = entry.ioReadRate;
+    info.diskWriteBytesPerSec = entry.ioWriteRate;
+    info.diskIoAvailable = entry.hasIo;
+    if (const ProcessNetworkStats *net = m_socketDiag ? m_socketDiag->find(entry.pid) : nullptr) {
+        info.netRxBytesPerSec = net->rxBytesPerSec;
+        info.netTxBytesPerSec = net->txBytesPerSec;
+        info.tcpConnections = net->tcpConnections;
+        info.udpSockets = net->udpSockets;
+    }
+    if (entry.hasSmaps) {
+        info.pssMB = entry.pssKb / 1024.0;
+        info.ussMB = entry.ussKb / 1024.0;
+        info.swapMB = entry.swapKb / 1024.0;
+        info.accurateMemoryAvailable = true;
+    }
+    return info;
+}
+
+QList<ProcessInfo> ProcessMonitor::processes() const {
+    QList<ProcessInfo> list;
+    list.reserve(m_table.size());
+    for (QHash<quint64, ProcessEntry>::const_iterator it = m_table.constBegin(); it != m_table.constEnd(); ++it) {
+        list.append(toProcessInfo(*it));
+    }
+    return list;
+}
+
+bool ProcessMonitor::enableProcessEvents(int reconcileIntervalMs) {
+    m_reconcileIntervalNs = MonotonicClock::fromMSecs(qMax(0, reconcileIntervalMs));
+    if (processEventsActive()) return true;
+
+    if (!m_events) {
+        m_events = new ProcessEventSource(this);
+        connect(m_events, &ProcessEventSource::processForked, this, &ProcessMonitor::handleFork);
+        connect(m_events, &ProcessEventSource::processExeced, this, &ProcessMonitor::handleExec);
+        connect(m_events, &ProcessEventSource::processExited, this, &ProcessMonitor::handleExit);
+        connect(m_events, &ProcessEventSource::eventsLost, this, [this]() { m_fullScanPending = true; });
+    }
+    if (!m_events->start()) return false;
+
+    // 订阅之前的进程只能靠扫描得到
+    m_fullScanPending = true;
+    return true;
+}
+
+bool ProcessMonitor::processEventsActive() const {
+    return m_events && m_events->isActive();
+}
+
+QList<ProcessMonitor::ExitedProcess> ProcessMonitor::recentlyExited() const {
+    QList<ExitedProcess> list;
+    const int count = m_exited.size();
+    list.reserve(count);
+    for (int i = 1; i <= count; ++i) {
+        list.append(m_exited[(m_exitedNext - i + count) % count]);
+    }
+    return list;
+}
+
+void ProcessMonitor::handleFork(quint32 parentPid, quint32 childPid) {
+    // 子进程先继承父进程的名称和命令行，starttime 记为 0，下一次刷新时按新进程读取；
+    // 如果在那之前就 exec 或退出，由对应的事件补全
+    ProcessEntry entry;
+    const QHash<quint64, ProcessEntry>::const_iterator parent = m_table.constFind(parentPid);
+    if (parent != m_table.constEnd()) {
+        entry.name = parent->name;
+        entry.commandLine = parent->commandLine;
+    }
+    entry.pid = childPid;
+    entry.startTime = 0;
+    entry.cpuTicks = 0;
+    entry.cpuPercent = 0.0;
+    entry.rssPages = 0;
+    entry.threadCount = 1;
+    entry.ioReadBytes = 0;
+    entry.ioWriteBytes = 0;
+    entry.ioReadRate = 0.0;
+    entry.ioWriteRate = 0.0;
+    entry.hasIo = false;
+    entry.ioDenied = false;
+    entry.pssKb = 0;
+    entry.ussKb = 0;
+    entry.swapKb = 0;
+    entry.hasSmaps = false;
+    entry.smapsDenied = false;
+    entry.generation = m_generation - 1; // 与上一轮刷新过的进程相同，下一轮没有读到时照常清除
+    m_table.insert(childPid, entry);
+}
+
+void ProcessMonitor::handleExec(quint32 pid) {
+    if (!m_procDir && !openProcDirectory()) return;
+
+    // exec 之后 comm 和 cmdline 都变了，立即按新进程读取，进程很快退出时也能留下正确的名称
+    QHash<quint64, ProcessEntry>::iterator it = m_table.find(pid);
+    if (it != m_table.end()) it->startTime = 0;
+
+    ScanWorker &worker = m_workers[0];
+    worker.sampleCount = 0;
+    if (!readSample(pid, worker)) return;
+    applySample(worker.samples[0], 0.0);
+    m_table[pid].generation = m_generation - 1;
+}
+
+void ProcessMonitor::handleExit(quint32 pid, int exitStatus) {
+    QHash<quint64, ProcessEntry>::iterator it = m_table.find(pid);
+    if (it == m_table.end()) return; // 订阅之后、首次扫描之前就存在的进程，没有可记录的信息
+
+    ExitedProcess exited;
+    exited.pid = pid;
+    exited.name = it->name;
+    exited.commandLine = it->commandLine;
+    exited.cpuSeconds = it->cpuTicks / m_ticksPerSecond;
+    exited.exitStatus = exitStatus;
+    exited.exitTime = MonotonicClock::now();
+    m_table.erase(it);
+
+    if (m_exited.size() < RecentExitCapacity) {
+        m_exited.append(exited);
+    } else {
+        m_exited[m_exitedNext] = exited;
+    }
+    m_exitedNext = (m_exitedNext + 1) % RecentExitCapacity;
+}
+#endif
+
+QList<ProcessInfo> ProcessMonitor::getTopProcesses(int maxCount, RankKey key) {
     QList<ProcessInfo> list;
 #ifdef Q_OS_WIN
     DWORD pids[1024], needed;
     if (!EnumProcesses(pids, sizeof(pids), &needed)) return list;
     int count = needed / sizeof(DWORD);
 
+    // Windows 下只有内存可用于排名，其他排名依据按枚举顺序取前 K 个
+    TopKSelector<ProcessInfo> top(maxCount);
     for (int i = 0; i < count; ++i) {
         HANDLE hProcess = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE, pids[i]);
         if (!hProcess) continue;
 
+        PROCESS_MEMORY_COUNTERS pmc;
+        double mem = 0;
+        if (GetProcessMemoryInfo(hProcess, &pmc, sizeof(pmc))) {
+            mem = pmc.WorkingSetSize / (1024.0 * 1024.0);
+        }
+        const double rank = key == RankByMemory ? mem : 0.0;
+        if (!top.accepts(rank)) {
+            // 进不了前 K 名的进程不再查询名称、不构造字符串
+            CloseHandle(hProcess);
+            continue;
+        }
+
         TCHAR name[MAX_PATH] = TEXT("<unknown>");
         HMODULE mod;
         DWORD cbNeeded;
@@ -33,12 +628,6 @@ QList<ProcessInfo> ProcessMonitor::getTopProcesses(int maxCount) {
             GetModuleBaseName(hProcess, mod, name, sizeof(name) / sizeof(TCHAR));
         }
 
-        PROCESS_MEMORY_COUNTERS pmc;
-        double mem = 0;
-        if (GetProcessMemoryInfo(hProcess, &pmc, sizeof(pmc))) {
-            mem = pmc.WorkingSetSize / (1024.0 * 1024.0);
-        }
-
         ProcessInfo info;
         info.name = QString::fromWCharArray(name);
         info.pid = static_cast<quint64>(pids[i]);
@@ -46,58 +635,29 @@ QList<ProcessInfo> ProcessMonitor::getTopProcesses(int maxCount) {
         info.memoryMB = mem;
         info.usage = mem; // 设置通用usage字段为内存使用量
         info.usageString = QString::number(mem, 'f', 1) + " MB";
-        list.append(info);
+        top.offer(rank, info);
         CloseHandle(hProcess);
     }
+    const std::vector<TopKSelector<ProcessInfo>::Entry> selected = top.takeSorted();
+    list.reserve(static_cast<int>(selected.size()));
+    for (const TopKSelector<ProcessInfo>::Entry &e : selected) {
+        list.append(e.second);
+    }
 #elif defined(Q_OS_LINUX)
-    DIR *dir = opendir("/proc");
-    struct dirent *entry;
-    while ((entry = readdir(dir)) != nullptr) {
-        if (entry->d_type != DT_DIR) continue;
-        QString pidStr = entry->d_name;
-        bool ok;
-        int pid = pidStr.toInt(&ok);
-        if (!ok) continue;
-
-        std::ifstream statFile(QString("/proc/%1/stat").arg(pid).toStdString());
-        std::ifstream statusFile(QString("/proc/%1/status").arg(pid).toStdString());
-        std::string comm;
-        double mem = 0;
-        if (statFile) {
-            std::string temp;
-            statFile >> pid >> comm; // name is comm (2nd field)
-            // 移除comm字符串两端的括号
-            if (comm.size() >= 2 && comm.front() == '(' && comm.back() == ')') {
-                comm = comm.substr(1, comm.size() - 2);
-            }
-        }
-        if (statusFile) {
-            std::string line;
-            while (std::getline(statusFile, line)) {
-                if (line.find("VmRSS:") == 0) {
-                    double vmRss = 0;
-                    sscanf(line.c_str(), "VmRSS: %lf kB", &vmRss);
-                    mem = vmRss / 1024.0; // 转换为MB
-                    break;
-                }
-            }
-        }
-
-        ProcessInfo info;
-        info.name = QString::fromStdString(comm);
-        info.pid = static_cast<quint64>(pid);
-        info.cpuPercent = 0.0;
-        info.memoryMB = mem;
-        info.usage = mem; // 设置通用usage字段为内存使用量
-        info.usageString = QString::number(mem, 'f', 1) + " MB";
-        list.append(info);
+    // 只对上一次 refresh() 的结果排名。两次刷新相隔太近会重置速率基线，I/O 和网络速率都接近 0
+    // 堆中只保存表项指针，选出前 K 名之后才构造 K 个 ProcessInfo
+    TopKSelector<const ProcessEntry *> top(maxCount);
+    for (QHash<quint64, ProcessEntry>::const_iterator it = m_table.constBegin(); it != m_table.constEnd(); ++it) {
+        top.offer(rankValue(*it, key), &*it);
+    }
+    const std::vector<TopKSelector<const ProcessEntry *>::Entry> selected = top.takeSorted();
+    list.reserve(static_cast<int>(selected.size()));
+    for (const TopKSelector<const ProcessEntry *>::Entry &e : selected) {
+        list.append(toProcessInfo(*e.second));
     }
-    closedir(dir);
+#else
+    Q_UNUSED(maxCount);
+    Q_UNUSED(key);
 #endif
-    std::sort(list.begin(), list.end(), [](const ProcessInfo &a, const ProcessInfo &b) {
-        return a.memoryMB > b.memoryMB;
-    });
-    if (list.size() > maxCount)
-        list = list.mid(0, maxCount);
     return list;
 }
@@ -0,0 +1,208 @@
+// procfsbatchreader.cpp
+#include "src/include/monitor/procfsbatchreader.h"
+#include <cstring>
+#ifdef Q_OS_LINUX
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// 每个文件的路径长度上限，足够放下 "4294967295/xxxxxxx"
+static const size_t PathLength = 32;
+
+#ifdef Q_OS_LINUX
+// 每个文件对应的三个请求，编码在 user_data 的低两位
+enum BatchOp {
+    BatchOpOpen = 0,
+    BatchOpRead = 1,
+    BatchOpClose = 2
+};
+#endif
+
+ProcfsBatchReader::ProcfsBatchReader(int capacity, size_t bufferSize)
+    : m_capacity(qMax(1, capacity))
+    , m_bufferSize(bufferSize)
+    , m_count(0)
+    , m_paths(static_cast<size_t>(m_capacity) * PathLength)
+    , m_buffers(static_cast<size_t>(m_capacity) * bufferSize)
+    , m_results(static_cast<size_t>(m_capacity), -1)
+    , m_syscalls(0)
+    , m_ringFd(-1)
+    , m_ringMemory(nullptr)
+    , m_ringSize(0)
+    , m_sqes(nullptr)
+    , m_sqesSize(0)
+    , m_sqTail(nullptr)
+    , m_sqMask(0)
+    , m_cqHead(nullptr)
+    , m_cqTail(nullptr)
+    , m_cqMask(0)
+    , m_cqes(nullptr)
+    , m_localTail(0)
+{
+    if (!setup()) teardown();
+}
+
+ProcfsBatchReader::~ProcfsBatchReader()
+{
+    teardown();
+}
+
+bool ProcfsBatchReader::setup() {
+#ifdef Q_OS_LINUX
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    m_ringFd = static_cast<int>(syscall(__NR_io_uring_setup, static_cast<unsigned>(m_capacity * 3), &params));
+    if (m_ringFd < 0) return false;
+    // 只支持 SQ/CQ 共用一次 mmap 的内核（5.4 以上），更老的内核也不支持下面用到的直接文件槽
+    if (!(params.features & IORING_FEAT_SINGLE_MMAP)) return false;
+
+    const size_t sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    const size_t cqSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    m_ringSize = qMax(sqSize, cqSize);
+    m_ringMemory = mmap(nullptr, m_ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_SQ_RING);
+    if (m_ringMemory == MAP_FAILED) {
+        m_ringMemory = nullptr;
+        return false;
+    }
+    m_sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    void *sqes = mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) return false;
+    m_sqes = static_cast<struct io_uring_sqe *>(sqes);
+
+    char *ring = static_cast<char *>(m_ringMemory);
+    m_sqTail = reinterpret_cast<unsigned *>(ring + params.sq_off.tail);
+    m_sqMask = *reinterpret_cast<unsigned *>(ring + params.sq_off.ring_mask);
+    m_cqHead = reinterpret_cast<unsigned *>(ring + params.cq_off.head);
+    m_cqTail = reinterpret_cast<unsigned *>(ring + params.cq_off.tail);
+    m_cqMask = *reinterpret_cast<unsigned *>(ring + params.cq_off.ring_mask);
+    m_cqes = reinterpret_cast<struct io_uring_cqe *>(ring + params.cq_off.cqes);
+    m_localTail = *m_sqTail;
+
+    // SQ 下标数组固定为恒等映射，之后只需推进 tail
+    unsigned *array = reinterpret_cast<unsigned *>(ring + params.sq_off.array);
+    for (unsigned i = 0; i < params.sq_entries; ++i) array[i] = i;
+
+    // 注册 capacity 个空的文件槽，openat 直接把文件放进槽里，read/close 按槽号引用
+    struct io_uring_rsrc_register files;
+    memset(&files, 0, sizeof(files));
+    files.nr = static_cast<unsigned>(m_capacity);
+    files.flags = IORING_RSRC_REGISTER_SPARSE;
+    return syscall(__NR_io_uring_register, m_ringFd, IORING_REGISTER_FILES2, &files, sizeof(files)) == 0;
+#else
+    return false;
+#endif
+}
+
+void ProcfsBatchReader::teardown() {
+#ifdef Q_OS_LINUX
+    if (m_sqes) munmap(m_sqes, m_sqesSize);
+    if (m_ringMemory) munmap(m_ringMemory, m_ringSize);
+    if (m_ringFd >= 0) ::close(m_ringFd);
+#endif
+    m_sqes = nullptr;
+    m_ringMemory = nullptr;
+    m_ringFd = -1;
+}
+
+int ProcfsBatchReader::add(const char *relativePath) {
+    if (m_count == m_capacity) return -1;
+    const size_t length = strlen(relativePath);
+    if (length >= PathLength) return -1;
+    memcpy(m_paths.data() + static_cast<size_t>(m_count) * PathLength, relativePath, length + 1);
+    return m_count++;
+}
+
+bool ProcfsBatchReader::succeeded(int index) const {
+    const int result = m_results[static_cast<size_t>(index)];
+    return result >= 0 && static_cast<size_t>(result) < m_bufferSize;
+}
+
+#ifdef Q_OS_LINUX
+io_uring_sqe *ProcfsBatchReader::nextSqe() {
+    struct io_uring_sqe *sqe = &m_sqes[m_localTail & m_sqMask];
+    ++m_localTail;
+    memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+bool ProcfsBatchReader::waitCompletions(unsigned toSubmit, unsigned expected) {
+    unsigned reaped = 0;
+    while (reaped < expected) {
+        const int ret = static_cast<int>(syscall(__NR_io_uring_enter, m_ringFd, toSubmit, expected - reaped,
+                                                 IORING_ENTER_GETEVENTS, nullptr, 0));
+        ++m_syscalls;
+        if (ret < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        toSubmit -= qMin(toSubmit, static_cast<unsigned>(ret));
+
+        unsigned head = *m_cqHead;
+        const unsigned tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head, ++reaped) {
+            const struct io_uring_cqe &cqe = m_cqes[head & m_cqMask];
+            int &result = m_results[static_cast<size_t>(cqe.user_data >> 2)];
+            // openat 失败时记录它的错误（进程已退出为 ENOENT，无权读取为 EACCES），
+            // 随后被取消的 read 返回 ECANCELED，不能覆盖它；两者的完成顺序不作假设
+            if ((cqe.user_data & 3) == BatchOpOpen && cqe.res < 0) {
+                result = cqe.res;
+            } else if ((cqe.user_data & 3) == BatchOpRead && cqe.res != -ECANCELED) {
+                result = cqe.res;
+            }
+        }
+        __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+    }
+    return true;
+}
+#endif
+
+bool ProcfsBatchReader::submit(int dirfd) {
+#ifdef Q_OS_LINUX
+    if (!isAvailable() || m_count == 0) return isAvailable();
+
+    for (int i = 0; i < m_count; ++i) {
+        const quint64 tag = static_cast<quint64>(i) << 2;
+        m_results[static_cast<size_t>(i)] = -ECANCELED;
+
+        // openat 失败（进程已退出）时取消后面的 read 和 close，文件没有进入槽中
+        struct io_uring_sqe *open = nextSqe();
+        open->opcode = IORING_OP_OPENAT;
+        open->fd = dirfd;
+        open->addr = reinterpret_cast<quint64>(m_paths.data() + static_cast<size_t>(i) * PathLength);
+        open->open_flags = O_RDONLY;
+        open->file_index = static_cast<unsigned>(i) + 1; // 槽号从 1 开始编码
+        open->flags = IOSQE_IO_LINK;
+        open->user_data = tag | BatchOpOpen;
+
+        // 读到的字节数总是少于缓冲区，普通链接会把短读当成失败而取消 close，这里用硬链接
+        struct io_uring_sqe *read = nextSqe();
+        read->opcode = IORING_OP_READ;
+        read->fd = i;
+        read->addr = reinterpret_cast<quint64>(m_buffers.data() + static_cast<size_t>(i) * m_bufferSize);
+        read->len = static_cast<unsigned>(m_bufferSize);
+        read->off = 0;
+        read->flags = IOSQE_FIXED_FILE | IOSQE_IO_HARDLINK;
+        read->user_data = tag | BatchOpRead;
+
+        struct io_uring_sqe *close = nextSqe();
+        close->opcode = IORING_OP_CLOSE;
+        close->file_index = static_cast<unsigned>(i) + 1;
+        close->user_data = tag | BatchOpClose;
+    }
+    __atomic_store_n(m_sqTail, m_localTail, __ATOMIC_RELEASE);
+
+    const unsigned requests = static_cast<unsigned>(m_count) * 3;
+    if (waitCompletions(requests, requests)) return true;
+
+    // 提交队列已处于未知状态，之后不再使用 io_uring
+    teardown();
+    return false;
+#else
+    Q_UNUSED(dirfd);
+    return false;
+#endif
+}
@@ -0,0 +1,236 @@
+// procfsreader.cpp
+#include "src/include/monitor/procfsreader.h"
+#include <cstring>
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+ProcfsFile::ProcfsFile(const char *path, size_t initialCapacity)
+    : m_path(path ? path : "")
+    , m_fd(-1)
+    , m_buffer(initialCapacity > 0 ? initialCapacity : 4096)
+    , m_size(0)
+{
+}
+
+ProcfsFile::~ProcfsFile() {
+    close();
+}
+
+ProcfsFile::ProcfsFile(ProcfsFile &&other) noexcept
+    : m_path(std::move(other.m_path))
+    , m_fd(other.m_fd)
+    , m_buffer(std::move(other.m_buffer))
+    , m_size(other.m_size)
+{
+    other.m_fd = -1;
+    other.m_size = 0;
+}
+
+ProcfsFile &ProcfsFile::operator=(ProcfsFile &&other) noexcept {
+    if (this != &other) {
+        close();
+        m_path = std::move(other.m_path);
+        m_fd = other.m_fd;
+        m_buffer = std::move(other.m_buffer);
+        m_size = other.m_size;
+        other.m_fd = -1;
+        other.m_size = 0;
+    }
+    return *this;
+}
+
+void ProcfsFile::setPath(const char *path) {
+    close();
+    m_path = path ? path : "";
+}
+
+void ProcfsFile::close() {
+#ifdef Q_OS_LINUX
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+#endif
+    m_fd = -1;
+}
+
+bool ProcfsFile::open() {
+#ifdef Q_OS_LINUX
+    if (m_fd >= 0) return true;
+    if (m_path.empty()) return false;
+    m_fd = ::open(m_path.c_str(), O_RDONLY | O_CLOEXEC);
+    return m_fd >= 0;
+#else
+    return false;
+#endif
+}
+
+bool ProcfsFile::readFd(int fd) {
+#ifdef Q_OS_LINUX
+    if (m_buffer.empty()) m_buffer.resize(4096);
+    for (;;) {
+        ssize_t n = ::pread(fd, m_buffer.data(), m_buffer.size(), 0);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            m_size = 0;
+            return false;
+        }
+        // 缓冲区被填满说明文件可能更大，扩容后从头重读，保证一次读到完整且一致的内容
+        if (static_cast<size_t>(n) == m_buffer.size()) {
+            m_buffer.resize(m_buffer.size() * 2);
+            continue;
+        }
+        m_size = static_cast<size_t>(n);
+        return true;
+    }
+#else
+    Q_UNUSED(fd);
+    m_size = 0;
+    return false;
+#endif
+}
+
+bool ProcfsFile::refresh() {
+    if (!open()) {
+        m_size = 0;
+        return false;
+    }
+    if (readFd(m_fd)) return true;
+
+    // fd 可能已失效（例如设备被移除后重新出现），重新打开一次再试
+    close();
+    if (!open()) return false;
+    return readFd(m_fd);
+}
+
+bool ProcfsFile::readOnce(const char *path) {
+    return readOnceAt(-1, path);
+}
+
+bool ProcfsFile::readOnceAt(int dirfd, const char *relativePath) {
+#ifdef Q_OS_LINUX
+    int fd = dirfd >= 0 ? ::openat(dirfd, relativePath, O_RDONLY | O_CLOEXEC)
+                        : ::open(relativePath, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        m_size = 0;
+        return false;
+    }
+    bool ok = readFd(fd);
+    ::close(fd);
+    return ok;
+#else
+    Q_UNUSED(dirfd);
+    Q_UNUSED(relativePath);
+    m_size = 0;
+    return false;
+#endif
+}
+
+void ProcfsTokenizer::skipSpaces() {
+    while (m_pos < m_end && (*m_pos == ' ' || *m_pos == '\t')) ++m_pos;
+}
+
+bool ProcfsTokenizer::nextLine() {
+    const char *nl = static_cast<const char *>(memchr(m_pos, '\n', m_end - m_pos));
+    if (!nl) {
+        m_pos = m_end;
+        return false;
+    }
+    m_pos = nl + 1;
+    return m_pos < m_end;
+}
+
+bool ProcfsTokenizer::nextWord(const char *&word, size_t &length) {
+    skipSpaces();
+    const char *start = m_pos;
+    while (m_pos < m_end && *m_pos != ' ' && *m_pos != '\t' && *m_pos != '\n' && *m_pos != ':') ++m_pos;
+    word = start;
+    length = static_cast<size_t>(m_pos - start);
+    if (m_pos < m_end && *m_pos == ':') ++m_pos;
+    return length > 0;
+}
+
+bool ProcfsTokenizer::nextU64(quint64 &value) {
+    skipSpaces();
+    if (m_pos >= m_end || *m_pos < '0' || *m_pos > '9') return false;
+    quint64 v = 0;
+    while (m_pos < m_end && *m_pos >= '0' && *m_pos <= '9') {
+        v = v * 10 + static_cast<quint64>(*m_pos - '0');
+        ++m_pos;
+    }
+    value = v;
+    return true;
+}
+
+bool ProcfsTokenizer::nextI64(qint64 &value) {
+    skipSpaces();
+    bool negative = false;
+    if (m_pos < m_end && *m_pos == '-') {
+        negative = true;
+        ++m_pos;
+    }
+    quint64 v = 0;
+    if (!nextU64(v)) return false;
+    value = negative ? -static_cast<qint64>(v) : static_cast<qint64>(v);
+    return true;
+}
+
+bool ProcfsTokenizer::nextDouble(double &value) {
+    skipSpaces();
+    if (m_pos >= m_end || *m_pos < '0' || *m_pos > '9') return false;
+    double v = 0.0;
+    while (m_pos < m_end && *m_pos >= '0' && *m_pos <= '9') {
+        v = v * 10.0 + (*m_pos - '0');
+        ++m_pos;
+    }
+    if (m_pos < m_end && *m_pos == '.') {
+        ++m_pos;
+        double scale = 0.1;
+        while (m_pos < m_end && *m_pos >= '0' && *m_pos <= '9') {
+            v += (*m_pos - '0') * scale;
+            scale *= 0.1;
+            ++m_pos;
+        }
+    }
+    value = v;
+    return true;
+}
+
+bool ProcfsTokenizer::skipFields(int count) {
+    const char *word;
+    size_t length;
+    for (int i = 0; i < count; ++i) {
+        if (!nextWord(word, length)) return false;
+    }
+    return true;
+}
+
+bool ProcfsTokenizer::skipPast(char c) {
+    while (m_pos < m_end && *m_pos != '\n') {
+        if (*m_pos++ == c) return true;
+    }
+    return false;
+}
+
+bool ProcfsTokenizer::skipPastLast(char c) {
+    const char *lineEnd = m_pos;
+    while (lineEnd < m_end && *lineEnd != '\n') ++lineEnd;
+    for (const char *p = lineEnd; p > m_pos; --p) {
+        if (p[-1] == c) {
+            m_pos = p;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ProcfsTokenizer::startsWith(const char *prefix) const {
+    size_t length = strlen(prefix);
+    return static_cast<size_t>(m_end - m_pos) >= length && memcmp(m_pos, prefix, length) == 0;
+}
+
+bool ProcfsTokenizer::equals(const char *word, size_t length, const char *literal) {
+    return strlen(literal) == length && memcmp(word, literal, length) == 0;
+}
@@ -1,6 +1,5 @@
 #include "src/include/monitor/sampler.h"
 #include <QTimer>
-#include <QProcess>
 #include <QThread>
 #include <QDebug>
 #include <QFile>
@@ -9,6 +8,7 @@
 #include <QStandardPaths>
 #include <QDir>
 #include <QCoreApplication>
+#include "src/include/common/monotonicclock.h"
 #ifdef Q_OS_WIN
 #include <windows.h>
 #include <pdh.h>
@@ -31,35 +31,49 @@
 Sampler::Sampler(QObject *parent)
     : QObject(parent)
     , m_timer(new QTimer(this))
+    , m_processes(new ProcessMonitor(this))
+    , m_published(std::make_shared<const SystemSnapshot>())
+    , m_gpuProbe(new GpuProbe(this))
     , m_gpuAvailable(false)
     , m_gpuCheckPerformed(false)
     , m_gpuName(tr("δ⵽"))
     , m_driverVersion("N/A")
 {
     connect(m_timer, &QTimer::timeout, this, &Sampler::collect);
-    
-    // ʼGPU
-    checkGpuAvailability();
+    connect(m_gpuProbe, &GpuProbe::gpuInfoChanged, this, &Sampler::handleGpuInfo);
+#ifdef Q_OS_LINUX
+    // ҳͷģ鹲һݽ̱ҪĹͳһ
+    // ҳʾ˳Ḷ̌ڴҳ水 PSS ģҳʹͳ
+    m_processes->enableProcessEvents();
+    m_processes->setAccurateMemoryEnabled(true);
+    m_processes->setNetworkAttributionEnabled(true);
+#endif
 }
 
 Sampler::~Sampler()
 {
     stopSampling();
+    disablePressureTriggers();
 }
 
 void Sampler::startSampling(int interval)
 {
     m_timer->start(interval);
     
-    // ִһGPU״̬飬ȷUIóʼ״̬
-    checkGpuAvailability();
-    // ǿƷͳʼGPU״̬ź
+    // GPU ̽ں̨Уȷ͵ǰ״̬̽ɺ handleGpuInfo ٴη
+    m_gpuProbe->start();
+    if (m_gpuProbe->hasResult()) {
+        configureGpuTelemetry(m_gpuProbe->info());
+    }
     emit gpuAvailabilityChanged(m_gpuAvailable, m_gpuName, m_driverVersion);
 }
 
 void Sampler::stopSampling()
 {
     m_timer->stop();
+    if (m_gpuTelemetry) {
+        m_gpuTelemetry->stop();
+    }
 }
 
 void Sampler::setStorage(DataStorage *storage)
@@ -75,40 +89,62 @@ void Sampler::setChartWidgets(ChartWidget *cpu, ChartWidget *mem, ChartWidget *g
     netChart = net;
 }
 
-void Sampler::collect()
+bool Sampler::enablePressureTriggers(int stallMs, int windowMs)
 {
-    // GPUԱ仯
-    bool previousGpuAvailable = m_gpuAvailable;
-    checkGpuAvailability();
-    
-    if (previousGpuAvailable != m_gpuAvailable) {
-        emit gpuAvailabilityChanged(m_gpuAvailable, m_gpuName, m_driverVersion);
-        
-        if (m_gpuAvailable) {
-            emit showGpuNotification(tr("GPU״̬"), tr("GPU: %1").arg(m_gpuName));
-        } else {
-            emit showGpuNotification(tr("GPU״̬"), tr("GPUѶϿ"));
-        }
+    disablePressureTriggers();
+    for (int i = 0; i < PressureResourceCount; ++i) {
+        const int fd = m_pressure.addTrigger(static_cast<PressureResource>(i), false, stallMs, windowMs);
+        if (fd < 0) continue;
+        // ͨ POLLPRI ֪ͨӦ QSocketNotifier  Exception 
+        QSocketNotifier *notifier = new QSocketNotifier(fd, QSocketNotifier::Exception, this);
+        connect(notifier, &QSocketNotifier::activated, this, &Sampler::collect);
+        m_pressureNotifiers.append(notifier);
     }
-    
-    // ɼ
-    double cpuUsage = m_cpu.getCpuUsage();
-    double memoryUsage = m_memory.getMemoryUsage();
-    double diskIO = m_disk.getDiskIO();
-    double networkUsage = lastNetworkUsage();
+    return !m_pressureNotifiers.isEmpty();
+}
+
+void Sampler::disablePressureTriggers()
+{
+    qDeleteAll(m_pressureNotifiers);
+    m_pressureNotifiers.clear();
+    m_pressure.clearTriggers();
+}
+
+void Sampler::collect()
+{
+    // һԲɼڵȫݣźŶӿȡֵ
+    // շ޸ģõ shared_ptr ʼָһ
+    std::shared_ptr<const SystemSnapshot> snapshot = std::make_shared<const SystemSnapshot>(takeSnapshot());
+    std::atomic_store(&m_published, snapshot);
+    const SystemSnapshot &s = *snapshot;
     
     // ͸ݸź
-    emit cpuUsageUpdated(cpuUsage);
-    
-    quint64 totalMem = m_memory.getTotalMemory();
-    quint64 usedMem = m_memory.getUsedMemory();
-    quint64 freeMem = totalMem - usedMem;
-    emit memoryStatsUpdated(totalMem, usedMem, freeMem);
-    
-    QPair<quint64, quint64> networkStats = m_network.getNetworkUsageDetailed();
-    emit networkStatsUpdated(networkStats.second / (1024.0 * 1024.0), networkStats.first / (1024.0 * 1024.0));
-    
-    emit diskStatsUpdated(diskIO, diskIO);
+    // PSI ȷģյʹźʱõǱڵѹ
+    if (s.pressure[PressureMemory].valid) {
+        emit pressureStatsUpdated(s.pressure[PressureCpu], s.pressure[PressureMemory], s.pressure[PressureIo]);
+    }
+    emit cpuUsageUpdated(s.cpuUsage);
+    if (!s.coreUsage.isEmpty()) {
+        emit cpuCoreStatsUpdated(s.coreUsage, s.coreIowait, s.coreSteal);
+    }
+    if (s.cpuSensors.frequencyValid || s.cpuSensors.temperatureValid) {
+        emit cpuSensorStatsUpdated(s.cpuSensors);
+    }
+    emit memoryStatsUpdated(s.memoryTotal, s.memoryUsed, s.memoryFree);
+    if (s.vmstat.valid) {
+        emit vmstatUpdated(s.vmstat);
+    }
+    emit networkStatsUpdated(s.networkUploadBytes / (1024.0 * 1024.0), s.networkDownloadBytes / (1024.0 * 1024.0));
+    if (!s.networkInterfaces.isEmpty()) {
+        emit networkInterfaceStatsUpdated(s.networkInterfaces);
+    }
+    if (!s.networkProcesses.isEmpty()) {
+        emit processNetworkStatsUpdated(s.networkProcesses);
+    }
+    emit diskStatsUpdated(static_cast<qint64>(s.diskReadBytes), static_cast<qint64>(s.diskWriteBytes));
+    if (!s.diskDevices.isEmpty()) {
+        emit diskDeviceStatsUpdated(s.diskDevices);
+    }
     
     // GPUãɼGPU
     if (m_gpuAvailable) {
@@ -116,218 +152,90 @@ void Sampler::collect()
     }
     
     // ۺź
-    emit performanceDataUpdated(cpuUsage, memoryUsage, diskIO, networkUsage);
+    emit performanceDataUpdated(s.cpuUsage, s.memoryUsage, s.diskIO, s.networkUsage);
 }
 
-void Sampler::checkGpuAvailability()
+SystemSnapshot Sampler::takeSnapshot()
 {
-    bool wasAvailable = m_gpuAvailable;
-    m_gpuAvailable = detectGpu();
-}
+    SystemSnapshot s;
+    s.timestampNs = MonotonicClock::now();
 
-bool Sampler::detectGpu()
-{
-    
-#ifdef Q_OS_WIN
-    // Windowsƽ̨ʹnvidia-smiȻWMIdxdiag
-    
-    // 1. nvidia-smiNVIDIA GPU
-    QProcess nvidiaProcess;
-    nvidiaProcess.start("nvidia-smi", QStringList() << "--query-gpu=name,driver_version" << "--format=csv,noheader");
-    
-    if (nvidiaProcess.waitForFinished(3000) && nvidiaProcess.exitCode() == 0) {
-        QString output = nvidiaProcess.readAllStandardOutput().trimmed();
-        if (!output.isEmpty()) {
-            QStringList parts = output.split(",");
-            if (parts.size() >= 2) {
-                m_gpuName = parts[0].trimmed();
-                m_driverVersion = parts[1].trimmed();
-                return true;
-            }
-        }
+    s.cpuUsage = m_cpu.getCpuUsage();
+    s.cpuIowait = m_cpu.iowaitPercent();
+    s.cpuSteal = m_cpu.stealPercent();
+    s.coreUsage = m_cpu.coreUsage();
+    s.coreIowait = m_cpu.coreIowait();
+    s.coreSteal = m_cpu.coreSteal();
+    m_cpuSensors.refresh();
+    s.cpuSensors = m_cpuSensors.stats();
+
+    if (m_memory.getMemoryStats(s.memoryTotal, s.memoryUsed)) {
+        s.memoryFree = s.memoryTotal - s.memoryUsed;
+        s.memoryUsage = s.memoryTotal > 0 ? s.memoryUsed * 100.0 / s.memoryTotal : 0.0;
     }
-    
-    // 2. WMIѯGPU
-    QProcess wmiProcess;
-    wmiProcess.start("wmic", QStringList() << "path" << "win32_VideoController" 
-                     << "get" << "Name,DriverVersion,AdapterRAM" << "/format:csv");
-    
-    if (wmiProcess.waitForFinished(5000) && wmiProcess.exitCode() == 0) {
-        QString output = wmiProcess.readAllStandardOutput();
-        QStringList lines = output.split("\n");
-        
-        QString bestGpuName, bestDriverVersion;
-        quint64 bestMemory = 0;
-        
-        for (int i = 1; i < lines.size(); i++) {
-            QString line = lines[i].trimmed();
-            if (line.isEmpty()) continue;
-            
-            QStringList parts = line.split(",");
-            if (parts.size() < 4) continue;
-            
-            QString name = parts[2].trimmed();
-            QString driver = parts[1].trimmed();
-            
-            // ˵ʾ
-            if (name.contains("Microsoft Basic Display", Qt::CaseInsensitive) ||
-                name.contains("Remote Display", Qt::CaseInsensitive) ||
-                name.contains("VNC", Qt::CaseInsensitive) ||
-                name.isEmpty()) {
-                continue;
-            }
-            
-            // ڴС
-            quint64 memory = 0;
-            if (parts.size() >= 4) {
-                bool ok;
-                memory = parts[0].trimmed().toULongLong(&ok);
-                if (!ok) memory = 0;
-            }
-            
-            // GPUȼԿ > Կ
-            bool isDiscrete = name.contains("NVIDIA", Qt::CaseInsensitive) || 
-                             name.contains("AMD", Qt::CaseInsensitive) ||
-                             name.contains("Radeon", Qt::CaseInsensitive);
-            
-            bool isIntegrated = name.contains("Intel", Qt::CaseInsensitive) ||
-                               name.contains("UHD", Qt::CaseInsensitive) ||
-                               name.contains("HD Graphics", Qt::CaseInsensitive) ||
-                               name.contains("Iris", Qt::CaseInsensitive);
-            
-            // ѡԿ
-            if (isDiscrete) {
-                if (bestGpuName.isEmpty() || memory > bestMemory || 
-                    (!bestGpuName.contains("NVIDIA", Qt::CaseInsensitive) && 
-                     !bestGpuName.contains("AMD", Qt::CaseInsensitive) &&
-                     !bestGpuName.contains("Radeon", Qt::CaseInsensitive))) {
-                    bestGpuName = name;
-                    bestDriverVersion = driver;
-                    bestMemory = memory;
-                }
-            }
-            // ûжԿѡ񼯳Կ
-            else if ((isIntegrated || bestGpuName.isEmpty()) && 
-                    (!bestGpuName.contains("NVIDIA", Qt::CaseInsensitive) && 
-                     !bestGpuName.contains("AMD", Qt::CaseInsensitive) &&
-                     !bestGpuName.contains("Radeon", Qt::CaseInsensitive))) {
-                if (bestGpuName.isEmpty() || memory > bestMemory) {
-                    bestGpuName = name;
-                    bestDriverVersion = driver;
-                    bestMemory = memory;
-                }
-            }
-        }
-        
-        if (!bestGpuName.isEmpty()) {
-            m_gpuName = bestGpuName;
-            m_driverVersion = bestDriverVersion;
-            return true;
+    m_memory.getVmstatRates(s.vmstat);
+
+    QPair<quint64, quint64> diskStats = m_disk.getDiskIODetailed();
+    s.diskReadBytes = diskStats.first;
+    s.diskWriteBytes = diskStats.second;
+    s.diskIO = static_cast<double>(s.diskReadBytes + s.diskWriteBytes) / (1024.0 * 1024.0);
+    s.diskDevices = m_disk.deviceStats();
+
+    // ÿֻȡһΣڶζȡõĲֵӽ 0
+    QPair<quint64, quint64> networkStats = m_network.getNetworkUsageDetailed();
+    s.networkUploadBytes = networkStats.first;
+    s.networkDownloadBytes = networkStats.second;
+    s.networkUsage = static_cast<double>(s.networkUploadBytes + s.networkDownloadBytes) / (1024.0 * 1024.0);
+    s.networkInterfaces = m_network.interfaceStats();
+
+#ifdef Q_OS_LINUX
+    // ̱Žգԭˢ£ҳͷģźжȡͬһݽ
+    // ÿֻɨһ /proc̵ I/O ʶĲΪĸ
+    m_processes->refresh();
+    // ͳֱʹý̱ˢʱ sock_diag ÿֻһ׽
+    s.networkProcesses = m_processes->networkStats();
+#else
+    s.networkProcesses = m_network.getProcessNetworkStats();
+#endif
+
+    if (m_pressure.refresh()) {
+        for (int i = 0; i < PressureResourceCount; ++i) {
+            s.pressure[i] = m_pressure.stats(static_cast<PressureResource>(i));
         }
     }
-    
-    // 3. dxdiag
-    QProcess dxdiagProcess;
-    dxdiagProcess.start("dxdiag", QStringList() << "/t" << "gpuinfo.txt");
-    
-    if (dxdiagProcess.waitForFinished(10000)) {
-        QThread::msleep(500);
-        
-        QFile file("gpuinfo.txt");
-        if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            QTextStream in(&file);
-            QString content = in.readAll();
-            file.close();
-            file.remove();
-            
-            QRegularExpression nameRx("Card name: (.+)");
-            QRegularExpression driverRx("Driver Version: (.+)");
-            
-            QRegularExpressionMatch nameMatch = nameRx.match(content);
-            if (nameMatch.hasMatch()) {
-                m_gpuName = nameMatch.captured(1).trimmed();
-                
-                QRegularExpressionMatch driverMatch = driverRx.match(content);
-                if (driverMatch.hasMatch()) {
-                    m_driverVersion = driverMatch.captured(1).trimmed();
-                } else {
-                    m_driverVersion = "δ֪";
-                }
-                
-                return true;
-            }
-        }
+
+    return s;
+}
+
+void Sampler::handleGpuInfo(const GpuInfo &info)
+{
+    const bool previousGpuAvailable = m_gpuAvailable;
+    m_gpuAvailable = info.available;
+    m_gpuName = info.available ? info.name : tr("δ⵽");
+    m_driverVersion = info.available ? info.driverVersion : QString("N/A");
+    if (m_timer->isActive()) {
+        configureGpuTelemetry(info);
     }
-    
-#elif defined(Q_OS_LINUX)
-    // Linuxƽ̨ʹrocm-smilspci
-    
-    // 1. rocm-smiAMD GPU
-    QProcess amdProcess;
-    amdProcess.start("rocm-smi", QStringList() << "--showproductname" << "--showdriverversion");
-    
-    if (amdProcess.waitForFinished(3000) && amdProcess.exitCode() == 0) {
-        QString output = amdProcess.readAllStandardOutput().trimmed();
-        
-        if (!output.isEmpty()) {
-            QStringList lines = output.split("\n");
-            QString gpuName, driverVersion;
-            
-            for (const QString& line : lines) {
-                if (line.contains("GPU Product Name")) {
-                    gpuName = line.section(':', 1).trimmed();
-                } else if (line.contains("Driver Version")) {
-                    driverVersion = line.section(':', 1).trimmed();
-                }
-            }
-            
-            if (!gpuName.isEmpty()) {
-                m_gpuName = gpuName;
-                m_driverVersion = driverVersion;
-                return true;
-            }
+    emit gpuAvailabilityChanged(m_gpuAvailable, m_gpuName, m_driverVersion);
+
+    // ״̽Ľֻǳʼ״̬֮ı仯ȲΡأʾû
+    if (m_gpuCheckPerformed && previousGpuAvailable != m_gpuAvailable) {
+        if (m_gpuAvailable) {
+            emit showGpuNotification(tr("GPU״̬"), tr("GPU: %1").arg(m_gpuName));
+        } else {
+            emit showGpuNotification(tr("GPU״̬"), tr("GPUѶϿ"));
         }
     }
-    
-    // 2. lspciѯGPU
-    QProcess lspciProcess;
-    lspciProcess.start("lspci", QStringList() << "-v");
-    
-    if (lspciProcess.waitForFinished(3000) && lspciProcess.exitCode() == 0) {
-        QString output = lspciProcess.readAllStandardOutput().trimmed();
-        QStringList lines = output.split("\n");
-        
-        QString gpuInfo;
-        for (int i = 0; i < lines.size(); i++) {
-            if (lines[i].contains("VGA compatible controller") || 
-                lines[i].contains("3D controller")) {
-                gpuInfo = lines[i].section(':', 1).trimmed();
-                
-                // Ϣ
-                for (int j = i + 1; j < qMin(i + 10, lines.size()); j++) {
-                    if (lines[j].contains("Kernel driver in use") || 
-                        lines[j].contains("Module")) {
-                        m_driverVersion = lines[j].section(':', 1).trimmed();
-                        break;
-                    }
-                }
-                break;
-            }
-        }
-        
-        if (!gpuInfo.isEmpty()) {
-            m_gpuName = gpuInfo;
-            if (m_driverVersion.isEmpty()) {
-                m_driverVersion = "δ֪";
-            }
-            return true;
-        }
+    m_gpuCheckPerformed = true;
+}
+
+void Sampler::configureGpuTelemetry(const GpuInfo &info)
+{
+    // ңԴֻ̽仯ʼʱ򿪣֮ÿֻȡѾ򿪵Դ
+    m_gpuTelemetry = GpuTelemetrySource::create(info);
+    if (m_gpuTelemetry) {
+        m_gpuTelemetry->start(m_timer->interval());
     }
-#endif
-    
-    m_gpuName = tr("δ⵽");
-    m_driverVersion = "N/A";
-    return false;
 }
 
 void Sampler::sampleGpuStats()
@@ -335,72 +243,16 @@ void Sampler::sampleGpuStats()
     if (!m_gpuAvailable) {
         return;
     }
-    double usage = 0.0;
-    double temperature = 0.0;
-    quint64 memoryUsed = 0;
-    quint64 memoryTotal = 0;
-    bool successful = false;
 
-    if (m_gpuName.contains("NVIDIA", Qt::CaseInsensitive)) {
-        QProcess process;
-        process.start("nvidia-smi", QStringList() 
-            << "--query-gpu=utilization.gpu,temperature.gpu,memory.used,memory.total" 
-            << "--format=csv,noheader,nounits");
-        
-        if (process.waitForFinished(3000) && process.exitCode() == 0) {
-            QString output = process.readAllStandardOutput().trimmed();
-            QStringList values = output.split(",");
-            
-            if (values.size() >= 4) {
-                bool ok;
-                usage = values[0].trimmed().toDouble(&ok);
-                if (!ok) usage = 0.0;
-                
-                temperature = values[1].trimmed().toDouble(&ok);
-                if (!ok) temperature = 0.0;
-                
-                memoryUsed = values[2].trimmed().toULongLong(&ok) * 1024 * 1024; // MB to bytes
-                if (!ok) memoryUsed = 0;
-                
-                memoryTotal = values[3].trimmed().toULongLong(&ok) * 1024 * 1024; // MB to bytes
-                if (!ok) memoryTotal = 0;
-                
-                successful = true;
-            }
-        }
-    }
-    else if (m_gpuName.contains("AMD", Qt::CaseInsensitive) || m_gpuName.contains("Radeon", Qt::CaseInsensitive)) {
-#ifdef Q_OS_LINUX
-        QProcess process;
-        process.start("rocm-smi", QStringList() << "--showuse" << "--showtemp" << "--showmemuse");
-        
-        if (process.waitForFinished(3000) && process.exitCode() == 0) {
-            QString output = process.readAllStandardOutput();
-            // rocm-smi
-            // Ҫʵʵrocm-smiʽ
-            successful = true;
-        }
-#endif
-    }
-    
-    // ޷ȡݣṩĬֵ
-    if (!successful) {
-        usage = 0.0;
-        temperature = 0.0;
-        memoryUsed = 0;
-        memoryTotal = 0;
+    // ޷ȡʱӽС豸֧֣Ϊ 0
+    GpuSample sample;
+    if (m_gpuTelemetry) {
+        m_gpuTelemetry->read(sample);
     }
     
     // GPUͳź
-    emit gpuStatsUpdated(usage, temperature, memoryUsed, memoryTotal);
-    
-    // ȷGPUȻ
-    if (successful) {
-        if (!m_gpuAvailable) {
-            m_gpuAvailable = true;
-            emit gpuAvailabilityChanged(true, m_gpuName, m_driverVersion);
-        }
-    }
+    emit gpuStatsUpdated(sample.usage, sample.temperature, sample.memoryUsed, sample.memoryTotal);
+    emit gpuTelemetryUpdated(sample);
 }
 
 void Sampler::showGpuNotFoundDialog() {
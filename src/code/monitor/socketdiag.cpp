@@ -0,0 +1,298 @@
+// socketdiag.cpp
+#include "src/include/monitor/socketdiag.h"
+#include <algorithm>
+#ifdef Q_OS_LINUX
+#include <linux/inet_diag.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/sock_diag.h>
+#include <linux/tcp.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <cstddef>
+#endif
+
+#ifdef Q_OS_LINUX
+// 内核 tcp_states.h 中的状态值，用户态头文件没有单独导出
+static const int TcpStateEstablished = 1;
+static const int TcpStateListen = 10;
+
+// 两次遍历全部 /proc/*/fd 的最小间隔，所有找不到所属进程的套接字共用这一限制
+static const MonotonicNs FullWalkInterval = MonotonicClock::fromSecs(10);
+#endif
+
+SocketDiagCollector::SocketDiagCollector()
+#ifdef Q_OS_LINUX
+    : m_socket(-1)
+    , m_generation(0)
+    , m_lastRefresh(0)
+    , m_nextFullWalk(0)
+    , m_buffer(32768)
+#endif
+{
+#ifdef Q_OS_LINUX
+    reopenSocket();
+#endif
+}
+
+SocketDiagCollector::~SocketDiagCollector()
+{
+#ifdef Q_OS_LINUX
+    if (m_socket >= 0) close(m_socket);
+#endif
+}
+
+const ProcessNetworkStats *SocketDiagCollector::find(quint64 pid) const {
+    const QHash<quint64, int>::const_iterator it = m_index.constFind(pid);
+    return it == m_index.constEnd() ? nullptr : &m_stats[*it];
+}
+
+bool SocketDiagCollector::refresh() {
+#ifdef Q_OS_LINUX
+    if (m_socket < 0) return false;
+
+    const MonotonicNs now = MonotonicClock::now();
+    const MonotonicNs elapsed = m_lastRefresh > 0 ? now - m_lastRefresh : 0;
+    m_lastRefresh = now;
+
+    const bool ok = dump(AF_INET, IPPROTO_TCP, elapsed) && dump(AF_INET6, IPPROTO_TCP, elapsed)
+                 && dump(AF_INET, IPPROTO_UDP, elapsed) && dump(AF_INET6, IPPROTO_UDP, elapsed);
+    if (!ok) return false;
+
+    // 本轮没有出现的套接字已经关闭
+    for (QHash<quint32, SocketEntry>::iterator it = m_sockets.begin(); it != m_sockets.end();) {
+        if (it->generation != m_generation) {
+            it = m_sockets.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    ++m_generation;
+
+    resolveOwners(now);
+    buildStats();
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef Q_OS_LINUX
+void SocketDiagCollector::reopenSocket() {
+    if (m_socket >= 0) close(m_socket);
+    m_socket = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_SOCK_DIAG);
+}
+
+bool SocketDiagCollector::dump(int family, int protocol, MonotonicNs elapsed) {
+    struct {
+        struct nlmsghdr header;
+        struct inet_diag_req_v2 request;
+    } message;
+    memset(&message, 0, sizeof(message));
+    message.header.nlmsg_len = sizeof(message);
+    message.header.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+    message.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    message.request.sdiag_family = static_cast<__u8>(family);
+    message.request.sdiag_protocol = static_cast<__u8>(protocol);
+    message.request.idiag_states = ~0U;
+    if (protocol == IPPROTO_TCP) message.request.idiag_ext = 1 << (INET_DIAG_INFO - 1);
+
+    struct sockaddr_nl kernel;
+    memset(&kernel, 0, sizeof(kernel));
+    kernel.nl_family = AF_NETLINK;
+    if (sendto(m_socket, &message, sizeof(message), 0, reinterpret_cast<struct sockaddr *>(&kernel), sizeof(kernel)) < 0) {
+        reopenSocket();
+        return false;
+    }
+
+    const double elapsedSeconds = MonotonicClock::toSecs(elapsed);
+    for (;;) {
+        const ssize_t received = recv(m_socket, m_buffer.data(), m_buffer.size(), 0);
+        if (received < 0) {
+            if (errno == EINTR) continue;
+            // 导出中途失败（例如 ENOBUFS）时剩下的消息还留在套接字里，会被当成下一次请求的回复；
+            // 换一个新套接字丢掉它们，下一次 refresh() 重新导出
+            reopenSocket();
+            return false;
+        }
+
+        int remaining = static_cast<int>(received);
+        for (struct nlmsghdr *header = reinterpret_cast<struct nlmsghdr *>(m_buffer.data());
+             NLMSG_OK(header, remaining); header = NLMSG_NEXT(header, remaining)) {
+            if (header->nlmsg_type == NLMSG_DONE) return true;
+            if (header->nlmsg_type == NLMSG_ERROR) {
+                // 内核没有编译对应协议的 diag 模块（例如 udp_diag）时返回错误，当作没有该类套接字
+                return true;
+            }
+
+            const struct inet_diag_msg *diag = static_cast<const struct inet_diag_msg *>(NLMSG_DATA(header));
+            // TIME_WAIT 等已经脱离进程的套接字 inode 为 0
+            if (diag->idiag_inode == 0) continue;
+
+            SocketKind kind = Udp;
+            if (protocol == IPPROTO_TCP) {
+                kind = diag->idiag_state == TcpStateEstablished ? TcpConnected
+                     : diag->idiag_state == TcpStateListen ? TcpListening : TcpOther;
+            }
+
+            quint64 rxBytes = 0;
+            quint64 txBytes = 0;
+            int attributeLength = static_cast<int>(header->nlmsg_len - NLMSG_LENGTH(sizeof(*diag)));
+            for (const struct rtattr *attribute = reinterpret_cast<const struct rtattr *>(diag + 1);
+                 RTA_OK(attribute, attributeLength); attribute = RTA_NEXT(attribute, attributeLength)) {
+                if (attribute->rta_type != INET_DIAG_INFO) continue;
+                // bytes_acked / bytes_received 从 4.1 / 4.2 开始才有，老内核的 tcp_info 较短
+                if (RTA_PAYLOAD(attribute) < offsetof(struct tcp_info, tcpi_bytes_received) + sizeof(__u64)) continue;
+                struct tcp_info info;
+                memcpy(&info, RTA_DATA(attribute), qMin(static_cast<size_t>(RTA_PAYLOAD(attribute)), sizeof(info)));
+                rxBytes = info.tcpi_bytes_received;
+                txBytes = info.tcpi_bytes_acked;
+            }
+
+            QHash<quint32, SocketEntry>::iterator it = m_sockets.find(diag->idiag_inode);
+            if (it == m_sockets.end()) {
+                // 新套接字：建立计数基线，本轮速率记为 0
+                SocketEntry entry = { 0, kind, rxBytes, txBytes, 0.0, 0.0, 0, m_generation, m_generation };
+                m_sockets.insert(diag->idiag_inode, entry);
+                continue;
+            }
+            it->rxRate = elapsedSeconds > 0.0 && rxBytes >= it->rxBytes ? (rxBytes - it->rxBytes) / elapsedSeconds : 0.0;
+            it->txRate = elapsedSeconds > 0.0 && txBytes >= it->txBytes ? (txBytes - it->txBytes) / elapsedSeconds : 0.0;
+            it->rxBytes = rxBytes;
+            it->txBytes = txBytes;
+            it->kind = kind;
+            it->generation = m_generation;
+        }
+    }
+}
+
+void SocketDiagCollector::resolveOwners(MonotonicNs now) {
+    // 本轮刚出现的套接字不查找：连接频繁建立和关闭时，大部分在下一轮之前就已经关闭，
+    // 查找它们的代价是每轮都要读一遍 fd 目录；m_generation 此时已经指向下一轮
+    int pending = 0;
+    for (QHash<quint32, SocketEntry>::const_iterator it = m_sockets.constBegin(); it != m_sockets.constEnd(); ++it) {
+        if (it->pid == 0 && it->firstSeen + 1 < m_generation && it->retryAt <= now) ++pending;
+    }
+    if (pending == 0) return;
+
+    // 先查已经拥有套接字的进程（服务器进程不断建立新连接），再查其余进程，全部找到即停止
+    QVector<quint32> owners;
+    for (QHash<quint32, QString>::const_iterator it = m_names.constBegin(); it != m_names.constEnd(); ++it) {
+        owners.append(it.key());
+    }
+    for (quint32 pid : owners) {
+        pending = scanProcessFds(pid, pending);
+        if (pending == 0) break;
+    }
+    if (pending > 0 && now >= m_nextFullWalk) {
+        m_nextFullWalk = now + FullWalkInterval;
+        if (DIR *proc = opendir("/proc")) {
+            struct dirent *entry;
+            while (pending > 0 && (entry = readdir(proc)) != nullptr) {
+                const char *p = entry->d_name;
+                if (*p < '0' || *p > '9') continue;
+                quint32 pid = 0;
+                while (*p >= '0' && *p <= '9') pid = pid * 10 + static_cast<quint32>(*p++ - '0');
+                if (!m_names.contains(pid)) pending = scanProcessFds(pid, pending);
+            }
+            closedir(proc);
+        }
+    }
+
+    // 仍然没有找到的套接字等到下一次允许全量遍历时再查，期间也不再读已知进程的 fd 目录
+    for (QHash<quint32, SocketEntry>::iterator it = m_sockets.begin(); it != m_sockets.end(); ++it) {
+        if (it->pid == 0 && it->firstSeen + 1 < m_generation && it->retryAt <= now) it->retryAt = m_nextFullWalk;
+    }
+}
+
+int SocketDiagCollector::scanProcessFds(quint32 pid, int pending) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%u/fd", pid);
+    const int fdDir = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fdDir < 0) return pending; // 进程已退出，或属于其他用户
+    DIR *dir = fdopendir(fdDir);
+    if (!dir) {
+        close(fdDir);
+        return pending;
+    }
+
+    bool ownsSocket = false;
+    struct dirent *entry;
+    char link[64];
+    while ((entry = readdir(dir)) != nullptr) {
+        if (entry->d_name[0] == '.') continue;
+        const ssize_t length = readlinkat(fdDir, entry->d_name, link, sizeof(link) - 1);
+        // 套接字 fd 的链接目标为 "socket:[inode]"
+        if (length <= 8 || memcmp(link, "socket:[", 8) != 0) continue;
+        link[length] = '\0';
+        const quint32 inode = static_cast<quint32>(strtoul(link + 8, nullptr, 10));
+
+        QHash<quint32, SocketEntry>::iterator it = m_sockets.find(inode);
+        if (it == m_sockets.end() || it->pid != 0) continue;
+        it->pid = pid;
+        it->retryAt = 0;
+        ownsSocket = true;
+        if (pending > 0) --pending;
+    }
+    closedir(dir);
+
+    if (ownsSocket && !m_names.contains(pid)) {
+        snprintf(path, sizeof(path), "/proc/%u/comm", pid);
+        QString name;
+        if (m_commFile.readOnce(path)) {
+            size_t size = m_commFile.size();
+            while (size > 0 && m_commFile.data()[size - 1] == '\n') --size;
+            name = QString::fromUtf8(m_commFile.data(), static_cast<int>(size));
+        }
+        m_names.insert(pid, name);
+    }
+    return pending;
+}
+
+void SocketDiagCollector::buildStats() {
+    m_stats.clear();
+    m_index.clear();
+    for (QHash<quint32, SocketEntry>::const_iterator it = m_sockets.constBegin(); it != m_sockets.constEnd(); ++it) {
+        if (it->pid == 0) continue;
+        QHash<quint64, int>::iterator index = m_index.find(it->pid);
+        if (index == m_index.end()) {
+            ProcessNetworkStats stats;
+            stats.pid = it->pid;
+            stats.name = m_names.value(it->pid);
+            m_stats.append(stats);
+            index = m_index.insert(it->pid, m_stats.size() - 1);
+        }
+        ProcessNetworkStats &stats = m_stats[*index];
+        switch (it->kind) {
+        case TcpConnected: ++stats.tcpConnections; break;
+        case TcpListening: ++stats.tcpListening; break;
+        case TcpOther: break;
+        case Udp: ++stats.udpSockets; break;
+        }
+        stats.rxBytesPerSec += it->rxRate;
+        stats.txBytesPerSec += it->txRate;
+    }
+
+    // 不再拥有任何套接字的进程不再保留名称（PID 可能被复用）
+    for (QHash<quint32, QString>::iterator it = m_names.begin(); it != m_names.end();) {
+        if (!m_index.contains(it.key())) {
+            it = m_names.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    std::sort(m_stats.begin(), m_stats.end(), [](const ProcessNetworkStats &a, const ProcessNetworkStats &b) {
+        return a.rxBytesPerSec + a.txBytesPerSec > b.rxBytesPerSec + b.txBytesPerSec;
+    });
+    for (int i = 0; i < m_stats.size(); ++i) {
+        m_index[m_stats[i].pid] = i;
+    }
+}
+#endif
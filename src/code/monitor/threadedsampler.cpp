@@ -1,120 +1,309 @@
 // threadedsampler.cpp
 #include "src/include/monitor/threadedsampler.h"
 #include <QDebug>
-#include <QProcess>
+#include <QDeadlineTimer>
+#include <chrono>
+#include "src/include/common/monotonicclock.h"
+#ifdef Q_OS_LINUX
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
 
 // SamplerThread ʵ
-SamplerThread::SamplerThread(SamplerType type, QObject *parent)
+SamplerThread::SamplerThread(QObject *parent)
     : QThread(parent)
-    , m_type(type)
     , m_running(false)
-    , m_interval(1000) // Ĭ1
+#ifdef Q_OS_LINUX
+    , m_timerFd(timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC))
+    , m_wakeFd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+#endif
+    , m_pressureWake(false)
+    , m_published(std::make_shared<const SystemSnapshot>())
+    , m_droppedSamples(0)
 {
+    for (int i = 0; i < SamplerTypeCount; ++i) {
+        m_intervals[i] = 1000; // Ĭ1
+        m_deadlines[i] = 0;
+    }
 }
 
 SamplerThread::~SamplerThread()
 {
     stopSampling();
     wait(); // ȴ߳̽
+#ifdef Q_OS_LINUX
+    if (m_timerFd >= 0) ::close(m_timerFd);
+    if (m_wakeFd >= 0) ::close(m_wakeFd);
+#endif
 }
 
-void SamplerThread::setSamplingInterval(int msecs)
+void SamplerThread::setSamplingInterval(SamplerType type, int msecs)
 {
-    if (msecs > 0) {
+    if (msecs > 0 && type >= 0 && type < SamplerTypeCount) {
         QMutexLocker locker(&m_mutex);
-        m_interval = msecs;
+        m_intervals[type] = msecs;
     }
 }
 
+void SamplerThread::startSampling()
+{
+    // ߳ǰλ stopSampling()  run() 
+    m_running = true;
+#ifdef Q_OS_LINUX
+    // ߳δʱ stopSampling() ͬд뻽Ѽǰ̵߳һεȴͻ˳
+    quint64 pending = 0;
+    while (m_wakeFd >= 0 && ::read(m_wakeFd, &pending, sizeof(pending)) > 0) {}
+#endif
+    start();
+}
+
 void SamplerThread::stopSampling()
 {
-    QMutexLocker locker(&m_mutex);
     m_running = false;
+#ifdef Q_OS_LINUX
+    if (m_wakeFd >= 0) {
+        quint64 one = 1;
+        ssize_t written = ::write(m_wakeFd, &one, sizeof(one));
+        Q_UNUSED(written);
+    }
+#else
+    QMutexLocker locker(&m_mutex);
+    m_wakeCondition.wakeAll();
+#endif
+}
+
+bool SamplerThread::enablePressureTriggers(int stallMs, int windowMs)
+{
+    if (isRunning()) return false;
+    m_pressure.clearTriggers();
+    for (int i = 0; i < PressureResourceCount; ++i) {
+        m_pressure.addTrigger(static_cast<PressureResource>(i), false, stallMs, windowMs);
+    }
+    return !m_pressure.triggerFds().empty();
+}
+
+SchedulerJitterStats SamplerThread::jitterStats() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_jitter;
+}
+
+bool SamplerThread::waitUntil(qint64 deadlineNs)
+{
+#ifdef Q_OS_LINUX
+    if (m_timerFd < 0 || m_wakeFd < 0) {
+        // û timerfd ʱ˻Ϊʱ clock_nanosleep
+        struct timespec ts;
+        ts.tv_sec = deadlineNs / 1000000000LL;
+        ts.tv_nsec = deadlineNs % 1000000000LL;
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+        return m_running;
+    }
+
+    struct itimerspec spec = {};
+    spec.it_value.tv_sec = deadlineNs / 1000000000LL;
+    spec.it_value.tv_nsec = deadlineNs % 1000000000LL;
+    if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0) {
+        spec.it_value.tv_nsec = 1; // ȫ 0 ʾʱ
+    }
+    timerfd_settime(m_timerFd, TFD_TIMER_ABSTIME, &spec, nullptr);
+
+    // ʱֹ֪ͣͨԼ PressureResourceCount  PSI 
+    struct pollfd fds[2 + PressureResourceCount];
+    fds[0].fd = m_timerFd;
+    fds[0].events = POLLIN;
+    fds[1].fd = m_wakeFd;
+    fds[1].events = POLLIN;
+    nfds_t count = 2;
+    for (int fd : m_pressure.triggerFds()) {
+        fds[count].fd = fd;
+        fds[count].events = POLLPRI;
+        ++count;
+    }
+    m_pressureWake = false;
+    while (m_running) {
+        int ready = ::poll(fds, count, -1);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (fds[1].revents & POLLIN) return false;
+        if (fds[0].revents & POLLIN) {
+            quint64 expirations = 0;
+            ssize_t n = ::read(m_timerFd, &expirations, sizeof(expirations));
+            Q_UNUSED(n);
+            return m_running;
+        }
+        for (nfds_t i = 2; i < count; ++i) {
+            if (fds[i].revents & POLLPRI) m_pressureWake = true;
+        }
+        if (m_pressureWake) return m_running;
+    }
+    return false;
+#else
+    QMutexLocker locker(&m_mutex);
+    while (m_running) {
+        qint64 remainingNs = deadlineNs - MonotonicClock::now();
+        if (remainingNs <= 0) return true;
+        m_wakeCondition.wait(&m_mutex, QDeadlineTimer(std::chrono::nanoseconds(remainingNs), Qt::PreciseTimer));
+    }
+    return false;
+#endif
+}
+
+void SamplerThread::recordLateness(qint64 latenessNs, quint64 missed)
+{
+    QMutexLocker locker(&m_mutex);
+    m_jitter.wakeups++;
+    m_jitter.missedDeadlines += missed;
+    m_jitter.lastLatenessNs = latenessNs;
+    m_jitter.maxLatenessNs = qMax(m_jitter.maxLatenessNs, latenessNs);
+    m_jitter.meanLatenessNs += (latenessNs - m_jitter.meanLatenessNs) / m_jitter.wakeups;
 }
 
 void SamplerThread::run()
 {
-    m_running = true;
+    // ָͬһʱ̿ʼ룬ɱϵָͬһֹʱ
+    qint64 start = MonotonicClock::now();
+    for (int i = 0; i < SamplerTypeCount; ++i) {
+        m_deadlines[i] = start;
+    }
+    m_pressureWake = false;
     
     while (m_running) {
-        // ȡǰʱ
-        QDateTime timestamp = QDateTime::currentDateTime();
-        
-        // 
-        double value = sampleData();
+        // ռεڵָ꣬ǵĽֹʱ䰴Լƽ
+        qint64 now = MonotonicClock::now();
+        int dueMask = 0;
+        quint64 missed = 0;
+        if (m_pressureWake) {
+            // PSI ǰѣɼȫָ꣬ԵĽֹʱ䱣ֲ
+            dueMask = (1 << SamplerTypeCount) - 1;
+        } else {
+            QMutexLocker locker(&m_mutex);
+            for (int i = 0; i < SamplerTypeCount; ++i) {
+                if (m_deadlines[i] > now) continue;
+                dueMask |= 1 << i;
+                qint64 intervalNs = static_cast<qint64>(m_intervals[i]) * 1000000LL;
+                m_deadlines[i] += intervalNs;
+                // سʱʱѴĽֹʱ䣬
+                if (m_deadlines[i] <= now) {
+                    qint64 behind = (now - m_deadlines[i]) / intervalNs + 1;
+                    m_deadlines[i] += behind * intervalNs;
+                    missed += static_cast<quint64>(behind);
+                }
+            }
+        }
         
-        // ݵ
-        emit newDataPoint(value, timestamp);
+        if (dueMask) {
+            // ֻб߳дգֱһݵĻϸǵڵֶ
+            SystemSnapshot snapshot = *m_published;
+            snapshot.timestampNs = now;
+            sampleData(dueMask, snapshot);
+            std::atomic_store(&m_published, std::make_shared<const SystemSnapshot>(snapshot));
+            
+            if (dueMask & (1 << CPU)) pushSample(now, SampleMetricCpu, snapshot.cpuUsage);
+            if (dueMask & (1 << Memory)) pushSample(now, SampleMetricMemory, snapshot.memoryUsage);
+            if (dueMask & (1 << Disk)) pushSample(now, SampleMetricDisk, snapshot.diskIO);
+            if (dueMask & (1 << Network)) pushSample(now, SampleMetricNetwork, snapshot.networkUsage);
+        }
         
-        // ȡǰ
-        int currentInterval;
-        {
-            QMutexLocker locker(&m_mutex);
-            currentInterval = m_interval;
-            if (!m_running) break;
+        qint64 nextDeadline = m_deadlines[0];
+        for (int i = 1; i < SamplerTypeCount; ++i) {
+            nextDeadline = qMin(nextDeadline, m_deadlines[i]);
         }
         
-        // ָʱ
-        msleep(currentInterval);
+        if (!waitUntil(nextDeadline)) break;
+        if (!m_pressureWake) recordLateness(qMax<qint64>(0, MonotonicClock::now() - nextDeadline), missed);
     }
+    
+#ifdef Q_OS_LINUX
+    //  stopSampling() µĻѼ´ʱ˳
+    quint64 pending = 0;
+    while (m_wakeFd >= 0 && ::read(m_wakeFd, &pending, sizeof(pending)) > 0) {}
+#endif
 }
 
-double SamplerThread::sampleData()
+void SamplerThread::pushSample(qint64 timestampNs, quint32 metricId, double value)
 {
-    // ݼͲɼͬ
-    switch (m_type) {
-        case CPU:
-            return m_cpu.getCpuUsage();
-        case Memory:
-            return m_memory.getMemoryUsage();
-        case Disk:
-            return m_disk.getDiskIO();
-        case Network: {
-            QPair<quint64, quint64> usage = m_network.getNetworkUsageDetailed();
-            // ϴٶȵܺͣתΪMB/s
-            return static_cast<double>(usage.first + usage.second) / (1024.0 * 1024.0);
+    const SampleRecord record = { timestampNs, metricId, value };
+    // ߸ʱݵ㲢ɼ߳
+    if (!m_guiRing.push(record)) m_droppedSamples.fetch_add(1, std::memory_order_relaxed);
+    if (!m_storageRing.push(record)) m_droppedSamples.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SamplerThread::sampleData(int dueMask, SystemSnapshot &snapshot)
+{
+    // PSI ֻСļÿλѶȡ
+    if (m_pressure.refresh()) {
+        for (int i = 0; i < PressureResourceCount; ++i) {
+            snapshot.pressure[i] = m_pressure.stats(static_cast<PressureResource>(i));
         }
-        default:
-            return 0.0;
+    }
+
+    // ݵڵָɼͬ
+    if (dueMask & (1 << CPU)) {
+        snapshot.cpuUsage = m_cpu.getCpuUsage();
+        snapshot.cpuIowait = m_cpu.iowaitPercent();
+        snapshot.cpuSteal = m_cpu.stealPercent();
+        snapshot.coreUsage = m_cpu.coreUsage();
+        snapshot.coreIowait = m_cpu.coreIowait();
+        snapshot.coreSteal = m_cpu.coreSteal();
+        m_cpuSensors.refresh();
+        snapshot.cpuSensors = m_cpuSensors.stats();
+    }
+    if (dueMask & (1 << Memory)) {
+        if (m_memory.getMemoryStats(snapshot.memoryTotal, snapshot.memoryUsed)) {
+            snapshot.memoryFree = snapshot.memoryTotal - snapshot.memoryUsed;
+            snapshot.memoryUsage = snapshot.memoryTotal > 0 ? snapshot.memoryUsed * 100.0 / snapshot.memoryTotal : 0.0;
+        }
+        m_memory.getVmstatRates(snapshot.vmstat);
+    }
+    if (dueMask & (1 << Disk)) {
+        QPair<quint64, quint64> disk = m_disk.getDiskIODetailed();
+        snapshot.diskReadBytes = disk.first;
+        snapshot.diskWriteBytes = disk.second;
+        snapshot.diskIO = static_cast<double>(disk.first + disk.second) / (1024.0 * 1024.0);
+        snapshot.diskDevices = m_disk.deviceStats();
+    }
+    if (dueMask & (1 << Network)) {
+        QPair<quint64, quint64> usage = m_network.getNetworkUsageDetailed();
+        snapshot.networkUploadBytes = usage.first;
+        snapshot.networkDownloadBytes = usage.second;
+        // ϴٶȵܺͣתΪMB/s
+        snapshot.networkUsage = static_cast<double>(usage.first + usage.second) / (1024.0 * 1024.0);
+        snapshot.networkInterfaces = m_network.interfaceStats();
+        snapshot.networkProcesses = m_network.getProcessNetworkStats();
     }
 }
 
 // ThreadedSampler ʵ
 ThreadedSampler::ThreadedSampler(QObject *parent)
     : QObject(parent)
-    , m_cpuThread(nullptr)
-    , m_memoryThread(nullptr)
-    , m_diskThread(nullptr)
-    , m_networkThread(nullptr)
+    , m_collectorThread(nullptr)
     , m_gpuTimer(new QTimer(this))
+    , m_guiDrainTimer(new QTimer(this))
+    , m_storageDrainTimer(new QTimer(this))
     , m_storage(nullptr)
     , m_cpuChart(nullptr)
     , m_memChart(nullptr)
     , m_gpuChart(nullptr)
     , m_netChart(nullptr)
+    , m_gpuProbe(new GpuProbe(this))
     , m_gpuAvailable(false)
-    , m_lastCpuUsage(0.0)
-    , m_lastMemoryUsage(0.0)
-    , m_lastDiskIO(0.0)
-    , m_lastNetworkUsage(0.0)
 {
     // ߳
-    m_cpuThread = new SamplerThread(SamplerThread::CPU, this);
-    m_memoryThread = new SamplerThread(SamplerThread::Memory, this);
-    m_diskThread = new SamplerThread(SamplerThread::Disk, this);
-    m_networkThread = new SamplerThread(SamplerThread::Network, this);
-    
-    // źŲ
-    connect(m_cpuThread, &SamplerThread::newDataPoint, this, &ThreadedSampler::processCpuData);
-    connect(m_memoryThread, &SamplerThread::newDataPoint, this, &ThreadedSampler::processMemoryData);
-    connect(m_diskThread, &SamplerThread::newDataPoint, this, &ThreadedSampler::processDiskData);
-    connect(m_networkThread, &SamplerThread::newDataPoint, this, &ThreadedSampler::processNetworkData);
+    m_collectorThread = new SamplerThread(this);
     
-    // GPUʱ
-    connect(m_gpuTimer, &QTimer::timeout, this, &ThreadedSampler::checkGpuAvailability);
+    // ʹ洢԰ԼĽȡݵ
+    connect(m_guiDrainTimer, &QTimer::timeout, this, &ThreadedSampler::drainGuiSamples);
+    connect(m_storageDrainTimer, &QTimer::timeout, this, &ThreadedSampler::drainStorageSamples);
     
-    // GPU
-    checkGpuAvailability();
+    // GPUʱֻȡң⣬GPU  GpuProbe ں̨
+    connect(m_gpuTimer, &QTimer::timeout, this, &ThreadedSampler::sampleGpuStats);
+    connect(m_gpuProbe, &GpuProbe::gpuInfoChanged, this, &ThreadedSampler::handleGpuInfo);
 }
 
 ThreadedSampler::~ThreadedSampler()
@@ -124,34 +313,45 @@ ThreadedSampler::~ThreadedSampler()
 
 void ThreadedSampler::startSampling(int cpuInterval, int memoryInterval, int diskInterval, int networkInterval)
 {
-    // ø̲߳
-    m_cpuThread->setSamplingInterval(cpuInterval);
-    m_memoryThread->setSamplingInterval(memoryInterval);
-    m_diskThread->setSamplingInterval(diskInterval);
-    m_networkThread->setSamplingInterval(networkInterval);
+    // øָ
+    m_collectorThread->setSamplingInterval(SamplerThread::CPU, cpuInterval);
+    m_collectorThread->setSamplingInterval(SamplerThread::Memory, memoryInterval);
+    m_collectorThread->setSamplingInterval(SamplerThread::Disk, diskInterval);
+    m_collectorThread->setSamplingInterval(SamplerThread::Network, networkInterval);
     
     // ߳
-    if (!m_cpuThread->isRunning()) m_cpuThread->start();
-    if (!m_memoryThread->isRunning()) m_memoryThread->start();
-    if (!m_diskThread->isRunning()) m_diskThread->start();
-    if (!m_networkThread->isRunning()) m_networkThread->start();
+    if (!m_collectorThread->isRunning()) m_collectorThread->startSampling();
     
-    // GPUʱ
-    m_gpuTimer->start(5000); // ÿ5һGPU
+    // Լÿ 100ms ˢһΣ洢ÿдһ
+    m_guiDrainTimer->start(100);
+    m_storageDrainTimer->start(1000);
+    
+    // GPU̽Ͷʱ
+    m_gpuTimer->start(5000); // ÿ5ȡһGPUң
+    m_gpuProbe->start();
+    if (m_gpuProbe->hasResult()) {
+        configureGpuTelemetry(m_gpuProbe->info());
+    }
     
 
 }
 
 void ThreadedSampler::stopSampling()
 {
-    // ֹͣ߳
-    m_cpuThread->stopSampling();
-    m_memoryThread->stopSampling();
-    m_diskThread->stopSampling();
-    m_networkThread->stopSampling();
+    // ֹͣɼ߳
+    m_collectorThread->stopSampling();
+    m_collectorThread->wait();
+    m_guiDrainTimer->stop();
+    m_storageDrainTimer->stop();
     
-    // ֹͣGPUʱ
+    // ֹͣǰѲɼݵд洢
+    drainStorageSamples();
+    
+    // ֹͣGPUʱңӽ
     m_gpuTimer->stop();
+    if (m_gpuTelemetry) {
+        m_gpuTelemetry->stop();
+    }
     
 
 }
@@ -169,199 +369,124 @@ void ThreadedSampler::setChartWidgets(ChartWidget *cpu, ChartWidget *mem, ChartW
     m_netChart = net;
 }
 
-void ThreadedSampler::processCpuData(double value, const QDateTime &timestamp)
+bool ThreadedSampler::enablePressureTriggers(int stallMs, int windowMs)
 {
-    qDebug() << "[ThreadedSampler] processCpuData called, value:" << value << ", timestamp:" << timestamp;
-    QMutexLocker locker(&m_dataMutex);
-    m_lastCpuUsage = value;
-    
-    // ͼ
-    if (m_cpuChart) {
-        m_cpuChart->updateValue(value);
-    }
-    
-    // 洢
-    if (m_storage) {
-        qDebug() << "[ThreadedSampler] storeSample: CPU";
-        m_storage->storeSample("CPU", value, timestamp);
-    }
-    
-    // ź
-    emit cpuUsageUpdated(value);
-    
-    // ݸź
-    emit performanceDataUpdated(m_lastCpuUsage, m_lastMemoryUsage, m_lastDiskIO, m_lastNetworkUsage);
+    return m_collectorThread->enablePressureTriggers(stallMs, windowMs);
 }
 
-void ThreadedSampler::processMemoryData(double value, const QDateTime &timestamp)
+void ThreadedSampler::drainGuiSamples()
 {
-    qDebug() << "[ThreadedSampler] processMemoryData called, value:" << value << ", timestamp:" << timestamp;
-    QMutexLocker locker(&m_dataMutex);
-    m_lastMemoryUsage = value;
+    // ֻÿֵָͬһнݵֱ
+    SampleRecord batch[256];
+    double latest[SampleMetricCount] = {};
+    int seenMask = 0;
+    size_t count;
+    while ((count = m_collectorThread->guiRing().popBatch(batch, 256)) > 0) {
+        for (size_t i = 0; i < count; ++i) {
+            if (batch[i].metricId >= SampleMetricCount) continue;
+            latest[batch[i].metricId] = batch[i].value;
+            seenMask |= 1 << batch[i].metricId;
+        }
+    }
+    if (!seenMask) return;
     
-    // ȡϸڴϢ
-    MemoryMonitor memMonitor;
-    quint64 totalMem = memMonitor.getTotalMemory();
-    quint64 usedMem = memMonitor.getUsedMemory();
-    quint64 freeMem = totalMem - usedMem;
+    std::shared_ptr<const SystemSnapshot> s = lastSnapshot();
     
-    // ͼ
-    if (m_memChart) {
-        m_memChart->updateValue(value);
+    if (seenMask & (1 << SampleMetricCpu)) {
+        // ͼ
+        if (m_cpuChart) {
+            m_cpuChart->updateValue(latest[SampleMetricCpu]);
+        }
+        // ź
+        emit cpuUsageUpdated(latest[SampleMetricCpu]);
     }
     
-    // 洢
-    if (m_storage) {
-        qDebug() << "[ThreadedSampler] storeSample: Memory";
-        m_storage->storeSample("Memory", value, timestamp);
+    if (seenMask & (1 << SampleMetricMemory)) {
+        if (m_memChart) {
+            m_memChart->updateValue(latest[SampleMetricMemory]);
+        }
+        emit memoryStatsUpdated(s->memoryTotal, s->memoryUsed, s->memoryFree);
     }
     
-    // ź
-    emit memoryStatsUpdated(totalMem, usedMem, freeMem);
-    
-    // ݸź
-    emit performanceDataUpdated(m_lastCpuUsage, m_lastMemoryUsage, m_lastDiskIO, m_lastNetworkUsage);
-}
-
-void ThreadedSampler::processDiskData(double value, const QDateTime &timestamp)
-{
-    qDebug() << "[ThreadedSampler] processDiskData called, value:" << value << ", timestamp:" << timestamp;
-    QMutexLocker locker(&m_dataMutex);
-    m_lastDiskIO = value;
-    
-    // IOǶдٶȵܺͣǽƽд
-    qint64 readBytes = static_cast<qint64>(value * 1024 * 1024 / 2); // תΪֽ
-    qint64 writeBytes = readBytes;
-    
-    // 洢
-    if (m_storage) {
-        qDebug() << "[ThreadedSampler] storeSample: Disk";
-        m_storage->storeSample("Disk", value, timestamp);
+    if (seenMask & (1 << SampleMetricDisk)) {
+        emit diskStatsUpdated(static_cast<qint64>(s->diskReadBytes), static_cast<qint64>(s->diskWriteBytes));
     }
     
-    // ź
-    emit diskStatsUpdated(readBytes, writeBytes);
+    if (seenMask & (1 << SampleMetricNetwork)) {
+        if (m_netChart) {
+            m_netChart->updateValue(latest[SampleMetricNetwork]);
+        }
+        emit networkStatsUpdated(s->networkUploadBytes / (1024.0 * 1024.0), s->networkDownloadBytes / (1024.0 * 1024.0));
+    }
     
     // ݸź
-    emit performanceDataUpdated(m_lastCpuUsage, m_lastMemoryUsage, m_lastDiskIO, m_lastNetworkUsage);
+    emit performanceDataUpdated(s->cpuUsage, s->memoryUsage, s->diskIO, s->networkUsage);
 }
 
-void ThreadedSampler::processNetworkData(double value, const QDateTime &timestamp)
+void ThreadedSampler::drainStorageSamples()
 {
-    qDebug() << "[ThreadedSampler] processNetworkData called, value:" << value << ", timestamp:" << timestamp;
-    QMutexLocker locker(&m_dataMutex);
-    m_lastNetworkUsage = value;
-    
-    // ȡϸϢ
-    NetworkMonitor netMonitor;
-    QPair<quint64, quint64> networkUsage = netMonitor.getNetworkUsageDetailed();
-    double uploadSpeed = static_cast<double>(networkUsage.first) / (1024.0 * 1024.0); // תΪMB
-    double downloadSpeed = static_cast<double>(networkUsage.second) / (1024.0 * 1024.0); // תΪMB
+    // 洢Ҫȫݵ㣬ܳһһд롣
+    // øãresize Сʱͷ֮ػλС·
+    m_storageBatch.resize(static_cast<int>(SamplerThread::SampleRing::capacity()));
+    size_t count = m_collectorThread->storageRing().popBatch(m_storageBatch.data(), m_storageBatch.size());
+    m_storageBatch.resize(static_cast<int>(count));
+    if (count == 0) return;
     
-    // ͼ
-    if (m_netChart) {
-        m_netChart->updateValue(value);
-    }
-    
-    // 洢
     if (m_storage) {
-        qDebug() << "[ThreadedSampler] storeSample: Network";
-        m_storage->storeSample("Network", value, timestamp);
+        m_storage->storeSamples(m_storageBatch);
     }
-    
-    // ź
-    emit networkStatsUpdated(uploadSpeed, downloadSpeed);
-    
-    // ݸź
-    emit performanceDataUpdated(m_lastCpuUsage, m_lastMemoryUsage, m_lastDiskIO, m_lastNetworkUsage);
 }
 
 void ThreadedSampler::checkGpuAvailability()
 {
-    bool wasAvailable = m_gpuAvailable;
-    QString oldGpuName = m_gpuName;
-    QString oldDriverVersion = m_driverVersion;
-
-    m_gpuAvailable = detectGpu();
-
-    if (m_gpuAvailable != wasAvailable || 
-        m_gpuName != oldGpuName || 
-        m_driverVersion != oldDriverVersion) {
-        emit gpuAvailabilityChanged(m_gpuAvailable, m_gpuName, m_driverVersion);
-    }
-    
-    if (m_gpuAvailable) {
-        sampleGpuStats();
-    }
+    m_gpuProbe->requestProbe();
 }
 
-bool ThreadedSampler::detectGpu()
+void ThreadedSampler::handleGpuInfo(const GpuInfo &info)
 {
-    // ʹ nvidia-smi  NVIDIA GPU
-    QProcess process;
-    process.start("nvidia-smi", QStringList() << "--query-gpu=name,driver_version" << "--format=csv,noheader");
-    
-    if (!process.waitForFinished(3000)) {
-        return false;
-    }
-
-    if (process.exitCode() != 0) {
-        return false;
+    const QString name = info.available ? info.name : QString();
+    const QString driverVersion = info.available ? info.driverVersion : QString();
+    if (m_gpuTimer->isActive()) {
+        configureGpuTelemetry(info);
     }
-
-    QString output = process.readAllStandardOutput().trimmed();
-    if (output.isEmpty()) {
-        return false;
+    if (info.available != m_gpuAvailable || name != m_gpuName || driverVersion != m_driverVersion) {
+        m_gpuAvailable = info.available;
+        m_gpuName = name;
+        m_driverVersion = driverVersion;
+        emit gpuAvailabilityChanged(m_gpuAvailable, m_gpuName, m_driverVersion);
     }
+}
 
-    QStringList parts = output.split(",");
-    if (parts.size() >= 2) {
-        m_gpuName = parts[0].trimmed();
-        m_driverVersion = parts[1].trimmed();
-        return true;
+void ThreadedSampler::configureGpuTelemetry(const GpuInfo &info)
+{
+    // ңԴֻ̽仯ʼʱ򿪣ʱÿֻȡѾ򿪵Դ
+    m_gpuTelemetry = GpuTelemetrySource::create(info);
+    if (m_gpuTelemetry) {
+        m_gpuTelemetry->start(m_gpuTimer->interval());
     }
-
-    return false;
 }
 
 void ThreadedSampler::sampleGpuStats()
 {
-    qDebug() << "[ThreadedSampler] sampleGpuStats called.";
-    QProcess process;
-    process.start("nvidia-smi", QStringList() 
-        << "--query-gpu=utilization.gpu,temperature.gpu,memory.used,memory.total" 
-        << "--format=csv,noheader,nounits");
-    
-    if (!process.waitForFinished(3000)) {
-        qDebug() << "[ThreadedSampler] nvidia-smi did not finish.";
+    if (!m_gpuAvailable) {
         return;
     }
 
-    if (process.exitCode() != 0) {
-        qDebug() << "[ThreadedSampler] nvidia-smi exit code != 0.";
+    GpuSample sample;
+    if (!m_gpuTelemetry || !m_gpuTelemetry->read(sample)) {
         return;
     }
 
-    QString output = process.readAllStandardOutput().trimmed();
-    QStringList parts = output.split(",");
-    
-    if (parts.size() >= 4) {
-        double usage = parts[0].trimmed().toDouble();
-        double temperature = parts[1].trimmed().toDouble();
-        quint64 memoryUsed = parts[2].trimmed().toULongLong() * 1024 * 1024; // MiB to bytes
-        quint64 memoryTotal = parts[3].trimmed().toULongLong() * 1024 * 1024; // MiB to bytes
-
-        emit gpuStatsUpdated(usage, temperature, memoryUsed, memoryTotal);
+    emit gpuStatsUpdated(sample.usage, sample.temperature, sample.memoryUsed, sample.memoryTotal);
 
-        //  GPU ͼ
-        if (m_gpuChart) {
-            m_gpuChart->updateValue(usage);
-        }
+    //  GPU ͼ
+    if (m_gpuChart) {
+        m_gpuChart->updateValue(sample.usage);
+    }
 
-        // 洢 GPU 
-        if (m_storage) {
-            qDebug() << "[ThreadedSampler] storeSample: GPU";
-            m_storage->storeSample("GPU", usage);
-        }
+    // 洢 GPU 
+    if (m_storage) {
+        qDebug() << "[ThreadedSampler] storeSample: GPU";
+        m_storage->storeSample("GPU", sample.usage);
     }
 }
\ No newline at end of file
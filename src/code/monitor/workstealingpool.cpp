@@ -0,0 +1,105 @@
+// workstealingpool.cpp
+#include "src/include/monitor/workstealingpool.h"
+
+WorkStealingPool::WorkStealingPool(int threadCount) {
+    const int count = qMax(1, threadCount);
+    for (int i = 0; i < count; ++i) {
+        m_queues.emplace_back(new TaskQueue);
+    }
+    for (int i = 1; i < count; ++i) {
+        m_threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (std::thread &thread : m_threads) {
+        thread.join();
+    }
+}
+
+void WorkStealingPool::run(int taskCount, const TaskFunction &fn) {
+    if (taskCount <= 0) return;
+
+    // 任务轮流分到各线程的队列，相邻任务落在不同线程上
+    const int count = threadCount();
+    for (int task = 0; task < taskCount; ++task) {
+        TaskQueue &queue = *m_queues[task % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(task);
+    }
+
+    if (count > 1) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_function = &fn;
+            m_busyWorkers = count - 1;
+            ++m_round;
+        }
+        m_wake.notify_all();
+    }
+
+    drain(0, fn);
+
+    if (count > 1) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_finished.wait(lock, [this] { return m_busyWorkers == 0; });
+        m_function = nullptr;
+    }
+}
+
+void WorkStealingPool::workerLoop(int worker) {
+    quint64 seenRound = 0;
+    for (;;) {
+        const TaskFunction *fn;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stopping || m_round != seenRound; });
+            if (m_stopping) return;
+            seenRound = m_round;
+            fn = m_function;
+        }
+
+        drain(worker, *fn);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_busyWorkers == 0) {
+            m_finished.notify_one();
+        }
+    }
+}
+
+void WorkStealingPool::drain(int worker, const TaskFunction &fn) {
+    // 任务不会在执行过程中新增，所有队列都取空即可退出
+    int task;
+    while (popLocal(worker, task) || steal(worker, task)) {
+        fn(task, worker);
+    }
+}
+
+bool WorkStealingPool::popLocal(int worker, int &task) {
+    TaskQueue &queue = *m_queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    task = queue.tasks.back();
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(int worker, int &task) {
+    const int count = threadCount();
+    for (int i = 1; i < count; ++i) {
+        TaskQueue &victim = *m_queues[(worker + i) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
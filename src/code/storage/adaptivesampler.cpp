@@ -106,7 +106,7 @@ double AdaptiveSampler::getDeltaThreshold() const
     return m_deltaThreshold;
 }
 
-bool AdaptiveSampler::addDataPoint(const QString &metricName, double value, const QDateTime &timestamp)
+bool AdaptiveSampler::addDataPoint(const QString &metricName, double value, MonotonicNs timestamp)
 {
     QMutexLocker locker(&m_mutex);
     
@@ -126,14 +126,14 @@ bool AdaptiveSampler::addDataPoint(const QString &metricName, double value, cons
     return shouldStore;
 }
 
-QVector<QPair<QDateTime, double>> AdaptiveSampler::compressData(const QVector<QPair<QDateTime, double>> &data)
+QVector<QPair<MonotonicNs, double>> AdaptiveSampler::compressData(const QVector<QPair<MonotonicNs, double>> &data)
 {
     QMutexLocker locker(&m_mutex);
     
     // 更新原始数据大小统计
-    m_originalDataSize += data.size() * (sizeof(QDateTime) + sizeof(double));
+    m_originalDataSize += data.size() * (sizeof(MonotonicNs) + sizeof(double));
     
-    QVector<QPair<QDateTime, double>> compressedData;
+    QVector<QPair<MonotonicNs, double>> compressedData;
     
     // 根据选择的压缩算法进行压缩
     switch (m_compressionAlgorithm) {
@@ -153,7 +153,7 @@ QVector<QPair<QDateTime, double>> AdaptiveSampler::compressData(const QVector<QP
     }
     
     // 更新压缩后数据大小统计
-    m_compressedDataSize += compressedData.size() * (sizeof(QDateTime) + sizeof(double));
+    m_compressedDataSize += compressedData.size() * (sizeof(MonotonicNs) + sizeof(double));
     
     // 发出压缩率变化信号
     if (m_originalDataSize > 0) {
@@ -164,11 +164,11 @@ QVector<QPair<QDateTime, double>> AdaptiveSampler::compressData(const QVector<QP
     return compressedData;
 }
 
-QVector<QPair<QDateTime, double>> AdaptiveSampler::decompressData(const QVector<QPair<QDateTime, double>> &compressedData)
+QVector<QPair<MonotonicNs, double>> AdaptiveSampler::decompressData(const QVector<QPair<MonotonicNs, double>> &compressedData)
 {
     QMutexLocker locker(&m_mutex);
     
-    QVector<QPair<QDateTime, double>> decompressedData;
+    QVector<QPair<MonotonicNs, double>> decompressedData;
     
     // 根据选择的压缩算法进行解压
     switch (m_compressionAlgorithm) {
@@ -232,25 +232,25 @@ void AdaptiveSampler::reset()
     qDebug() << "重置采样器状态";
 }
 
-bool AdaptiveSampler::shouldSample(const QString &metricName, double value, const QDateTime &timestamp)
+bool AdaptiveSampler::shouldSample(const QString &metricName, double value, MonotonicNs timestamp)
 {
     // 如果是第一个数据点，总是采样
     if (!m_lastDataPoints.contains(metricName)) {
         return true;
     }
     
-    const QPair<QDateTime, double> &lastPoint = m_lastDataPoints[metricName];
+    const QPair<MonotonicNs, double> &lastPoint = m_lastDataPoints[metricName];
     
     // 根据不同的采样策略决定是否采样
     switch (m_samplingStrategy) {
         case FixedRate: {
             // 固定采样率：检查是否达到采样间隔
-            qint64 elapsed = lastPoint.first.msecsTo(timestamp);
+            qint64 elapsed = MonotonicClock::toMSecs(timestamp - lastPoint.first);
             return elapsed >= m_baseSamplingInterval;
         }
         case AdaptiveRate: {
             // 自适应采样率：检查是否达到当前采样间隔
-            qint64 elapsed = lastPoint.first.msecsTo(timestamp);
+            qint64 elapsed = MonotonicClock::toMSecs(timestamp - lastPoint.first);
             int currentInterval = m_currentIntervals.value(metricName, m_baseSamplingInterval);
             return elapsed >= currentInterval;
         }
@@ -323,21 +323,21 @@ void AdaptiveSampler::updateAdaptiveInterval(const QString &metricName, double v
     }
 }
 
-QVector<QPair<QDateTime, double>> AdaptiveSampler::runLengthEncode(const QVector<QPair<QDateTime, double>> &data)
+QVector<QPair<MonotonicNs, double>> AdaptiveSampler::runLengthEncode(const QVector<QPair<MonotonicNs, double>> &data)
 {
     if (data.isEmpty()) {
-        return QVector<QPair<QDateTime, double>>();
+        return QVector<QPair<MonotonicNs, double>>();
     }
     
-    QVector<QPair<QDateTime, double>> compressed;
+    QVector<QPair<MonotonicNs, double>> compressed;
     
     // 游程编码：连续相同值只保留首尾
     double currentValue = data.first().second;
-    QDateTime startTime = data.first().first;
-    QDateTime endTime = startTime;
+    MonotonicNs startTime = data.first().first;
+    MonotonicNs endTime = startTime;
     
     for (int i = 1; i < data.size(); ++i) {
-        const QPair<QDateTime, double> &point = data[i];
+        const QPair<MonotonicNs, double> &point = data[i];
         
         // 如果值相同（允许微小误差），更新结束时间
         if (std::abs(point.second - currentValue) < 0.000001) {
@@ -360,18 +360,18 @@ QVector<QPair<QDateTime, double>> AdaptiveSampler::runLengthEncode(const QVector
     return compressed;
 }
 
-QVector<QPair<QDateTime, double>> AdaptiveSampler::runLengthDecode(const QVector<QPair<QDateTime, double>> &compressedData)
+QVector<QPair<MonotonicNs, double>> AdaptiveSampler::runLengthDecode(const QVector<QPair<MonotonicNs, double>> &compressedData)
 {
     if (compressedData.isEmpty() || compressedData.size() % 2 != 0) {
         return compressedData; // 如果数据为空或不是偶数个点（格式错误），直接返回
     }
     
-    QVector<QPair<QDateTime, double>> decompressed;
+    QVector<QPair<MonotonicNs, double>> decompressed;
     
     // 游程解码：根据首尾时间和值，生成中间点
     for (int i = 0; i < compressedData.size(); i += 2) {
-        QDateTime startTime = compressedData[i].first;
-        QDateTime endTime = compressedData[i + 1].first;
+        MonotonicNs startTime = compressedData[i].first;
+        MonotonicNs endTime = compressedData[i + 1].first;
         double value = compressedData[i].second;
         
         // 添加起始点
@@ -380,9 +380,9 @@ QVector<QPair<QDateTime, double>> AdaptiveSampler::runLengthDecode(const QVector
         // 如果起始时间和结束时间不同，添加中间点
         if (startTime != endTime) {
             // 计算中间点数量（假设原始采样间隔为1秒）
-            qint64 seconds = startTime.secsTo(endTime);
+            qint64 seconds = (endTime - startTime) / MonotonicClock::NsPerSec;
             for (qint64 j = 1; j < seconds; ++j) {
-                QDateTime middleTime = startTime.addSecs(j);
+                MonotonicNs middleTime = startTime + MonotonicClock::fromSecs(j);
                 decompressed.append(qMakePair(middleTime, value));
             }
             
@@ -394,19 +394,19 @@ QVector<QPair<QDateTime, double>> AdaptiveSampler::runLengthDecode(const QVector
     return decompressed;
 }
 
-QVector<QPair<QDateTime, double>> AdaptiveSampler::deltaEncode(const QVector<QPair<QDateTime, double>> &data)
+QVector<QPair<MonotonicNs, double>> AdaptiveSampler::deltaEncode(const QVector<QPair<MonotonicNs, double>> &data)
 {
     if (data.isEmpty()) {
-        return QVector<QPair<QDateTime, double>>();
+        return QVector<QPair<MonotonicNs, double>>();
     }
     
-    QVector<QPair<QDateTime, double>> compressed;
+    QVector<QPair<MonotonicNs, double>> compressed;
     
     // 增量编码：存储第一个点的绝对值，后续点存储与前一点的差值
     compressed.append(data.first());
     
     for (int i = 1; i < data.size(); ++i) {
-        QDateTime timestamp = data[i].first;
+        MonotonicNs timestamp = data[i].first;
         double delta = data[i].second - data[i - 1].second;
         compressed.append(qMakePair(timestamp, delta));
     }
@@ -414,20 +414,20 @@ QVector<QPair<QDateTime, double>> AdaptiveSampler::deltaEncode(const QVector<QPa
     return compressed;
 }
 
-QVector<QPair<QDateTime, double>> AdaptiveSampler::deltaDecode(const QVector<QPair<QDateTime, double>> &compressedData)
+QVector<QPair<MonotonicNs, double>> AdaptiveSampler::deltaDecode(const QVector<QPair<MonotonicNs, double>> &compressedData)
 {
     if (compressedData.isEmpty()) {
-        return QVector<QPair<QDateTime, double>>();
+        return QVector<QPair<MonotonicNs, double>>();
     }
     
-    QVector<QPair<QDateTime, double>> decompressed;
+    QVector<QPair<MonotonicNs, double>> decompressed;
     
     // 增量解码：第一个点是绝对值，后续点通过累加差值恢复
     decompressed.append(compressedData.first());
     double currentValue = compressedData.first().second;
     
     for (int i = 1; i < compressedData.size(); ++i) {
-        QDateTime timestamp = compressedData[i].first;
+        MonotonicNs timestamp = compressedData[i].first;
         currentValue += compressedData[i].second; // 累加差值
         decompressed.append(qMakePair(timestamp, currentValue));
     }
@@ -435,13 +435,13 @@ QVector<QPair<QDateTime, double>> AdaptiveSampler::deltaDecode(const QVector<QPa
     return decompressed;
 }
 
-QVector<QPair<QDateTime, double>> AdaptiveSampler::piecewiseCompress(const QVector<QPair<QDateTime, double>> &data)
+QVector<QPair<MonotonicNs, double>> AdaptiveSampler::piecewiseCompress(const QVector<QPair<MonotonicNs, double>> &data)
 {
     if (data.size() <= 2) {
         return data; // 如果点数太少，不压缩
     }
     
-    QVector<QPair<QDateTime, double>> compressed;
+    QVector<QPair<MonotonicNs, double>> compressed;
     
     // 分段线性压缩：保留关键点，使用直线近似中间点
     compressed.append(data.first()); // 添加第一个点
@@ -449,15 +449,15 @@ QVector<QPair<QDateTime, double>> AdaptiveSampler::piecewiseCompress(const QVect
     int startIdx = 0;
     for (int i = 2; i < data.size(); ++i) {
         // 计算当前线段（从startIdx到i-1）的斜率
-        double x1 = data[startIdx].first.toMSecsSinceEpoch();
+        double x1 = data[startIdx].first / static_cast<double>(MonotonicClock::NsPerMs);
         double y1 = data[startIdx].second;
-        double x2 = data[i - 1].first.toMSecsSinceEpoch();
+        double x2 = data[i - 1].first / static_cast<double>(MonotonicClock::NsPerMs);
         double y2 = data[i - 1].second;
         
         double slope = (y2 - y1) / (x2 - x1 + 0.000001); // 避免除以零
         
         // 计算当前点到线段的垂直距离
-        double x = data[i].first.toMSecsSinceEpoch();
+        double x = data[i].first / static_cast<double>(MonotonicClock::NsPerMs);
         double y = data[i].second;
         double expectedY = y1 + slope * (x - x1);
         double distance = std::abs(y - expectedY);
@@ -474,18 +474,18 @@ QVector<QPair<QDateTime, double>> AdaptiveSampler::piecewiseCompress(const QVect
     return compressed;
 }
 
-QVector<QPair<QDateTime, double>> AdaptiveSampler::piecewiseDecompress(const QVector<QPair<QDateTime, double>> &compressedData)
+QVector<QPair<MonotonicNs, double>> AdaptiveSampler::piecewiseDecompress(const QVector<QPair<MonotonicNs, double>> &compressedData)
 {
     if (compressedData.size() <= 1) {
         return compressedData;
     }
     
-    QVector<QPair<QDateTime, double>> decompressed;
+    QVector<QPair<MonotonicNs, double>> decompressed;
     
     // 分段线性解压：根据关键点之间的线性关系，插值生成中间点
     for (int i = 0; i < compressedData.size() - 1; ++i) {
-        QDateTime startTime = compressedData[i].first;
-        QDateTime endTime = compressedData[i + 1].first;
+        MonotonicNs startTime = compressedData[i].first;
+        MonotonicNs endTime = compressedData[i + 1].first;
         double startValue = compressedData[i].second;
         double endValue = compressedData[i + 1].second;
         
@@ -495,11 +495,11 @@ QVector<QPair<QDateTime, double>> AdaptiveSampler::piecewiseDecompress(const QVe
         // 如果起始时间和结束时间不同，添加中间点
         if (startTime != endTime) {
             // 计算中间点数量（假设原始采样间隔为1秒）
-            qint64 seconds = startTime.secsTo(endTime);
+            qint64 seconds = (endTime - startTime) / MonotonicClock::NsPerSec;
             double valueStep = (endValue - startValue) / seconds;
             
             for (qint64 j = 1; j < seconds; ++j) {
-                QDateTime middleTime = startTime.addSecs(j);
+                MonotonicNs middleTime = startTime + MonotonicClock::fromSecs(j);
                 double middleValue = startValue + valueStep * j;
                 decompressed.append(qMakePair(middleTime, middleValue));
             }
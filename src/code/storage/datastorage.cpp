@@ -6,6 +6,7 @@
 #include <QTextStream>
 #include <QDebug>
 #include <QDir>
+#include <QSqlRecord>
 
 DataStorage::DataStorage(QObject *parent)
     : QObject(parent)
@@ -113,13 +114,20 @@ bool DataStorage::createTables()
     );
     qDebug() << "[DataStorage] samples table created:" << samplesTableCreated;
     
+    // 旧版本只有 ISO 文本格式的 timestamp 列，补一个毫秒整数列，新数据只写这一列
+    if (samplesTableCreated && !db.record("samples").contains("timestamp_ms")) {
+        bool columnAdded = query.exec("ALTER TABLE samples ADD COLUMN timestamp_ms INTEGER");
+        qDebug() << "[DataStorage] samples.timestamp_ms column added:" << columnAdded;
+    }
+    query.exec("CREATE INDEX IF NOT EXISTS idx_samples_timestamp_ms ON samples (timestamp_ms)");
+    
     return systemTableCreated && samplesTableCreated;
 }
 
 void DataStorage::storeData(double cpuUsage, double memoryUsage, double diskUsage, double networkUpload, double networkDownload)
 {
     SystemData data;
-    data.timestamp = QDateTime::currentDateTime();
+    data.timestamp = MonotonicClock::now();
     data.cpuUsage = cpuUsage;
     data.diskUsage = diskUsage;
     data.memoryUsage = memoryUsage;
@@ -150,16 +158,20 @@ bool DataStorage::exportSystemData(const QString &filename, const QDateTime &sta
     
     out << "time,CPU,Memory,Disk,Network,GPU\n";
 
+    // 时间范围只换算一次，逐条比较的是整数
+    const MonotonicNs startNs = startTime.isValid() ? MonotonicClock::fromDateTime(startTime) : 0;
+    const MonotonicNs endNs = endTime.isValid() ? MonotonicClock::fromDateTime(endTime) : 0;
+
     // 写入数据
     for (const SystemData &data : m_systemData) {
         // 如果指定了时间范围，检查数据是否在范围内
-        if (startTime.isValid() && data.timestamp < startTime) continue;
-        if (endTime.isValid() && data.timestamp > endTime) continue;
+        if (startTime.isValid() && data.timestamp < startNs) continue;
+        if (endTime.isValid() && data.timestamp > endNs) continue;
 
         // 计算网络总流量 (上传+下载)
         double networkTotal = (data.networkUpload + data.networkDownload) / 1024.0;
         
-        out << data.timestamp.toString("yyyy-MM-dd :mm:ss") << ","
+        out << MonotonicClock::toDateTime(data.timestamp).toString("yyyy-MM-dd :mm:ss") << ","
             << QString::number(data.cpuUsage, 'f', 4) << ","
             << QString::number(data.memoryUsage, 'f', 4) << ","
             << QString::number(data.diskUsage, 'f', 2) << ","
@@ -179,7 +191,24 @@ void DataStorage::clear()
 void DataStorage::storeSample(const QString &type, double value)
 {
     // 使用当前时间戳调用重载方法
-    storeSample(type, value, QDateTime::currentDateTime());
+    storeSample(type, value, MonotonicClock::now());
+}
+
+void DataStorage::storeSample(const QString &type, double value, MonotonicNs timestamp)
+{
+    storeSample(type, value, MonotonicClock::toDateTime(timestamp));
+}
+
+bool DataStorage::insertSample(QSqlQuery &query, const QString &type, double value, qint64 wallMs)
+{
+    query.bindValue(0, type);
+    query.bindValue(1, value);
+    query.bindValue(2, wallMs);
+    if (!query.exec()) {
+        qWarning() << "[DataStorage] 无法存储样本:" << query.lastError().text();
+        return false;
+    }
+    return true;
 }
 
 void DataStorage::storeSample(const QString &type, double value, const QDateTime &timestamp)
@@ -190,13 +219,8 @@ void DataStorage::storeSample(const QString &type, double value, const QDateTime
     }
     qDebug() << "[DataStorage] storeSample called, type:" << type << ", value:" << value << ", timestamp:" << timestamp;
     QSqlQuery query(db);
-    query.prepare("INSERT INTO samples (type, value, timestamp) VALUES (?, ?, ?)");
-    query.bindValue(0, type);
-    query.bindValue(1, value);
-    query.bindValue(2, timestamp.toString(Qt::ISODate));
-    if (!query.exec()) {
-        qWarning() << "[DataStorage] 无法存储样本:" << query.lastError().text();
-    } else {
+    query.prepare("INSERT INTO samples (type, value, timestamp_ms) VALUES (?, ?, ?)");
+    if (insertSample(query, type, value, timestamp.toMSecsSinceEpoch())) {
         qDebug() << "[DataStorage] storeSample success.";
     }
     // 如果是GPU数据，更新最后一条系统数据的GPU使用率
@@ -204,3 +228,24 @@ void DataStorage::storeSample(const QString &type, double value, const QDateTime
         m_systemData.last().gpuUsage = value;
     }
 }
+
+void DataStorage::storeSamples(const QVector<SampleRecord> &samples)
+{
+    if (samples.isEmpty()) return;
+    if (!m_isInitialized) {
+        qWarning() << "[DataStorage] 数据存储未初始化，无法存储样本";
+        return;
+    }
+
+    db.transaction();
+    QSqlQuery query(db);
+    query.prepare("INSERT INTO samples (type, value, timestamp_ms) VALUES (?, ?, ?)");
+    for (const SampleRecord &sample : samples) {
+        insertSample(query, QString::fromLatin1(sampleMetricName(sample.metricId)), sample.value,
+                     MonotonicClock::toMSecsSinceEpoch(sample.timestampNs));
+    }
+    if (!db.commit()) {
+        qWarning() << "[DataStorage] 批量写入提交失败:" << db.lastError().text();
+        db.rollback();
+    }
+}
@@ -20,9 +20,11 @@ bool Exporter::exportToCsv(const QString &dbPath, const QString &csvPath,
             return false;
         }
 
-        QString queryStr = "SELECT type, value, timestamp FROM samples";
+        // 新数据只有整数列 timestamp_ms，旧数据只有 ISO 文本列 timestamp，两种都要兼容
+        QString queryStr = "SELECT type, value, timestamp, timestamp_ms FROM samples";
         if (from.isValid() && to.isValid()) {
-            queryStr += " WHERE timestamp BETWEEN '" + from.toString(Qt::ISODate) + "' AND '" + to.toString(Qt::ISODate) + "'";
+            queryStr += " WHERE timestamp_ms BETWEEN " + QString::number(from.toMSecsSinceEpoch()) + " AND " + QString::number(to.toMSecsSinceEpoch())
+                      + " OR (timestamp_ms IS NULL AND timestamp BETWEEN '" + from.toString(Qt::ISODate) + "' AND '" + to.toString(Qt::ISODate) + "')";
         }
 
         QFile file(csvPath);
@@ -44,9 +46,13 @@ bool Exporter::exportToCsv(const QString &dbPath, const QString &csvPath,
                 return false;
             }
             while (query.next()) {
+                // 墙上时间只在导出这一步格式化
+                QString timestamp = query.value(3).isNull()
+                    ? query.value(2).toString()
+                    : QDateTime::fromMSecsSinceEpoch(query.value(3).toLongLong()).toString(Qt::ISODate);
                 out << query.value(0).toString() << ","
                     << QString::number(query.value(1).toDouble(), 'f', 4) << ","
-                    << query.value(2).toString() << "\n";
+                    << timestamp << "\n";
             }
         }
         file.close();
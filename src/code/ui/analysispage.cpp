@@ -273,16 +273,21 @@ void AnalysisPage::updateAnomalyData(double cpuUsage, double memoryUsage, double
     emit anomalyUpdated(QString("Anomaly Data Updated: CPU %1%, Mem %2%").arg(cpuUsage).arg(memoryUsage));
 }
 
+void AnalysisPage::updatePagingData(double majorFaults, double swapPages, double directReclaimPages, double oomKills)
+{
+    // ҳڴһ֣ڴ⿪
+    if (!m_performMemoryCheck) {
+        return;
+    }
+    m_anomalyDetector->addPagingDataPoint(majorFaults, swapPages, directReclaimPages, oomKills);
+    m_anomalyDetector->detectPagingAnomaly(m_currentAnomalyThreshold);
+}
+
 void AnalysisPage::updatePerformanceData(double cpuUsage, double memoryUsage, double diskIO, double networkUsage)
 {
     // Performance data update without debug logging
+    // addDataPoint ڲѾƿƷﲻظ
     m_performanceAnalyzer->addDataPoint(cpuUsage, memoryUsage, diskIO, networkUsage);
-    // Trigger analysis, e.g., for bottleneck or trends
-    m_performanceAnalyzer->analyzeBottleneck();
-    m_performanceAnalyzer->analyzeCpuTrend();
-    m_performanceAnalyzer->analyzeMemoryTrend();
-    m_performanceAnalyzer->analyzeDiskTrend();
-    m_performanceAnalyzer->analyzeNetworkTrend();
     emit performanceUpdated(QString("Performance Data Updated: CPU %1%, Mem %2%").arg(cpuUsage).arg(memoryUsage));
 }
 
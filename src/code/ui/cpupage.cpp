@@ -1,11 +1,17 @@
 #include "src/include/ui/cpupage.h"
 #include <QPainter>
-#include <windows.h>
 #include <QGroupBox>
 #include <QProgressBar>
-#include <intrin.h>
 #include <QProcess>
 #include <QRegularExpression>
+#include <QHeaderView>
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <intrin.h>
+#elif defined(Q_OS_LINUX)
+#include <QFile>
+#include <unistd.h>
+#endif
 
 QT_USE_NAMESPACE
 
@@ -22,10 +28,21 @@ CpuPage::CpuPage(QWidget *parent)
     , m_coresLabel(new QLabel("CPU核心数: 0", this))
     , m_modelLabel(new QLabel("CPU型号: 未知", this))
     , m_freqLabel(new QLabel("CPU频率: 获取中...", this))
+    , m_tempLabel(new QLabel("封装温度: --", this))
     , m_archLabel(new QLabel("CPU架构: x86-64", this))
+    , m_coreGroup(nullptr)
+    , m_coreChart(nullptr)
+    , m_busiestCoreLabel(new QLabel("最忙核心: --", this))
+    , m_iowaitLabel(new QLabel("I/O等待: --", this))
+    , m_stealLabel(new QLabel("Steal: --", this))
+    , m_freqGroup(nullptr)
+    , m_freqChart(nullptr)
+    , m_coreTableGroup(nullptr)
+    , m_coreTable(nullptr)
 {
     setupUI();
     
+#ifdef Q_OS_WIN
     connect(m_updateTimer, &QTimer::timeout, this, &CpuPage::updateCpuData);
     m_updateTimer->start(1000);
     
@@ -51,6 +68,24 @@ CpuPage::CpuPage(QWidget *parent)
     }
     
     m_modelLabel->setText(QString("CPU型号: %1").arg(cpuBrandString));
+#elif defined(Q_OS_LINUX)
+    // Linux 下的使用率由 Sampler 推送，这里只读取一次静态信息
+    m_coresLabel->setText(QString("CPU核心数: %1").arg(sysconf(_SC_NPROCESSORS_ONLN)));
+
+    QFile cpuinfo("/proc/cpuinfo");
+    if (cpuinfo.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        while (!cpuinfo.atEnd()) {
+            QByteArray line = cpuinfo.readLine();
+            if (line.startsWith("model name")) {
+                int colon = line.indexOf(':');
+                if (colon >= 0) {
+                    m_modelLabel->setText(QString("CPU型号: %1").arg(QString::fromUtf8(line.mid(colon + 1).trimmed())));
+                }
+                break;
+            }
+        }
+    }
+#endif
 }
 
 void CpuPage::setupUI()
@@ -133,8 +168,61 @@ void CpuPage::setupUI()
     infoLayout->addWidget(m_freqLabel);
     infoLayout->addWidget(m_archLabel);
     
+    // 封装温度，没有温度传感器时不显示
+    m_tempLabel->setStyleSheet("QLabel { color: #333333; font-size: 10pt; }");
+    m_tempLabel->hide();
+    infoLayout->addWidget(m_tempLabel);
+    
+    m_busiestCoreLabel->setStyleSheet("QLabel { color: #333333; font-size: 10pt; }");
+    m_iowaitLabel->setStyleSheet("QLabel { color: #333333; font-size: 10pt; }");
+    m_stealLabel->setStyleSheet("QLabel { color: #333333; font-size: 10pt; }");
+    infoLayout->addWidget(m_busiestCoreLabel);
+    infoLayout->addWidget(m_iowaitLabel);
+    infoLayout->addWidget(m_stealLabel);
+    
+    // 每核使用率图表框，收到第一份每核数据后才显示
+    // 核数多时逐核画线开销随核数增长，图表固定只画最低/平均/最高三条曲线
+    const QStringList bandNames = {tr("最低"), tr("平均"), tr("最高")};
+    m_coreGroup = new QGroupBox(this);
+    m_coreGroup->setTitle(tr("每核使用率"));
+    m_coreGroup->setStyleSheet("QGroupBox { background-color: white; border-radius: 8px; border: 1px solid #e0e0e0; font-weight: bold; }");
+    QVBoxLayout *coreLayout = new QVBoxLayout(m_coreGroup);
+    m_coreChart = new ChartWidget(tr("使用率 (%)"), m_coreGroup);
+    m_coreChart->setYRange(0, 100);
+    m_coreChart->setSeriesNames(bandNames);
+    coreLayout->addWidget(m_coreChart);
+    m_coreGroup->hide();
+    
+    // 每核频率图表框，收到第一份频率数据后才显示
+    m_freqGroup = new QGroupBox(this);
+    m_freqGroup->setTitle(tr("每核频率"));
+    m_freqGroup->setStyleSheet("QGroupBox { background-color: white; border-radius: 8px; border: 1px solid #e0e0e0; font-weight: bold; }");
+    QVBoxLayout *freqLayout = new QVBoxLayout(m_freqGroup);
+    m_freqChart = new ChartWidget(tr("频率 (MHz)"), m_freqGroup);
+    m_freqChart->setSeriesNames(bandNames);
+    freqLayout->addWidget(m_freqChart);
+    m_freqGroup->hide();
+    
+    // 每核详情表，与每核使用率图表同时显示
+    m_coreTableGroup = new QGroupBox(this);
+    m_coreTableGroup->setTitle(tr("每核详情"));
+    m_coreTableGroup->setStyleSheet("QGroupBox { background-color: white; border-radius: 8px; border: 1px solid #e0e0e0; font-weight: bold; }");
+    QVBoxLayout *coreTableLayout = new QVBoxLayout(m_coreTableGroup);
+    m_coreTable = new QTableWidget(m_coreTableGroup);
+    m_coreTable->setColumnCount(5);
+    m_coreTable->setHorizontalHeaderLabels({"核心", "使用率", "I/O等待", "Steal", "频率"});
+    m_coreTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    m_coreTable->verticalHeader()->setVisible(false);
+    m_coreTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_coreTable->setSelectionMode(QAbstractItemView::NoSelection);
+    coreTableLayout->addWidget(m_coreTable);
+    m_coreTableGroup->hide();
+    
     // 添加所有组件到主布局
     mainLayout->addWidget(chartGroup);
+    mainLayout->addWidget(m_coreGroup);
+    mainLayout->addWidget(m_freqGroup);
+    mainLayout->addWidget(m_coreTableGroup);
     mainLayout->addWidget(cpuUsageFrame);
     mainLayout->addWidget(cpuInfoFrame);
 }
@@ -146,6 +234,7 @@ CpuPage::~CpuPage()
 
 void CpuPage::updateCpuData()
 {
+#ifdef Q_OS_WIN
     static FILETIME prevIdleTime = {0};
     static FILETIME prevKernelTime = {0};
     static FILETIME prevUserTime = {0};
@@ -174,6 +263,145 @@ void CpuPage::updateCpuData()
     prevKernelTime = kernelTime;
     prevUserTime = userTime;
     
+    applyUsage(cpuUsage);
+    
+    // 尝试获取CPU频率 (示例实现，实际可能需要WMI查询)
+    static int counter = 0;
+    if (counter++ % 5 == 0) { // 每5秒更新一次
+        QProcess process;
+        process.start("wmic", QStringList() << "cpu" << "get" << "currentclockspeed" << "/format:list");
+        if (process.waitForFinished(3000)) {
+            QString output = process.readAllStandardOutput();
+            // 解析输出格式: CurrentClockSpeed=xxxx
+            QRegularExpression regex("CurrentClockSpeed=(\\d+)");
+            QRegularExpressionMatch match = regex.match(output);
+            if (match.hasMatch()) {
+                int freq = match.captured(1).toInt();
+                if (freq > 0) {
+                    m_freqLabel->setText(QString("CPU频率: %1 MHz").arg(freq));
+                }
+            } else {
+                // 尝试备用命令，使用PowerShell获取
+                QProcess psProcess;
+                psProcess.start("powershell", QStringList() << "-Command" << "Get-WmiObject Win32_Processor | Select-Object CurrentClockSpeed");
+                if (psProcess.waitForFinished(3000)) {
+                    QString psOutput = psProcess.readAllStandardOutput();
+                    QRegularExpression psRegex("(\\d+)");
+                    QRegularExpressionMatch psMatch = psRegex.match(psOutput);
+                    if (psMatch.hasMatch()) {
+                        int freq = psMatch.captured(1).toInt();
+                        if (freq > 0) {
+                            m_freqLabel->setText(QString("CPU频率: %1 MHz").arg(freq));
+                        }
+                    }
+                }
+            }
+        }
+    }
+#endif
+}
+
+void CpuPage::updateCoreData(const QVector<double> &usage, const QVector<double> &iowait, const QVector<double> &steal)
+{
+    if (usage.isEmpty()) return;
+
+    // 每核权重相同，各核均值即为总体使用率
+    double total = 0.0;
+    int busiest = 0;
+    int idlest = 0;
+    for (int i = 0; i < usage.size(); ++i) {
+        total += usage[i];
+        if (usage[i] > usage[busiest]) busiest = i;
+        if (usage[i] < usage[idlest]) idlest = i;
+    }
+    const double average = total / usage.size();
+    applyUsage(average);
+
+    if (m_coreTable->rowCount() != usage.size()) {
+        m_coresLabel->setText(QString("CPU核心数: %1").arg(usage.size()));
+        ensureCoreRows(usage.size());
+    }
+    if (m_coreGroup->isHidden()) {
+        m_coreGroup->show();
+        m_coreTableGroup->show();
+    }
+    m_coreChart->updateValues({usage[idlest], average, usage[busiest]});
+
+    for (int i = 0; i < usage.size(); ++i) {
+        setCoreCell(i, 1, QString("%1%").arg(usage[i], 0, 'f', 1));
+        setCoreCell(i, 2, i < iowait.size() ? QString("%1%").arg(iowait[i], 0, 'f', 1) : QString("-"));
+        setCoreCell(i, 3, i < steal.size() ? QString("%1%").arg(steal[i], 0, 'f', 1) : QString("-"));
+    }
+
+    double iowaitSum = 0.0;
+    for (double v : iowait) iowaitSum += v;
+    double stealSum = 0.0;
+    for (double v : steal) stealSum += v;
+
+    m_busiestCoreLabel->setText(QString("最忙核心: CPU%1 (%2%)").arg(busiest).arg(usage[busiest], 0, 'f', 1));
+    m_iowaitLabel->setText(QString("I/O等待: %1%").arg(iowait.isEmpty() ? 0.0 : iowaitSum / iowait.size(), 0, 'f', 1));
+    m_stealLabel->setText(QString("Steal: %1%").arg(steal.isEmpty() ? 0.0 : stealSum / steal.size(), 0, 'f', 1));
+}
+
+void CpuPage::updateSensorData(const CpuSensorStats &stats)
+{
+    if (stats.frequencyValid && !stats.coreFrequencyMHz.isEmpty()) {
+        if (m_freqGroup->isHidden()) {
+            // 多曲线模式不自动缩放，按额定最高频率固定纵轴；读不到额定值时按当前最高频率留出余量
+            const double top = stats.ratedMaxFrequencyMHz > 0 ? stats.ratedMaxFrequencyMHz : stats.maxFrequencyMHz * 1.5;
+            m_freqChart->setYRange(0, top);
+            m_freqGroup->show();
+        }
+        // 最低/最高取自读取成功的核，不计离线核的 0
+        m_freqChart->updateValues({stats.minFrequencyMHz, stats.averageFrequencyMHz, stats.maxFrequencyMHz});
+
+        const QVector<double> &freq = stats.coreFrequencyMHz;
+        ensureCoreRows(qMax(m_coreTable->rowCount(), int(freq.size())));
+        for (int i = 0; i < freq.size(); ++i) {
+            setCoreCell(i, 4, freq[i] > 0 ? QString("%1 MHz").arg(freq[i], 0, 'f', 0) : QString("-"));
+        }
+
+        QString text = QString("CPU频率: %1 MHz (%2 - %3 MHz)")
+            .arg(stats.averageFrequencyMHz, 0, 'f', 0)
+            .arg(stats.minFrequencyMHz, 0, 'f', 0)
+            .arg(stats.maxFrequencyMHz, 0, 'f', 0);
+        if (stats.ratedMaxFrequencyMHz > 0) {
+            text += QString(", 最高 %1 MHz").arg(stats.ratedMaxFrequencyMHz, 0, 'f', 0);
+        }
+        m_freqLabel->setText(text);
+    }
+
+    if (stats.temperatureValid) {
+        m_tempLabel->setText(QString("封装温度: %1°C (%2)").arg(stats.packageTemperature, 0, 'f', 1).arg(stats.temperatureSource));
+        m_tempLabel->show();
+    } else {
+        m_tempLabel->hide();
+    }
+}
+
+void CpuPage::ensureCoreRows(int count)
+{
+    const int oldCount = m_coreTable->rowCount();
+    if (oldCount == count) return;
+    m_coreTable->setRowCount(count);
+    for (int row = oldCount; row < count; ++row) {
+        setCoreCell(row, 0, QString("CPU%1").arg(row));
+    }
+}
+
+void CpuPage::setCoreCell(int row, int column, const QString &text)
+{
+    // 复用已有单元格，避免每秒为每个核重新创建 QTableWidgetItem
+    QTableWidgetItem *item = m_coreTable->item(row, column);
+    if (item) {
+        if (item->text() != text) item->setText(text);
+    } else {
+        m_coreTable->setItem(row, column, new QTableWidgetItem(text));
+    }
+}
+
+void CpuPage::applyUsage(double cpuUsage)
+{
     // 更新数据
     m_data.append(cpuUsage);
     if (m_data.size() > 60) {
@@ -212,40 +440,6 @@ void CpuPage::updateCpuData()
     
     usageStyle += "border-radius: 5px;}";
     m_usageBar->setStyleSheet(usageStyle);
-    
-    // 尝试获取CPU频率 (示例实现，实际可能需要WMI查询)
-    static int counter = 0;
-    if (counter++ % 5 == 0) { // 每5秒更新一次
-        QProcess process;
-        process.start("wmic", QStringList() << "cpu" << "get" << "currentclockspeed" << "/format:list");
-        if (process.waitForFinished(3000)) {
-            QString output = process.readAllStandardOutput();
-            // 解析输出格式: CurrentClockSpeed=xxxx
-            QRegularExpression regex("CurrentClockSpeed=(\\d+)");
-            QRegularExpressionMatch match = regex.match(output);
-            if (match.hasMatch()) {
-                int freq = match.captured(1).toInt();
-                if (freq > 0) {
-                    m_freqLabel->setText(QString("CPU频率: %1 MHz").arg(freq));
-                }
-            } else {
-                // 尝试备用命令，使用PowerShell获取
-                QProcess psProcess;
-                psProcess.start("powershell", QStringList() << "-Command" << "Get-WmiObject Win32_Processor | Select-Object CurrentClockSpeed");
-                if (psProcess.waitForFinished(3000)) {
-                    QString psOutput = psProcess.readAllStandardOutput();
-                    QRegularExpression psRegex("(\\d+)");
-                    QRegularExpressionMatch psMatch = psRegex.match(psOutput);
-                    if (psMatch.hasMatch()) {
-                        int freq = psMatch.captured(1).toInt();
-                        if (freq > 0) {
-                            m_freqLabel->setText(QString("CPU频率: %1 MHz").arg(freq));
-                        }
-                    }
-                }
-            }
-        }
-    }
 }
 
 void CpuPage::setupCharts() {
@@ -1,6 +1,8 @@
 #include "src/include/ui/diskpage.h"
 #include <QPainter>
+#ifdef Q_OS_WIN
 #include <windows.h>
+#endif
 #include <QVBoxLayout>
 #include <QHeaderView>
 
@@ -89,7 +91,8 @@ void DiskPage::setupUI()
     progressLayout->addWidget(m_diskProgressBar);
     mainLayout->addWidget(m_progressFrame);
 
-    // 设置表格
+    // 设置表格（第 4 列固定为百分比，进度条和图表都从这一列取值）
+#ifdef Q_OS_WIN
     m_diskTable->setColumnCount(5);
     m_diskTable->setHorizontalHeaderLabels(QStringList() 
         << "盘符" 
@@ -97,6 +100,16 @@ void DiskPage::setupUI()
         << "已用空间" 
         << "可用空间"
         << "使用率");
+#else
+    m_diskTable->setColumnCount(6);
+    m_diskTable->setHorizontalHeaderLabels(QStringList()
+        << "设备"
+        << "IOPS (读/写)"
+        << "吞吐 (读/写)"
+        << "平均等待 (读/写)"
+        << "利用率"
+        << "队列深度");
+#endif
     m_diskTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
     m_diskTable->setStyleSheet(
         "QTableWidget {"
@@ -114,13 +127,14 @@ void DiskPage::setupUI()
     mainLayout->addWidget(m_diskTable);
 
     connect(m_diskTable, &QTableWidget::cellClicked, this, [=](int row, int){
-        QString detail = tr("盘符: %1\n总容量: %2\n已用空间: %3\n可用空间: %4\n使用率: %5")
-            .arg(m_diskTable->item(row,0)->text())
-            .arg(m_diskTable->item(row,1)->text())
-            .arg(m_diskTable->item(row,2)->text())
-            .arg(m_diskTable->item(row,3)->text())
-            .arg(m_diskTable->item(row,4)->text());
-        m_detailLabel->setText(detail);
+        // 按表头逐列拼出详细信息，两个平台的列不同
+        QStringList lines;
+        for (int column = 0; column < m_diskTable->columnCount(); ++column) {
+            lines << QString("%1: %2")
+                .arg(m_diskTable->horizontalHeaderItem(column)->text())
+                .arg(m_diskTable->item(row, column)->text());
+        }
+        m_detailLabel->setText(lines.join("\n"));
         
         // 更新所选磁盘的进度条
         QString usageText = m_diskTable->item(row, 4)->text();
@@ -177,12 +191,23 @@ QString DiskPage::formatSize(qint64 bytes)
 
 void DiskPage::updateDiskData()
 {
+#ifdef Q_OS_WIN
+    updateDiskTable();
+    updateDiskChart();
+#endif
+    // Linux 下表格和图表由 updateDeviceData() 随采样刷新
+}
+
+void DiskPage::updateDeviceData(const QVector<DiskDeviceStats> &devices)
+{
+    m_devices = devices;
     updateDiskTable();
     updateDiskChart();
 }
 
 void DiskPage::updateDiskTable()
 {
+#ifdef Q_OS_WIN
     DWORD drives = GetLogicalDrives();
     QList<QPair<QString, ULARGE_INTEGER>> diskInfo;
     
@@ -220,6 +245,25 @@ void DiskPage::updateDiskTable()
         m_diskTable->setItem(i, 3, new QTableWidgetItem(formatSize(freeBytes.QuadPart)));
         m_diskTable->setItem(i, 4, new QTableWidgetItem(QString::number(usagePercent, 'f', 1) + "%"));
     }
+#else
+    m_diskTable->setRowCount(m_devices.size());
+
+    for (int i = 0; i < m_devices.size(); i++) {
+        const DiskDeviceStats &dev = m_devices[i];
+        m_diskTable->setItem(i, 0, new QTableWidgetItem(dev.name));
+        m_diskTable->setItem(i, 1, new QTableWidgetItem(QString("%1 / %2")
+            .arg(dev.readIops, 0, 'f', 1)
+            .arg(dev.writeIops, 0, 'f', 1)));
+        m_diskTable->setItem(i, 2, new QTableWidgetItem(QString("%1/s / %2/s")
+            .arg(formatSize(static_cast<qint64>(dev.readBytesPerSec)))
+            .arg(formatSize(static_cast<qint64>(dev.writeBytesPerSec)))));
+        m_diskTable->setItem(i, 3, new QTableWidgetItem(QString("%1 / %2 ms")
+            .arg(dev.readAwaitMs, 0, 'f', 2)
+            .arg(dev.writeAwaitMs, 0, 'f', 2)));
+        m_diskTable->setItem(i, 4, new QTableWidgetItem(QString::number(dev.utilization, 'f', 1) + "%"));
+        m_diskTable->setItem(i, 5, new QTableWidgetItem(QString::number(dev.queueDepth, 'f', 2)));
+    }
+#endif
     
     // 如果有选中的行，更新进度条
     QModelIndexList selectedRows = m_diskTable->selectionModel()->selectedRows();
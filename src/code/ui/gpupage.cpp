@@ -77,6 +77,17 @@ void GpuPage::setupUi()
     gpuDriverLabel->setStyleSheet("QLabel { color: #333333; font-size: 11pt; }");
     statusLayout->addWidget(gpuDriverLabel);
     
+    // 创建功耗和进程显存标签，来源不支持时隐藏
+    gpuPowerLabel = new QLabel(gpuStatusFrame);
+    gpuPowerLabel->setStyleSheet("QLabel { color: #333333; font-size: 11pt; }");
+    gpuPowerLabel->setVisible(false);
+    statusLayout->addWidget(gpuPowerLabel);
+    
+    gpuProcessLabel = new QLabel(gpuStatusFrame);
+    gpuProcessLabel->setStyleSheet("QLabel { color: #555555; font-size: 10pt; }");
+    gpuProcessLabel->setVisible(false);
+    statusLayout->addWidget(gpuProcessLabel);
+    
     // 添加状态框到主布局
     verticalLayout->addWidget(gpuStatusFrame);
     
@@ -344,6 +355,35 @@ void GpuPage::handleGpuAvailabilityChange(bool available, const QString &gpuName
         gpuTempLabel->setText("0°C");
         gpuMemoryBar->setValue(0);
         gpuMemoryLabel->setText("0 / 0");
+        gpuPowerLabel->setVisible(false);
+        gpuProcessLabel->setVisible(false);
+    }
+}
+
+void GpuPage::updateGpuTelemetry(const GpuSample &sample)
+{
+    if (sample.power > 0) {
+        gpuPowerLabel->setText("功耗：" + QString::number(sample.power, 'f', 1) + " W");
+        gpuPowerLabel->setVisible(true);
+    } else {
+        gpuPowerLabel->setVisible(false);
+    }
+    
+    // 只显示显存占用最多的几个进程，列表已按显存从大到小排序
+    if (!sample.processes.isEmpty()) {
+        const int shown = qMin(static_cast<int>(sample.processes.size()), 5);
+        QStringList lines;
+        for (int i = 0; i < shown; ++i) {
+            const GpuProcessMemory &process = sample.processes.at(i);
+            lines << QString("PID %1：%2").arg(process.pid).arg(formatMemorySize(process.memoryUsed));
+        }
+        if (sample.processes.size() > shown) {
+            lines << QString("另有 %1 个进程").arg(sample.processes.size() - shown);
+        }
+        gpuProcessLabel->setText("显存占用进程：\n" + lines.join("\n"));
+        gpuProcessLabel->setVisible(true);
+    } else {
+        gpuProcessLabel->setVisible(false);
     }
 }
 
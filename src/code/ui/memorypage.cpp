@@ -1,7 +1,12 @@
 #include "src/include/ui/memorypage.h"
 #include <QPainter>
-#include <windows.h>
 #include <QGroupBox>
+#include <QHeaderView>
+#ifdef Q_OS_WIN
+#include <windows.h>
+#elif defined(Q_OS_LINUX)
+#include <QFile>
+#endif
 
 QT_USE_NAMESPACE
 
@@ -18,6 +23,17 @@ MemoryPage::MemoryPage(QWidget *parent)
     , m_usagePercentLabel(new QLabel("内存使用率: 0%", this))
     , m_memTypeLabel(new QLabel("内存类型: DDR4", this))
     , m_pageFileLabel(new QLabel("页面文件: 0 GB", this))
+#ifdef Q_OS_LINUX
+    , m_memoryMonitor(new MemoryMonitor(this))
+    , m_processMonitor(nullptr)
+    , m_processTimer(new QTimer(this))
+    , m_processTable(new QTableWidget(this))
+    , m_processSummaryLabel(new QLabel(this))
+    , m_pagingChart(new QChart())
+    , m_pagingChartView(new QChartView(m_pagingChart))
+    , m_pagingAxisY(new QValueAxis)
+    , m_reclaimLabel(new QLabel(this))
+#endif
 {
     setupUI();
     connect(m_updateTimer, &QTimer::timeout, this, &MemoryPage::updateMemoryData);
@@ -26,12 +42,30 @@ MemoryPage::MemoryPage(QWidget *parent)
     // 获取内存类型信息（简化处理，实际应从WMI或其他系统API获取）
     m_memTypeLabel->setText("内存类型: DDR4");
     
+#ifdef Q_OS_WIN
     // 获取页面文件信息
     MEMORYSTATUSEX memInfo;
     memInfo.dwLength = sizeof(MEMORYSTATUSEX);
     GlobalMemoryStatusEx(&memInfo);
     quint64 pageFileTotal = memInfo.ullTotalPageFile;
     m_pageFileLabel->setText(QString("页面文件: %1").arg(formatSize(pageFileTotal)));
+#elif defined(Q_OS_LINUX)
+    QFile meminfo("/proc/meminfo");
+    if (meminfo.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        while (!meminfo.atEnd()) {
+            QByteArray line = meminfo.readLine();
+            if (line.startsWith("SwapTotal:")) {
+                const quint64 swapKb = line.mid(10).trimmed().split(' ').value(0).toULongLong();
+                m_pageFileLabel->setText(QString("交换区: %1").arg(formatSize(swapKb * 1024)));
+                break;
+            }
+        }
+    }
+
+    // smaps_rollup 的读取间隔由 ProcessMonitor 按耗时自行调整，这里只决定表格的刷新频率
+    connect(m_processTimer, &QTimer::timeout, this, &MemoryPage::updateProcessMemory);
+    m_processTimer->start(5000);
+#endif
 }
 
 MemoryPage::~MemoryPage()
@@ -135,10 +169,61 @@ void MemoryPage::setupUI()
     mainLayout->addWidget(chartGroup);
     mainLayout->addWidget(memUsageFrame);
     mainLayout->addWidget(memInfoFrame);
+
+#ifdef Q_OS_LINUX
+    // 进程内存占用框
+    QGroupBox *processGroup = new QGroupBox(this);
+    processGroup->setTitle(tr("进程内存占用 (PSS)"));
+    processGroup->setStyleSheet("QGroupBox { background-color: white; border-radius: 8px; border: 1px solid #e0e0e0; font-weight: bold; }");
+    QVBoxLayout *processLayout = new QVBoxLayout(processGroup);
+
+    m_processTable->setColumnCount(6);
+    m_processTable->setHorizontalHeaderLabels({"进程名", "PID", "RSS", "PSS", "独占 (USS)", "交换区"});
+    m_processTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    m_processTable->verticalHeader()->setVisible(false);
+    m_processTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_processTable->setSelectionMode(QAbstractItemView::NoSelection);
+    m_processSummaryLabel->setStyleSheet("QLabel { color: #666666; font-size: 9pt; font-weight: normal; }");
+    processLayout->addWidget(m_processTable);
+    processLayout->addWidget(m_processSummaryLabel);
+
+    mainLayout->addWidget(processGroup);
+
+    // 分页与回收速率图表框
+    QGroupBox *pagingGroup = new QGroupBox(this);
+    pagingGroup->setTitle(tr("分页与回收"));
+    pagingGroup->setStyleSheet("QGroupBox { background-color: white; border-radius: 8px; border: 1px solid #e0e0e0; font-weight: bold; }");
+    QVBoxLayout *pagingLayout = new QVBoxLayout(pagingGroup);
+
+    QValueAxis *pagingAxisX = new QValueAxis;
+    pagingAxisX->setRange(0, 60);
+    pagingAxisX->setTitleText("时间 (秒)");
+    m_pagingChart->addAxis(pagingAxisX, Qt::AlignBottom);
+    m_pagingAxisY->setRange(0, 100);
+    m_pagingAxisY->setTitleText("次数或页数 / 秒");
+    m_pagingChart->addAxis(m_pagingAxisY, Qt::AlignLeft);
+
+    const char *names[PagingSeriesCount] = { "主缺页/s", "换入/s", "换出/s", "回收扫描/s" };
+    for (int i = 0; i < PagingSeriesCount; ++i) {
+        m_pagingSeries[i] = new QLineSeries();
+        m_pagingSeries[i]->setName(names[i]);
+        m_pagingChart->addSeries(m_pagingSeries[i]);
+        m_pagingSeries[i]->attachAxis(pagingAxisX);
+        m_pagingSeries[i]->attachAxis(m_pagingAxisY);
+    }
+
+    m_pagingChartView->setRenderHint(QPainter::Antialiasing);
+    m_reclaimLabel->setStyleSheet("QLabel { color: #666666; font-size: 9pt; font-weight: normal; }");
+    pagingLayout->addWidget(m_pagingChartView);
+    pagingLayout->addWidget(m_reclaimLabel);
+
+    mainLayout->addWidget(pagingGroup);
+#endif
 }
 
 void MemoryPage::updateMemoryData()
 {
+#ifdef Q_OS_WIN
     MEMORYSTATUSEX memInfo;
     memInfo.dwLength = sizeof(MEMORYSTATUSEX);
     GlobalMemoryStatusEx(&memInfo);
@@ -148,6 +233,14 @@ void MemoryPage::updateMemoryData()
     
     // 更新内存使用率
     int usagePercentage = static_cast<int>(memInfo.dwMemoryLoad);
+#elif defined(Q_OS_LINUX)
+    quint64 total = 0, used = 0;
+    if (!m_memoryMonitor->getMemoryStats(total, used)) return;
+    updateLabels(total, used, total - used);
+    int usagePercentage = total > 0 ? qRound(used * 100.0 / total) : 0;
+#else
+    int usagePercentage = 0;
+#endif
     m_memoryBar->setValue(usagePercentage);
     m_usagePercentLabel->setText(QString("内存使用率: %1%").arg(usagePercentage));
     
@@ -188,6 +281,76 @@ void MemoryPage::updateMemoryData()
     }
 }
 
+void MemoryPage::updateVmstat(const VmstatRates &rates)
+{
+#ifdef Q_OS_LINUX
+    const double values[PagingSeriesCount] = { rates.majorFaults, rates.swapIns, rates.swapOuts, rates.pagesScanned };
+    qreal maxValue = 0.0;
+    for (int i = 0; i < PagingSeriesCount; ++i) {
+        QVector<qreal> &history = m_pagingHistory[i];
+        history.append(values[i]);
+        if (history.size() > 60) {
+            history.removeFirst();
+        }
+
+        QList<QPointF> points;
+        points.reserve(history.size());
+        for (int j = 0; j < history.size(); ++j) {
+            points.append(QPointF(j, history[j]));
+            maxValue = qMax(maxValue, history[j]);
+        }
+        m_pagingSeries[i]->replace(points);
+    }
+    // 空闲时速率基本为 0，保留一个最小量程避免坐标轴在 0 附近来回跳动
+    m_pagingAxisY->setRange(0, qMax<qreal>(100.0, maxValue * 1.2));
+
+    // 直接回收和规整停顿发生在申请内存的进程里，比 kswapd 后台回收更能说明有进程被卡住
+    m_reclaimLabel->setText(QString("直接回收扫描: %1 页/秒    回收成功: %2 页/秒    规整停顿: %3 次/秒    OOM kill: 累计 %4 次")
+        .arg(rates.directScanned, 0, 'f', 0)
+        .arg(rates.pagesStolen, 0, 'f', 0)
+        .arg(rates.compactStalls, 0, 'f', 1)
+        .arg(rates.oomKillTotal));
+#else
+    Q_UNUSED(rates);
+#endif
+}
+
+#ifdef Q_OS_LINUX
+void MemoryPage::setProcessMonitor(ProcessMonitor *monitor)
+{
+    m_processMonitor = monitor;
+    updateProcessMemory();
+}
+
+void MemoryPage::updateProcessMemory()
+{
+    if (!m_processMonitor) return;
+    const QList<ProcessInfo> top = m_processMonitor->getTopProcesses(10, ProcessMonitor::RankByPss);
+
+    const auto mb = [this](double value) { return formatSize(static_cast<quint64>(value * 1024 * 1024)); };
+    double rssTotal = 0.0, pssTotal = 0.0;
+    m_processTable->setRowCount(top.size());
+    for (int row = 0; row < top.size(); ++row) {
+        const ProcessInfo &info = top[row];
+        m_processTable->setItem(row, 0, new QTableWidgetItem(info.name));
+        m_processTable->setItem(row, 1, new QTableWidgetItem(QString::number(info.pid)));
+        m_processTable->setItem(row, 2, new QTableWidgetItem(mb(info.memoryMB)));
+        // 没有权限读取 smaps_rollup 的进程（其他用户的进程）只有 RSS
+        m_processTable->setItem(row, 3, new QTableWidgetItem(info.accurateMemoryAvailable ? mb(info.pssMB) : "-"));
+        m_processTable->setItem(row, 4, new QTableWidgetItem(info.accurateMemoryAvailable ? mb(info.ussMB) : "-"));
+        m_processTable->setItem(row, 5, new QTableWidgetItem(info.accurateMemoryAvailable ? mb(info.swapMB) : "-"));
+        if (info.accurateMemoryAvailable) {
+            rssTotal += info.memoryMB;
+            pssTotal += info.pssMB;
+        }
+    }
+
+    m_processSummaryLabel->setText(QString("其中有 PSS 的进程 RSS 合计 %1，按共享分摊后 (PSS) 合计 %2")
+        .arg(mb(rssTotal))
+        .arg(mb(pssTotal)));
+}
+#endif
+
 void MemoryPage::updateLabels(quint64 total, quint64 used, quint64 free)
 {
     m_totalMemLabel->setText(formatSize(total));
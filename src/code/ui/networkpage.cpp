@@ -1,11 +1,15 @@
 #include "src/include/ui/networkpage.h"
 #include "src/include/monitor/networkmonitor.h"
+#ifdef Q_OS_WIN
 #include <windows.h>
 #include <iphlpapi.h>
 #include <netioapi.h>
+#endif
 #include <cmath>
 
+#ifdef Q_OS_WIN
 #pragma comment(lib, "iphlpapi.lib")
+#endif
 
 QT_USE_NAMESPACE
 
@@ -18,6 +22,9 @@ NetworkPage::NetworkPage(QWidget *parent)
     , m_downloadChartWidget(new ChartWidget(tr("下载速度历史"), this))
     , m_lastUploadBytes(0)
     , m_lastDownloadBytes(0)
+#ifndef Q_OS_WIN
+    , m_processTable(new QTableWidget(this))
+#endif
 {
     setupUI();
     refreshInterfaces();
@@ -96,6 +103,23 @@ void NetworkPage::setupUI()
     infoLayout->addWidget(m_detailLabel);
     mainLayout->addWidget(infoPanel);
 
+#ifndef Q_OS_WIN
+    // 进程流量面板：按 TCP 收发速率列出占用网络最多的进程
+    QGroupBox *processPanel = new QGroupBox(this);
+    processPanel->setTitle(tr("进程网络流量"));
+    processPanel->setStyleSheet("QGroupBox { font-size: 12pt; font-weight: bold; }");
+
+    QVBoxLayout *processLayout = new QVBoxLayout(processPanel);
+    m_processTable->setColumnCount(6);
+    m_processTable->setHorizontalHeaderLabels({tr("进程"), tr("PID"), tr("下载速度"), tr("上传速度"), tr("TCP 连接"), tr("UDP 套接字")});
+    m_processTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    m_processTable->verticalHeader()->setVisible(false);
+    m_processTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_processTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    processLayout->addWidget(m_processTable);
+    mainLayout->addWidget(processPanel);
+#endif
+
     connect(m_interfaceCombo, &QComboBox::currentTextChanged, this, [=](const QString &text){
         int idx = m_interfaceCombo->currentIndex();
         if(idx >= 0) {
@@ -110,6 +134,7 @@ void NetworkPage::setupUI()
 
 void NetworkPage::refreshInterfaces()
 {
+#ifdef Q_OS_WIN
     m_interfaceCombo->clear();
 
     ULONG bufferSize = 0;
@@ -153,13 +178,24 @@ void NetworkPage::refreshInterfaces()
         
         onInterfaceChanged(m_interfaceCombo->currentText());
     }
+#endif
+    // Linux 下接口列表随采样数据一起到达，见 updateInterfaceData()
 }
 
 void NetworkPage::onInterfaceChanged(const QString &interfaceName)
 {
     m_lastUploadBytes = 0;
     m_lastDownloadBytes = 0;
+#ifdef Q_OS_WIN
     updateNetworkData();
+#else
+    // 切换接口时立即显示该接口最近一次的统计
+    if (const NetworkInterfaceStats *stats = selectedInterface()) {
+        m_uploadSpeedLabel->setText(formatSpeed(static_cast<qint64>(stats->txBytesPerSec)));
+        m_downloadSpeedLabel->setText(formatSpeed(static_cast<qint64>(stats->rxBytesPerSec)));
+        updateDetailInfo(*stats);
+    }
+#endif
 }
 
 QString NetworkPage::formatSpeed(qint64 bytes)
@@ -178,6 +214,7 @@ QString NetworkPage::formatSpeed(qint64 bytes)
 
 void NetworkPage::updateNetworkData()
 {
+#ifdef Q_OS_WIN
     if (m_interfaceCombo->currentData().isValid()) {
         DWORD index = m_interfaceCombo->currentData().toUInt();
         MIB_IFROW ifRow = { 0 };
@@ -236,8 +273,101 @@ void NetworkPage::updateNetworkData()
             m_lastDownloadBytes = currentDownloadBytes;
         }
     }
+#endif
 }
 
+void NetworkPage::updateInterfaceData(const QVector<NetworkInterfaceStats> &interfaces)
+{
+#ifdef Q_OS_WIN
+    Q_UNUSED(interfaces); // Windows 下由 updateNetworkData() 通过 GetIfEntry 轮询
+#else
+    m_interfaces = interfaces;
+
+    // 下拉框只列出物理接口；没有物理接口时（例如容器内只有 veth）列出除 lo 外的全部接口
+    bool hasPhysical = false;
+    for (const NetworkInterfaceStats &s : interfaces) {
+        if (!s.isVirtual) hasPhysical = true;
+    }
+    QStringList names;
+    for (const NetworkInterfaceStats &s : interfaces) {
+        if (hasPhysical ? !s.isVirtual : s.name != "lo") names << s.name;
+    }
+
+    // 接口列表变化时才重建下拉框，并尽量保持当前选择
+    bool changed = names.size() != m_interfaceCombo->count();
+    for (int i = 0; !changed && i < names.size(); ++i) {
+        changed = m_interfaceCombo->itemData(i).toString() != names[i];
+    }
+    if (changed) {
+        const QString current = m_interfaceCombo->currentData().toString();
+        m_interfaceCombo->blockSignals(true);
+        m_interfaceCombo->clear();
+        for (const QString &name : names) {
+            m_interfaceCombo->addItem(name, name);
+        }
+        int index = m_interfaceCombo->findData(current);
+        if (index < 0 && !names.isEmpty()) {
+            // 默认选择累计流量最大的接口
+            quint64 maxTraffic = 0;
+            index = 0;
+            for (const NetworkInterfaceStats &s : interfaces) {
+                const int i = names.indexOf(s.name);
+                if (i >= 0 && s.rxBytesTotal + s.txBytesTotal > maxTraffic) {
+                    maxTraffic = s.rxBytesTotal + s.txBytesTotal;
+                    index = i;
+                }
+            }
+        }
+        m_interfaceCombo->setCurrentIndex(index);
+        m_interfaceCombo->blockSignals(false);
+    }
+
+    const NetworkInterfaceStats *stats = selectedInterface();
+    if (!stats) return;
+
+    // 更新速度标签
+    m_uploadSpeedLabel->setText(formatSpeed(static_cast<qint64>(stats->txBytesPerSec)));
+    m_downloadSpeedLabel->setText(formatSpeed(static_cast<qint64>(stats->rxBytesPerSec)));
+
+    // 更新图表（转换为 KB/s）
+    m_uploadChartWidget->updateValue(stats->txBytesPerSec / 1024.0);
+    m_downloadChartWidget->updateValue(stats->rxBytesPerSec / 1024.0);
+
+    updateDetailInfo(*stats);
+#endif
+}
+
+void NetworkPage::updateProcessData(const QVector<ProcessNetworkStats> &processes)
+{
+#ifdef Q_OS_WIN
+    Q_UNUSED(processes);
+#else
+    // 列表已按收发速率之和排序，只显示前 10 个
+    const int rows = qMin(10, processes.size());
+    m_processTable->setRowCount(rows);
+    for (int row = 0; row < rows; ++row) {
+        const ProcessNetworkStats &p = processes[row];
+        const QStringList values = {
+            p.name,
+            QString::number(p.pid),
+            formatSpeed(static_cast<qint64>(p.rxBytesPerSec)),
+            formatSpeed(static_cast<qint64>(p.txBytesPerSec)),
+            p.tcpListening > 0 ? tr("%1 (监听 %2)").arg(p.tcpConnections).arg(p.tcpListening) : QString::number(p.tcpConnections),
+            QString::number(p.udpSockets)
+        };
+        for (int col = 0; col < values.size(); ++col) {
+            QTableWidgetItem *item = m_processTable->item(row, col);
+            if (!item) {
+                item = new QTableWidgetItem;
+                m_processTable->setItem(row, col, item);
+            }
+            item->setText(values[col]);
+        }
+    }
+#endif
+}
+
+#ifdef Q_OS_WIN
 void NetworkPage::updateDetailInfo(const MIB_IFROW& ifRow, qint64 uploadSpeed, qint64 downloadSpeed)
 {
     QString status;
@@ -283,6 +413,40 @@ QString NetworkPage::formatMacAddress(const BYTE* addr, DWORD len)
     }
     return macAddr;
 }
+#else
+const NetworkInterfaceStats *NetworkPage::selectedInterface() const
+{
+    const QString name = m_interfaceCombo->currentData().toString();
+    for (const NetworkInterfaceStats &s : m_interfaces) {
+        if (s.name == name) return &s;
+    }
+    return nullptr;
+}
+
+void NetworkPage::updateDetailInfo(const NetworkInterfaceStats &stats)
+{
+    QString detail = tr("接口: %1\n"
+                      "上传速度: %2 (%3 包/秒)\n"
+                      "下载速度: %4 (%5 包/秒)\n"
+                      "错误: 发送 %6/秒, 接收 %7/秒\n"
+                      "丢包: 发送 %8/秒, 接收 %9/秒\n"
+                      "总上传: %10\n"
+                      "总下载: %11")
+        .arg(stats.name)
+        .arg(formatSpeed(static_cast<qint64>(stats.txBytesPerSec)))
+        .arg(stats.txPacketsPerSec, 0, 'f', 1)
+        .arg(formatSpeed(static_cast<qint64>(stats.rxBytesPerSec)))
+        .arg(stats.rxPacketsPerSec, 0, 'f', 1)
+        .arg(stats.txErrorsPerSec, 0, 'f', 1)
+        .arg(stats.rxErrorsPerSec, 0, 'f', 1)
+        .arg(stats.txDropsPerSec, 0, 'f', 1)
+        .arg(stats.rxDropsPerSec, 0, 'f', 1)
+        .arg(formatDataSize(static_cast<qint64>(stats.txBytesTotal)))
+        .arg(formatDataSize(static_cast<qint64>(stats.rxBytesTotal)));
+
+    m_detailLabel->setText(detail);
+}
+#endif
 
 QString NetworkPage::formatDataSize(qint64 bytes)
 {
@@ -2,9 +2,33 @@
 #include <QHeaderView>
 #include <QMessageBox>
 #include <QProcess>
+#ifdef Q_OS_WIN
 #include <windows.h>
 #include <psapi.h>
 #include <tlhelp32.h>
+#elif defined(Q_OS_LINUX)
+#include <sys/wait.h>
+#include <signal.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+// 按 Qt::UserRole 中的原始数值排序的表格项，默认的 QTableWidgetItem 按显示文本比较，"900 KB" 会排在 "1.5 MB" 之后
+class NumericTableItem : public QTableWidgetItem
+{
+public:
+    explicit NumericTableItem(const QString &text) : QTableWidgetItem(text) {}
+
+    bool operator<(const QTableWidgetItem &other) const override
+    {
+        return data(Qt::UserRole).toDouble() < other.data(Qt::UserRole).toDouble();
+    }
+};
+
+#ifdef Q_OS_LINUX
+// 已退出的进程在列表中保留的时间
+static const MonotonicNs ExitedRowLifetime = MonotonicClock::fromSecs(10);
+#endif
 
 ProcessPage::ProcessPage(QWidget *parent)
     : QWidget(parent)
@@ -16,6 +40,11 @@ ProcessPage::ProcessPage(QWidget *parent)
     , m_totalProcessesLabel(new QLabel(this))
     , m_cpuUsageLabel(new QLabel(this))
     , m_memoryUsageLabel(new QLabel(this))
+#ifdef Q_OS_LINUX
+    , m_processMonitor(nullptr)
+    , m_cpuMonitor(new CpuMonitor(this))
+    , m_memoryMonitor(new MemoryMonitor(this))
+#endif
 {
     setupUI();
     
@@ -33,6 +62,14 @@ ProcessPage::~ProcessPage()
 {
 }
 
+#ifdef Q_OS_LINUX
+void ProcessPage::setProcessMonitor(ProcessMonitor *monitor)
+{
+    m_processMonitor = monitor;
+    updateProcessList();
+}
+#endif
+
 void ProcessPage::setupUI()
 {
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
@@ -51,8 +88,14 @@ void ProcessPage::setupUI()
     statsLayout->addWidget(m_memoryUsageLabel);
     
     // 设置进程表格
+#ifdef Q_OS_LINUX
+    // Linux 下增加内存占用最大的进程的 PSS（/proc/[pid]/smaps_rollup）和每个进程的磁盘读写速率（/proc/[pid]/io）
+    m_processTable->setColumnCount(9);
+    m_processTable->setHorizontalHeaderLabels({"选择", "PID", "进程名", "CPU使用率", "内存使用", "实际内存(PSS)", "磁盘读取", "磁盘写入", "状态"});
+#else
     m_processTable->setColumnCount(6); // 增加一列用于复选框
     m_processTable->setHorizontalHeaderLabels({"选择", "PID", "进程名", "CPU使用率", "内存使用", "状态"});
+#endif
     m_processTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
     m_processTable->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Fixed); // 固定复选框列宽
     m_processTable->setColumnWidth(0, 50); // 设置复选框列宽
@@ -94,6 +137,11 @@ QString ProcessPage::formatMemorySize(quint64 bytes)
 
 void ProcessPage::updateSystemStats()
 {
+#ifdef Q_OS_LINUX
+    m_totalProcessesLabel->setText(QString("进程总数: %1").arg(m_processMonitor->processCount()));
+    m_memoryUsageLabel->setText(QString("内存使用: %1%").arg(qRound(m_memoryMonitor->getMemoryUsage())));
+    m_cpuUsageLabel->setText(QString("CPU使用: %1%").arg(qRound(m_cpuMonitor->getCpuUsage())));
+#elif defined(Q_OS_WIN)
     PERFORMANCE_INFORMATION perfInfo;
     perfInfo.cb = sizeof(PERFORMANCE_INFORMATION);
     GetPerformanceInfo(&perfInfo, sizeof(PERFORMANCE_INFORMATION));
@@ -138,10 +186,126 @@ void ProcessPage::updateSystemStats()
     lastIdleTime = idleTime;
     lastKernelTime = kernelTime;
     lastUserTime = userTime;
+#endif
+}
+
+#ifdef Q_OS_LINUX
+int ProcessPage::appendProcessRow(const QMap<quint64, bool> &checkedPids, const ProcessInfo &info, const QString &status)
+{
+    const quint64 memoryBytes = static_cast<quint64>(info.memoryMB * 1024 * 1024);
+    int row = m_processTable->rowCount();
+    m_processTable->insertRow(row);
+
+    // 复选框
+    QTableWidgetItem *checkItem = new QTableWidgetItem();
+    checkItem->setFlags(checkItem->flags() | Qt::ItemIsUserCheckable);
+    checkItem->setCheckState(checkedPids.value(info.pid, false) ? Qt::Checked : Qt::Unchecked);
+    m_processTable->setItem(row, 0, checkItem);
+
+    QTableWidgetItem *pidItem = new NumericTableItem(QString::number(info.pid));
+    pidItem->setFlags(pidItem->flags() & ~Qt::ItemIsEditable);
+    pidItem->setData(Qt::UserRole, static_cast<qulonglong>(info.pid));
+    m_processTable->setItem(row, 1, pidItem);
+
+    QTableWidgetItem *nameItem = new QTableWidgetItem(info.name);
+    nameItem->setFlags(nameItem->flags() & ~Qt::ItemIsEditable);
+    nameItem->setToolTip(info.commandLine);
+    m_processTable->setItem(row, 2, nameItem);
+
+    QTableWidgetItem *cpuItem = new NumericTableItem(QString::number(info.cpuPercent, 'f', 1) + "%");
+    cpuItem->setFlags(cpuItem->flags() & ~Qt::ItemIsEditable);
+    cpuItem->setData(Qt::UserRole, info.cpuPercent); // 存储原始值用于排序
+    m_processTable->setItem(row, 3, cpuItem);
+
+    QTableWidgetItem *memItem = new NumericTableItem(formatMemorySize(memoryBytes));
+    memItem->setFlags(memItem->flags() & ~Qt::ItemIsEditable);
+    memItem->setData(Qt::UserRole, static_cast<qulonglong>(memoryBytes)); // 存储原始值用于排序
+    m_processTable->setItem(row, 4, memItem);
+
+    // RSS 会把共享页重复计入每个进程；PSS 按共享进程数分摊，只有 RSS 最大的一批进程才有
+    const quint64 pssBytes = static_cast<quint64>(info.pssMB * 1024 * 1024);
+    QTableWidgetItem *pssItem = new NumericTableItem(info.accurateMemoryAvailable ? formatMemorySize(pssBytes) : "-");
+    pssItem->setFlags(pssItem->flags() & ~Qt::ItemIsEditable);
+    pssItem->setData(Qt::UserRole, info.accurateMemoryAvailable ? static_cast<double>(pssBytes) : -1.0);
+    if (info.accurateMemoryAvailable) {
+        pssItem->setToolTip(QString("独占 (USS): %1\n交换区: %2")
+            .arg(formatMemorySize(static_cast<quint64>(info.ussMB * 1024 * 1024)))
+            .arg(formatMemorySize(static_cast<quint64>(info.swapMB * 1024 * 1024))));
+    }
+    m_processTable->setItem(row, 5, pssItem);
+
+    // 没有权限读取 /proc/[pid]/io 的进程显示 "-"，排序时排在最后
+    const double ioRates[2] = { info.diskReadBytesPerSec, info.diskWriteBytesPerSec };
+    for (int i = 0; i < 2; ++i) {
+        QTableWidgetItem *ioItem = new NumericTableItem(info.diskIoAvailable ? formatMemorySize(static_cast<quint64>(ioRates[i])) + "/s" : "-");
+        ioItem->setFlags(ioItem->flags() & ~Qt::ItemIsEditable);
+        ioItem->setData(Qt::UserRole, info.diskIoAvailable ? ioRates[i] : -1.0);
+        m_processTable->setItem(row, 6 + i, ioItem);
+    }
+
+    QTableWidgetItem *statusItem = new QTableWidgetItem(status);
+    statusItem->setFlags(statusItem->flags() & ~Qt::ItemIsEditable);
+    m_processTable->setItem(row, 8, statusItem);
+    return row;
 }
+#endif
 
 void ProcessPage::updateProcessList()
 {
+#ifdef Q_OS_LINUX
+    if (!m_processMonitor) return;
+    updateSystemStats();
+
+    // 保存当前选中的复选框状态
+    QMap<quint64, bool> checkedPids;
+    for (int row = 0; row < m_processTable->rowCount(); ++row) {
+        QTableWidgetItem* checkItem = m_processTable->item(row, 0);
+        QTableWidgetItem* pidItem = m_processTable->item(row, 1);
+        if (checkItem && pidItem) {
+            checkedPids[pidItem->text().toULongLong()] = checkItem->checkState() == Qt::Checked;
+        }
+    }
+
+    m_processTable->setSortingEnabled(false);
+    m_processTable->setRowCount(0);
+
+    const QList<ProcessInfo> processes = m_processMonitor->processes();
+    for (const ProcessInfo &info : processes) {
+        const int row = appendProcessRow(checkedPids, info, "运行中");
+
+        // 高亮显示高CPU使用率的进程
+        if (info.cpuPercent > 5.0) {
+            for (int col = 0; col < m_processTable->columnCount(); ++col) {
+                m_processTable->item(row, col)->setBackground(QColor(255, 235, 235));
+            }
+        }
+    }
+
+    // 最近退出的进程（包括两次刷新之间启动又退出的短命进程）灰色显示一段时间，不能勾选
+    const MonotonicNs now = MonotonicClock::now();
+    const QList<ProcessMonitor::ExitedProcess> exited = m_processMonitor->recentlyExited();
+    for (const ProcessMonitor::ExitedProcess &process : exited) {
+        if (now - process.exitTime > ExitedRowLifetime) break; // 最新的在前
+
+        const QString status = WIFSIGNALED(process.exitStatus)
+            ? QString("已退出 (信号 %1)").arg(WTERMSIG(process.exitStatus))
+            : QString("已退出 (%1)").arg(WEXITSTATUS(process.exitStatus));
+        ProcessInfo info;
+        info.pid = process.pid;
+        info.name = process.name;
+        info.cpuPercent = 0.0;
+        info.memoryMB = 0.0;
+        const int row = appendProcessRow(QMap<quint64, bool>(), info, status);
+        m_processTable->item(row, 0)->setFlags(Qt::ItemIsEnabled);
+        m_processTable->item(row, 2)->setToolTip(QString("%1\nCPU 时间: %2 秒")
+            .arg(process.commandLine).arg(process.cpuSeconds, 0, 'f', 2));
+        for (int col = 0; col < m_processTable->columnCount(); ++col) {
+            m_processTable->item(row, col)->setForeground(QColor(150, 150, 150));
+        }
+    }
+
+    m_processTable->setSortingEnabled(true);
+#elif defined(Q_OS_WIN)
     updateSystemStats();
     
     // 保存当前选中的复选框状态
@@ -204,18 +368,19 @@ void ProcessPage::updateProcessList()
                         userTime.HighPart = user.dwHighDateTime;
                         
                         cpuTime = (kernelTime.QuadPart + userTime.QuadPart) / 10000000.0;
-                        QTableWidgetItem *cpuItem = new QTableWidgetItem(QString::number(cpuTime, 'f', 1) + "%");
+                        QTableWidgetItem *cpuItem = new NumericTableItem(QString::number(cpuTime, 'f', 1) + "%");
                         cpuItem->setFlags(cpuItem->flags() & ~Qt::ItemIsEditable);
                         cpuItem->setData(Qt::UserRole, cpuTime); // 存储原始值用于排序
                         m_processTable->setItem(row, 3, cpuItem);
                     } else {
-                        QTableWidgetItem *cpuItem = new QTableWidgetItem("0.0%");
+                        QTableWidgetItem *cpuItem = new NumericTableItem("0.0%");
                         cpuItem->setFlags(cpuItem->flags() & ~Qt::ItemIsEditable);
+                        cpuItem->setData(Qt::UserRole, 0.0);
                         m_processTable->setItem(row, 3, cpuItem);
                     }
                     
                     // 内存使用
-                    QTableWidgetItem *memItem = new QTableWidgetItem(formatMemorySize(pmc.WorkingSetSize));
+                    QTableWidgetItem *memItem = new NumericTableItem(formatMemorySize(pmc.WorkingSetSize));
                     memItem->setFlags(memItem->flags() & ~Qt::ItemIsEditable);
                     memItem->setData(Qt::UserRole, (qulonglong)pmc.WorkingSetSize); // 存储原始值用于排序
                     m_processTable->setItem(row, 4, memItem);
@@ -241,6 +406,7 @@ void ProcessPage::updateProcessList()
     
     CloseHandle(snapshot);
     m_processTable->setSortingEnabled(true);
+#endif
 }
 
 void ProcessPage::filterProcesses(const QString &filter)
@@ -260,7 +426,7 @@ void ProcessPage::filterProcesses(const QString &filter)
 
 void ProcessPage::terminateSelectedProcess()
 {
-    QList<DWORD> selectedPids;
+    QList<quint64> selectedPids;
     QStringList selectedNames;
     
     // 收集所有被选中的进程
@@ -271,7 +437,7 @@ void ProcessPage::terminateSelectedProcess()
             QTableWidgetItem *nameItem = m_processTable->item(row, 2);
             
             if (pidItem && nameItem) {
-                selectedPids.append(pidItem->text().toULong());
+                selectedPids.append(pidItem->text().toULongLong());
                 selectedNames.append(nameItem->text());
             }
         }
@@ -304,12 +470,19 @@ void ProcessPage::terminateSelectedProcess()
         QStringList failedProcesses;
         
         for (int i = 0; i < selectedPids.size(); ++i) {
-            DWORD pid = selectedPids[i];
+            quint64 pid = selectedPids[i];
             
             // 在终止进程前发射信号
             emit processTerminationRequested(pid);
             
-            HANDLE hProcess = OpenProcess(PROCESS_TERMINATE, FALSE, pid);
+#ifdef Q_OS_LINUX
+            if (kill(static_cast<pid_t>(pid), SIGTERM) == 0) {
+                successCount++;
+            } else {
+                failedProcesses.append(tr("%1 (PID: %2, 错误: %3)").arg(selectedNames[i]).arg(pid).arg(QString::fromLocal8Bit(strerror(errno))));
+            }
+#elif defined(Q_OS_WIN)
+            HANDLE hProcess = OpenProcess(PROCESS_TERMINATE, FALSE, static_cast<DWORD>(pid));
             if (hProcess) {
                 if (TerminateProcess(hProcess, 0)) {
                     successCount++;
@@ -320,6 +493,7 @@ void ProcessPage::terminateSelectedProcess()
             } else {
                 failedProcesses.append(tr("%1 (PID: %2, 错误: 无法打开进程)").arg(selectedNames[i]).arg(pid));
             }
+#endif
         }
         
         // 显示结果
@@ -5,6 +5,7 @@
 #include <QPair>
 #include <QDateTime>
 #include <QMap>
+#include "src/include/common/monotonicclock.h"
 
 // 异常检测类 - 基于历史数据分析系统性能异常
 class AnomalyDetector : public QObject {
@@ -34,16 +35,21 @@ public:
     ~AnomalyDetector();
 
     // 添加CPU使用率数据点
-    void addCpuDataPoint(double value, const QDateTime& timestamp = QDateTime::currentDateTime());
+    void addCpuDataPoint(double value, MonotonicNs timestamp = MonotonicClock::now());
     
     // 添加内存使用率数据点
-    void addMemoryDataPoint(double value, const QDateTime& timestamp = QDateTime::currentDateTime());
+    void addMemoryDataPoint(double value, MonotonicNs timestamp = MonotonicClock::now());
     
     // 添加磁盘IO数据点
-    void addDiskDataPoint(double value, const QDateTime& timestamp = QDateTime::currentDateTime());
+    void addDiskDataPoint(double value, MonotonicNs timestamp = MonotonicClock::now());
     
     // 添加网络使用率数据点
-    void addNetworkDataPoint(double value, const QDateTime& timestamp = QDateTime::currentDateTime());
+    void addNetworkDataPoint(double value, MonotonicNs timestamp = MonotonicClock::now());
+    
+    // 添加分页与回收速率数据点（来自 /proc/vmstat，每秒）
+    // swapPages 为换入 + 换出页数，directReclaimPages 为直接回收扫描页数
+    void addPagingDataPoint(double majorFaults, double swapPages, double directReclaimPages, double oomKills,
+                            MonotonicNs timestamp = MonotonicClock::now());
     
     // 获取当前CPU使用率
     double getCurrentCpuUsage() const;
@@ -69,6 +75,9 @@ public:
     // 检测网络异常
     bool detectNetworkAnomaly(double threshold = 2.0);
     
+    // 检测分页与回收异常：速率超过最小值且 Z 分数超过阈值，或发生了 OOM kill
+    bool detectPagingAnomaly(double threshold = 2.0);
+    
     // 获取异常详情
     QString getAnomalyDetails() const;
     
@@ -132,11 +141,21 @@ private:
     // 清理过期数据
     void cleanupOldData();
     
-    // 存储历史数据，格式为 <时间戳, 值>
-    QVector<QPair<QDateTime, double>> m_cpuHistory;
-    QVector<QPair<QDateTime, double>> m_memoryHistory;
-    QVector<QPair<QDateTime, double>> m_diskHistory;
-    QVector<QPair<QDateTime, double>> m_networkHistory;
+    // 存储历史数据，格式为 <单调时钟时间戳(纳秒), 值>
+    QVector<QPair<MonotonicNs, double>> m_cpuHistory;
+    QVector<QPair<MonotonicNs, double>> m_memoryHistory;
+    QVector<QPair<MonotonicNs, double>> m_diskHistory;
+    QVector<QPair<MonotonicNs, double>> m_networkHistory;
+    
+    // 分页与回收速率，下标为 PagingMetric
+    enum PagingMetric {
+        PagingMajorFaults,
+        PagingSwap,
+        PagingDirectReclaim,
+        PagingOomKills,
+        PagingMetricCount
+    };
+    QVector<QPair<MonotonicNs, double>> m_pagingHistory[PagingMetricCount];
     
     // 存储最近检测到的异常
     QMap<QString, QString> m_anomalyDetails;
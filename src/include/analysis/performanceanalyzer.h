@@ -4,6 +4,9 @@
 #include <QVector>
 #include <QPair>
 #include <QDateTime>
+#include "src/include/common/monotonicclock.h"
+#include "src/include/monitor/processmonitor.h"
+#include "src/include/monitor/pressuremonitor.h"
 #include <QString>
 #include <QMap>
 
@@ -52,9 +55,12 @@ public:
     explicit PerformanceAnalyzer(QObject *parent = nullptr);
     ~PerformanceAnalyzer();
 
+    // 高占用进程查询使用的进程表，由采样器每个周期刷新一次，这里只读取；未设置时查询结果为空
+    void setProcessMonitor(ProcessMonitor *monitor);
+
     // 添加性能数据点
     void addDataPoint(double cpuUsage, double memoryUsage, double diskIO, double networkUsage, 
-                     const QDateTime& timestamp = QDateTime::currentDateTime());
+                     MonotonicNs timestamp = MonotonicClock::now());
 
     // 分析性能瓶颈
     BottleneckType analyzeBottleneck();
@@ -104,6 +110,10 @@ public:
     // 更新网络使用率
     void updateNetworkUsage(double usage);
 
+    // 更新压力停顿信息（PSI）。有 PSI 时 CPU、内存和磁盘瓶颈按任务实际等待资源的时间判断，
+    // 使用率只作参考：CPU 跑满但没有任务排队不算瓶颈，内存使用率不高但已经在频繁回收则算
+    void updatePressure(const PressureStats &cpu, const PressureStats &memory, const PressureStats &io);
+
     // 获取最新的CPU使用率
     double getLastCpuUsage() const;
     
@@ -126,6 +136,9 @@ public:
     void setBottleneckThresholds(double cpuThreshold, double memoryThreshold, 
                                 double diskThreshold, double networkThreshold);
     
+    // 设置 PSI 瓶颈阈值（some avg10，%；full avg10 超过其一半也视为瓶颈）
+    void setPressureThresholds(double cpuThreshold, double memoryThreshold, double ioThreshold);
+    
     // 重置为默认瓶颈阈值
     void resetToDefaultThresholds();
     
@@ -153,6 +166,10 @@ public:
     // 进程管理
     QList<QPair<QString, double>> getHighCpuProcesses() const;
     QList<QPair<QString, double>> getHighMemoryProcesses() const;
+    // 磁盘读写速率（MB/s）最高的进程，只有 Linux 下可用
+    QList<QPair<QString, double>> getHighIoProcesses() const;
+    // TCP 收发速率（MB/s）最高的进程，只有 Linux 下可用
+    QList<QPair<QString, double>> getHighNetworkProcesses() const;
     bool terminateProcess(const QString &processName) const;
     
     // 线程池管理
@@ -173,7 +190,7 @@ public:
 
 private:
     // 计算线性回归斜率
-    double calculateSlope(const QVector<QPair<QDateTime, double>>& data, int timeWindowMinutes);
+    double calculateSlope(const QVector<QPair<MonotonicNs, double>>& data, int timeWindowMinutes);
 
     // 计算变异系数
     double calculateCoefficientOfVariation(const QVector<double>& values);
@@ -191,11 +208,15 @@ private:
     // 获取趋势类型的字符串描述
     QString trendTypeToString(TrendType trend) const;
 
+    // 某种资源的停顿时间是否超过阈值
+    bool isPressureBottleneck(PressureResource resource) const;
+    QString pressureDetails(const QString &name, PressureResource resource) const;
+
     // 存储历史数据，格式为 <时间戳, 值>
-    QVector<QPair<QDateTime, double>> m_cpuHistory;
-    QVector<QPair<QDateTime, double>> m_memoryHistory;
-    QVector<QPair<QDateTime, double>> m_diskHistory;
-    QVector<QPair<QDateTime, double>> m_networkHistory;
+    QVector<QPair<MonotonicNs, double>> m_cpuHistory;
+    QVector<QPair<MonotonicNs, double>> m_memoryHistory;
+    QVector<QPair<MonotonicNs, double>> m_diskHistory;
+    QVector<QPair<MonotonicNs, double>> m_networkHistory;
     
     // 当前使用率
     double m_cpuUsage;
@@ -218,4 +239,11 @@ private:
     double m_memoryBottleneckThreshold;
     double m_diskBottleneckThreshold;
     double m_networkBottleneckThreshold;
+
+    // 最近一次的 PSI 数据和阈值，下标为 PressureResource
+    PressureStats m_pressure[PressureResourceCount];
+    double m_pressureThresholds[PressureResourceCount];
+
+    // 高占用进程查询共用的进程表，不归本对象所有
+    ProcessMonitor *m_processMonitor;
 };
\ No newline at end of file
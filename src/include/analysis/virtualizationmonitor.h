@@ -7,6 +7,7 @@
 #include <QList>
 #include <QPair>
 #include <QProcess>
+#include "src/include/monitor/cgroupmonitor.h"
 
 // 虚拟化监控类 - 提供对虚拟机和容器的性能监控
 class VirtualizationMonitor : public QObject {
@@ -54,6 +55,10 @@ public:
     QMap<QString, QVariant> getVirtualMachineResources(const QString &vmName, ResourceType type = All) const;
     QMap<QString, QVariant> getContainerResources(const QString &containerName, ResourceType type = All) const;
     
+    // 一次调用获取所有容器的资源使用情况，键为容器 ID
+    // cgroup v2 下遍历一次 cgroup 树，不启动任何子进程；CPU 和 I/O 速率需要两次调用之间的增量
+    QMap<QString, QMap<QString, QVariant>> getAllContainerResources(ResourceType type = All) const;
+    
     // 获取虚拟机/容器的性能历史数据
     QList<QPair<QString, QVariant>> getVirtualMachineHistory(const QString &vmName, ResourceType type, int hours) const;
     QList<QPair<QString, QVariant>> getContainerHistory(const QString &containerName, ResourceType type, int hours) const;
@@ -126,6 +131,15 @@ private:
     // 获取Docker容器资源使用情况
     QMap<QString, QVariant> getDockerContainerResources(const QString &containerName, ResourceType type = All) const;
     
+    // 将 cgroup 采集结果转换为与 docker stats 相同键名的资源表
+    QMap<QString, QVariant> containerStatsToResources(const ContainerStats &stats) const;
+    
+    // 按资源类型筛选容器资源表
+    QMap<QString, QVariant> filterContainerResources(const QMap<QString, QVariant> &allResources, ResourceType type) const;
+    
+    // 距上次遍历超过半秒才重新遍历 cgroup 树，同一轮中逐个查询容器时共用一次遍历结果
+    void refreshContainerStatsIfStale() const;
+    
     // 获取Kubernetes Pod资源使用情况
     QMap<QString, QVariant> getKubernetesPodResources(const QString &podName, ResourceType type = All) const;
     
@@ -158,4 +172,8 @@ private:
     
     // 当前检测到的虚拟化类型 (mutable for caching in const methods)
     mutable VirtualizationType m_detectedType;
+    
+    // cgroup v2 容器采集器，构造时确定是否可用
+    mutable CgroupMonitor m_cgroupMonitor;
+    bool m_cgroupAvailable;
 };
\ No newline at end of file
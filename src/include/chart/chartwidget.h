@@ -5,6 +5,7 @@
 #include <QtCharts/QChart>
 #include <QtCharts/QChartView>
 #include <QtCharts/QSplineSeries>
+#include <QtCharts/QLineSeries>
 #include <QtCharts/QValueAxis>
 #include <QVBoxLayout>
 #include <QQueue>
@@ -27,12 +28,19 @@ public:
 
     void addDataPoint(qreal value); // <-- ???????????
 
+    // 多曲线模式：每条曲线一个 QLineSeries，名称为 namePrefix + 序号，count 为 0 时恢复单曲线
+    void setSeriesCount(int count, const QString &namePrefix = QString());
+    // 多曲线模式：按给定名称各建一条曲线
+    void setSeriesNames(const QStringList &names);
+    int seriesCount() const { return m_multiSeries.size(); }
+
 public slots:
     void setTitle(const QString &title);
     void setYRange(qreal min, qreal max);
     void setSeriesName(const QString &name);
     void setMaxPoints(int points);
     void updateValue(qreal value);
+    void updateValues(const QVector<qreal> &values);
     void clear();
     void resetZoom(); // Added resetZoom declaration
 
@@ -55,6 +63,11 @@ private:
     qreal m_maxY;
     qreal m_currentMaxY;
     QVector<qreal> m_data;
+
+    // 多曲线模式下每条曲线的历史数据
+    QVector<QLineSeries *> m_multiSeries;
+    QVector<QVector<qreal>> m_multiData;
+    QString m_multiPrefix;
 };
 
 #endif // CHARTWIDGET_H
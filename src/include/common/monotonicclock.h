@@ -0,0 +1,69 @@
+// monotonicclock.h
+#pragma once
+
+#include <QtGlobal>
+#include <QDateTime>
+#include <chrono>
+#ifdef Q_OS_LINUX
+#include <time.h>
+#endif
+
+// 采样管线统一使用的时间类型：CLOCK_MONOTONIC 纳秒
+// 不受系统时间调整影响，获取、比较、做差都是整数运算；
+// 只有在界面显示和导出时才通过进程内记录的锚点换算成墙上时间
+typedef qint64 MonotonicNs;
+
+class MonotonicClock {
+public:
+    static constexpr qint64 NsPerMs = 1000000LL;
+    static constexpr qint64 NsPerSec = 1000000000LL;
+
+    static MonotonicNs now()
+    {
+#ifdef Q_OS_LINUX
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<MonotonicNs>(ts.tv_sec) * NsPerSec + ts.tv_nsec;
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    static constexpr MonotonicNs fromMSecs(qint64 msecs) { return msecs * NsPerMs; }
+    static constexpr MonotonicNs fromSecs(qint64 secs) { return secs * NsPerSec; }
+    static constexpr qint64 toMSecs(MonotonicNs ns) { return ns / NsPerMs; }
+    static constexpr double toSecs(MonotonicNs ns) { return static_cast<double>(ns) / NsPerSec; }
+
+    // 单调时间 -> 墙上时间（毫秒时间戳 / QDateTime），仅在显示和导出时使用
+    static qint64 toMSecsSinceEpoch(MonotonicNs ns)
+    {
+        const Anchor &a = anchor();
+        return a.wallMs + (ns - a.monotonicNs) / NsPerMs;
+    }
+
+    static QDateTime toDateTime(MonotonicNs ns)
+    {
+        return QDateTime::fromMSecsSinceEpoch(toMSecsSinceEpoch(ns));
+    }
+
+    // 墙上时间 -> 单调时间，用于把界面上选择的时间范围换算成内部时间
+    static MonotonicNs fromDateTime(const QDateTime &dateTime)
+    {
+        const Anchor &a = anchor();
+        return a.monotonicNs + (dateTime.toMSecsSinceEpoch() - a.wallMs) * NsPerMs;
+    }
+
+private:
+    // 首次使用时同时记录两种时钟，之后系统时间被调整也不会影响已采集数据的相对顺序
+    struct Anchor {
+        MonotonicNs monotonicNs;
+        qint64 wallMs;
+    };
+
+    static const Anchor &anchor()
+    {
+        static const Anchor a = { now(), QDateTime::currentMSecsSinceEpoch() };
+        return a;
+    }
+};
@@ -12,6 +12,19 @@ struct ProcessInfo {
     // 兼容ProcessMonitor类中使用的字段
     double cpuPercent;  // CPU usage percentage
     double memoryMB;    // Memory usage in MB
+    QString commandLine; // 完整命令行（Linux 下为空表示内核线程）
+    int threadCount = 0;
+    double diskReadBytesPerSec = 0.0;   // /proc/[pid]/io 中 read_bytes / write_bytes 的速率
+    double diskWriteBytesPerSec = 0.0;
+    bool diskIoAvailable = false;       // 没有权限读取该进程的 I/O 统计时为 false
+    double netRxBytesPerSec = 0.0;      // TCP 收发速率（sock_diag），需要 ProcessMonitor 启用网络统计
+    double netTxBytesPerSec = 0.0;
+    int tcpConnections = 0;
+    int udpSockets = 0;
+    double pssMB = 0.0;                 // /proc/[pid]/smaps_rollup，需要 ProcessMonitor 启用精确内存统计
+    double ussMB = 0.0;                 // 独占内存：Private_Clean + Private_Dirty
+    double swapMB = 0.0;
+    bool accurateMemoryAvailable = false;
 };
 
 #endif // PROCESSINFO_H
\ No newline at end of file
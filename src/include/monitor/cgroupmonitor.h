@@ -0,0 +1,86 @@
+// cgroupmonitor.h
+#pragma once
+
+#include <QtGlobal>
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QByteArray>
+#include <string>
+#include "counterrate.h"
+#include "procfsreader.h"
+
+// 单个容器在最近一个采样间隔内的资源使用，全部来自容器所在 cgroup 的接口文件
+struct ContainerStats {
+    QString id;                      // 64 位十六进制容器 ID
+    QString runtime;                 // 从 cgroup 名称推断：docker、libpod、cri-containerd、crio 等
+    QString cgroupPath;              // 相对 cgroup 根目录的路径
+    double cpuPercent = 0.0;         // cpu.stat usage_usec 的增量，100% 表示占满一个核（与 docker stats 一致）
+    double cpuThrottledPercent = 0.0; // cpu.stat throttled_usec 的增量，被 cpu.max 限流的时间占比
+    double cpuLimitCores = 0.0;      // cpu.max 换算的核数，0 表示不限制
+    quint64 memoryCurrent = 0;       // memory.current（字节），包含页缓存
+    quint64 memoryWorkingSet = 0;    // memory.current - inactive_file，与 docker / kubelet 的口径一致
+    quint64 memoryLimit = 0;         // memory.max，0 表示不限制
+    quint64 memoryAnon = 0;          // memory.stat anon / file
+    quint64 memoryFile = 0;
+    quint64 ioReadBytes = 0;         // io.stat 各设备 rbytes / wbytes 之和（累计）
+    quint64 ioWriteBytes = 0;
+    double ioReadBytesPerSec = 0.0;
+    double ioWriteBytesPerSec = 0.0;
+    quint64 pids = 0;                // pids.current
+};
+
+// cgroup v2 容器资源采集
+// 每轮只遍历一次 cgroup 树，按目录名识别容器的 scope（docker-<id>.scope、libpod-<id>.scope、
+// cri-containerd-<id>.scope、crio-<id>.scope，以及 cgroupfs 驱动下 docker/<id> 这类以 ID 命名的目录），
+// 读取 cpu.stat、cpu.max、memory.current、memory.max、memory.stat、io.stat 和 pids.current。
+// 不启动任何子进程，40 个容器一轮也只是几百次小文件读取
+class CgroupMonitor {
+public:
+    // root 为 cgroup v2 挂载点，为空时依次尝试 /sys/fs/cgroup 和混合模式下的 /sys/fs/cgroup/unified
+    explicit CgroupMonitor(const char *root = nullptr);
+
+    CgroupMonitor(const CgroupMonitor &) = delete;
+    CgroupMonitor &operator=(const CgroupMonitor &) = delete;
+
+    // 挂载点是 cgroup v2 且启用了控制器时返回 true；cgroup v1 或非 Linux 时返回 false
+    bool isAvailable() const;
+
+    // 遍历一次 cgroup 树并刷新所有容器，返回找到的容器数；首次刷新时各项速率为 0
+    int refresh();
+
+    // 最近一次 refresh() 的结果，按 CPU 使用率从高到低排列
+    const QVector<ContainerStats> &containers() const { return m_containers; }
+
+    // 按完整 ID 或 ID 前缀（docker ps 显示的 12 位短 ID）查找，只接受 12 到 64 位小写十六进制；
+    // runtime 不为空时只在该运行时的容器中查找
+    const ContainerStats *find(const QString &idOrPrefix, const QString &runtime = QString()) const;
+
+    MonotonicNs lastRefresh() const { return m_lastRefresh; }
+
+    // 从 cgroup 目录名解析容器 ID 和运行时，parentName 为上一级目录名（cgroupfs 驱动下即运行时名）
+    static bool parseContainerName(const char *name, size_t length, const char *parentName,
+                                   QString &runtime, QString &id);
+
+private:
+#ifdef Q_OS_LINUX
+    struct RateState {
+        CounterRate cpu;
+        CounterRate throttled;
+        CounterRate ioRead;
+        CounterRate ioWrite;
+        quint32 generation;
+    };
+
+    void walk(int dirfd, const std::string &relativePath, const char *name, int depth, MonotonicNs now);
+    void readContainer(int dirfd, ContainerStats &stats, MonotonicNs now);
+    bool readValue(int dirfd, const char *fileName, quint64 &value);
+
+    std::string m_root;
+    ProcfsFile m_file;             // 所有接口文件共用一个读取缓冲区
+    QHash<QByteArray, RateState> m_rates;
+    quint32 m_generation;
+#endif
+    QVector<ContainerStats> m_containers;
+    MonotonicNs m_lastRefresh;
+};
@@ -0,0 +1,55 @@
+// counterrate.h
+#pragma once
+
+#include <QtGlobal>
+#include <QByteArray>
+#include <QHash>
+#include "src/include/common/monotonicclock.h"
+
+// 单调递增计数器 -> 每秒速率
+// 记录上一次的读数和单调时钟时间，按实际经过的时间换算，采样间隔任意、有抖动都不影响结果。
+// 计数器回绕（32 位计数器溢出）按回绕处理；其他情况下读数变小视为计数器被重置，
+// 重新建立基线并返回 0，避免出现巨大的假峰值
+class CounterRate {
+public:
+    explicit CounterRate(int counterBits = 64);
+
+    // 喂入一个新读数，返回距上一次读数的每秒速率；首次读数或计数器重置时返回 0
+    double update(quint64 value, MonotonicNs timestamp);
+
+    // 最近一次 update() 得到的计数器增量
+    quint64 lastDelta() const { return m_lastDelta; }
+    bool hasBaseline() const { return m_hasBaseline; }
+    void reset();
+
+private:
+    quint64 m_mask;
+    quint64 m_lastValue;
+    MonotonicNs m_lastTimestamp;
+    quint64 m_lastDelta;
+    bool m_hasBaseline;
+};
+
+// 按来源（设备名、接口名等）区分的一组计数器
+// 每轮采样对仍存在的来源调用 update()，最后调用 sweep() 清除本轮没有出现的来源（设备被移除）
+class CounterRateTable {
+public:
+    explicit CounterRateTable(int counterBits = 64);
+
+    double update(const char *key, size_t keyLength, quint64 value, MonotonicNs timestamp);
+    double update(const QByteArray &key, quint64 value, MonotonicNs timestamp);
+
+    void sweep();
+    void clear();
+    int size() const { return m_entries.size(); }
+
+private:
+    struct Entry {
+        CounterRate rate;
+        quint32 generation;
+    };
+
+    int m_counterBits;
+    quint32 m_generation;
+    QHash<QByteArray, Entry> m_entries;
+};
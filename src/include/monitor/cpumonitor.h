@@ -2,6 +2,44 @@
 #pragma once
 
 #include <QObject>
+#include <QVector>
+#include <vector>
+#include "procfsreader.h"
+
+// /proc/stat 中所有 cpu 行的 jiffy 计数表
+// 按字段分列存放（结构数组 SoA）：第 0 行为汇总的 "cpu" 行，第 i+1 行对应 "cpuI"，
+// 差值在一次按列遍历中完成，循环体只有连续数组上的算术运算，便于编译器向量化
+class CpuStatTable {
+public:
+    enum Field { User, Nice, System, Idle, IoWait, Irq, SoftIrq, Steal, Guest, GuestNice, FieldCount };
+
+    // 解析一次 /proc/stat 的内容并计算与上一次的差值，首次调用只建立基线
+    bool update(const char *begin, const char *end);
+
+    int coreCount() const { return m_rows > 0 ? m_rows - 1 : 0; }
+
+    // 第 0 项为汇总值，第 i+1 项为 cpuI，单位均为百分比
+    const QVector<double> &usage() const { return m_usage; }
+    const QVector<double> &iowait() const { return m_iowait; }
+    const QVector<double> &steal() const { return m_steal; }
+
+private:
+    void resize(int rows);
+
+    int m_rows = 0;
+    bool m_hasBaseline = false;
+    std::vector<quint64> m_current[FieldCount];
+    std::vector<quint64> m_previous[FieldCount];
+    std::vector<quint8> m_seen;      // 本次读数中出现的行；离线的核不会出现在 /proc/stat 中
+    std::vector<quint8> m_primed;    // 已有上一次读数的行，新上线的核第一次出现时只建立基线
+    std::vector<quint64> m_deltaTotal;
+    std::vector<quint64> m_deltaIdle;
+    std::vector<quint64> m_deltaIowait;
+    std::vector<quint64> m_deltaSteal;
+    QVector<double> m_usage;
+    QVector<double> m_iowait;
+    QVector<double> m_steal;
+};
 
 class CpuMonitor : public QObject {
     Q_OBJECT
@@ -10,6 +48,14 @@ public:
     explicit CpuMonitor(QObject *parent = nullptr);
     double getCpuUsage() const;
 
+    // 最近一次 getCpuUsage() 得到的每核统计（Linux），不会触发新的读取
+    int coreCount() const;
+    QVector<double> coreUsage() const;
+    QVector<double> coreIowait() const;
+    QVector<double> coreSteal() const;
+    double iowaitPercent() const;
+    double stealPercent() const;
+
 private:
 #ifdef Q_OS_WIN
          // Windows-specific handles and data
@@ -18,7 +64,7 @@ private:
     void *queryHandle;
     void *counterHandle;
 #elif defined(Q_OS_LINUX)
-    quint64 lastTotalUser, lastTotalUserLow, lastTotalSys, lastTotalIdle;
-    bool initialized;
+    mutable ProcfsFile m_statFile;
+    mutable CpuStatTable m_table;
 #endif
 };
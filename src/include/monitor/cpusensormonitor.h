@@ -0,0 +1,78 @@
+// cpusensormonitor.h
+#pragma once
+
+#include <QtGlobal>
+#include <QString>
+#include <QVector>
+#include <string>
+#include <vector>
+#include "src/include/common/monotonicclock.h"
+#include "procfsreader.h"
+
+// CPU 频率和温度，用来判断使用率或延迟的变化是否伴随降频
+struct CpuSensorStats {
+    bool frequencyValid = false;
+    QVector<double> coreFrequencyMHz;  // 当前频率 (MHz)，下标为 CPU 编号；离线或不支持 cpufreq 的核为 0
+    double averageFrequencyMHz = 0.0;  // 只统计读取成功的核
+    double minFrequencyMHz = 0.0;
+    double maxFrequencyMHz = 0.0;
+    double ratedMaxFrequencyMHz = 0.0; // cpuinfo_max_freq 中的最大值，当前频率明显低于它时说明在降频
+
+    bool temperatureValid = false;
+    double packageTemperature = 0.0;   // 封装温度 (°C)，多路 CPU 取最高
+    QString temperatureSource;         // 读数来源，例如 coretemp、k10temp、x86_pkg_temp
+};
+
+// 读取 /sys/devices/system/cpu/cpu*/cpufreq/scaling_cur_freq 和 CPU 封装温度
+// 所有文件在发现时打开并常驻，每次采样对每个文件 pread 一次，不遍历目录也不解析 /proc/cpuinfo，
+// 128 核的机器上每周期也只是 128 次小文件读取。
+// 温度按以下优先级选择一类传感器，同一类有多个（多路 CPU）时取最高值：
+//   hwmon 的 coretemp "Package id N" / k10temp、zenpower 的 Tdie、Tctl
+//   -> thermal_zone 类型 x86_pkg_temp -> 名称含 cpu / soc 的 thermal_zone（ARM）-> acpitz
+// CPU 热插拔后核的集合会变化，每 60 秒重新发现一次
+class CpuSensorMonitor {
+public:
+    // sysfsRoot 为 sysfs 挂载点，为空时为 /sys
+    explicit CpuSensorMonitor(const char *sysfsRoot = nullptr);
+
+    CpuSensorMonitor(const CpuSensorMonitor &) = delete;
+    CpuSensorMonitor &operator=(const CpuSensorMonitor &) = delete;
+
+    // 既没有 cpufreq 也没有温度传感器（虚拟机、容器内、非 Linux）时返回 false
+    bool isAvailable() const;
+
+    // 读取一轮，频率或温度任一项读取成功即返回 true
+    bool refresh();
+    const CpuSensorStats &stats() const { return m_stats; }
+
+    // 重新查找核和传感器并重新打开文件
+    void rescan();
+
+private:
+#ifdef Q_OS_LINUX
+    struct CoreFrequencyFile {
+        int cpu;
+        ProcfsFile file;
+    };
+
+    struct TemperatureFile {
+        int priority;
+        QString source;
+        ProcfsFile file;
+    };
+
+    void scanFrequencyFiles();
+    void scanHwmonSensors();
+    void scanThermalZones();
+    void addTemperatureFile(int priority, const QString &source, const std::string &path);
+    bool readFrequencies();
+    bool readTemperatures();
+
+    std::string m_root;
+    std::vector<CoreFrequencyFile> m_frequencyFiles;   // 按 CPU 编号排序
+    std::vector<TemperatureFile> m_temperatureFiles;   // 只保留优先级最高的一类
+    ProcfsFile m_scratch;                              // 发现阶段一次性读取 name、type、label 等文件
+    MonotonicNs m_lastScan;
+#endif
+    CpuSensorStats m_stats;
+};
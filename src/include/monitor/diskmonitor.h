@@ -2,18 +2,66 @@
 #pragma once
 
 #include <QObject>
+#include <QPair>
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QByteArray>
+#include "procfsreader.h"
+#include "counterrate.h"
+
+// 单个块设备在最近一个采样间隔内的统计（与 iostat -x 的含义一致）
+struct DiskDeviceStats {
+    QString name;
+    bool physical = false;        // 叶子设备（没有下层 slaves），只有这些设备计入总读写速率
+    double readIops = 0.0;        // 每秒完成的读请求数
+    double writeIops = 0.0;
+    double readBytesPerSec = 0.0;
+    double writeBytesPerSec = 0.0;
+    double utilization = 0.0;     // 设备忙碌时间占比 (%)，来自 io_ticks
+    double queueDepth = 0.0;      // 平均队列深度，来自加权 I/O 时间
+    double readAwaitMs = 0.0;     // 本间隔内读请求的平均耗时（含排队）
+    double writeAwaitMs = 0.0;
+};
 
 class DiskMonitor : public QObject {
     Q_OBJECT
 
 public:
     explicit DiskMonitor(QObject *parent = nullptr);
-    double getDiskIO() const; // 返回某时间段内读写变化量的估计值
+    double getDiskIO() const; // 返回读写速率之和 (MB/s)
+
+    // 返回读、写速率 (字节/秒)，按两次读取之间实际经过的时间换算（一次读取 /proc/diskstats 同时得到两者）
+    QPair<quint64, quint64> getDiskIODetailed() const;
+
+    // 最近一次 getDiskIODetailed() 同时算出的逐设备统计，不会再次读取 /proc
+    // 只包含整盘设备（sda、nvme0n1、dm-0、md0、vda ...），不包含分区
+    const QVector<DiskDeviceStats> &deviceStats() const { return m_deviceStats; }
 
 private:
+    mutable QVector<DiskDeviceStats> m_deviceStats;
+
 #ifdef Q_OS_WIN
     quint64 lastReadBytes, lastWriteBytes;
 #elif defined(Q_OS_LINUX)
-    quint64 lastReadSectors, lastWriteSectors;
+    // 一个块设备的全部计数器，设备首次出现时查询一次 /sys/block 确定类型
+    // 内核以 unsigned int 输出各个耗时字段，按 32 位计数器处理回绕
+    struct Device {
+        CounterRate reads, writes;
+        CounterRate readSectors, writeSectors;
+        CounterRate readTicks = CounterRate(32), writeTicks = CounterRate(32);        // 毫秒
+        CounterRate ioTicks = CounterRate(32), weightedTicks = CounterRate(32);       // 毫秒
+        quint32 generation;
+        bool wholeDisk;   // /sys/block 下存在该设备，即不是分区
+        bool physical;    // 没有 slaves 的叶子设备，且不是 loop/ram/zram
+        bool loopLike;    // loop/ram 设备，没有任何 I/O 时不显示
+    };
+
+    Device &device(const char *name, size_t length) const;
+    void sweepDevices() const;
+
+    mutable ProcfsFile m_diskstatsFile;
+    mutable QHash<QByteArray, Device> m_devices;
+    mutable quint32 m_generation;
 #endif
 };
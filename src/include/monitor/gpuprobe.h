@@ -0,0 +1,77 @@
+// gpuprobe.h
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QThread>
+#include <QSocketNotifier>
+
+enum GpuVendor {
+    GpuVendorUnknown,
+    GpuVendorNvidia,
+    GpuVendorAmd,
+    GpuVendorIntel
+};
+
+// 一次探测的结果
+struct GpuInfo {
+    bool available = false;
+    GpuVendor vendor = GpuVendorUnknown;
+    QString name;
+    QString driverVersion;
+    QString pciAddress;              // 例如 0000:01:00.0，只有通过 sysfs 找到时才有
+    QString devicePath;              // /sys/class/drm/cardN/device，遥测可以直接读取其中的文件
+
+    bool operator==(const GpuInfo &other) const {
+        return available == other.available && vendor == other.vendor && name == other.name
+            && driverVersion == other.driverVersion && pciAddress == other.pciAddress && devicePath == other.devicePath;
+    }
+    bool operator!=(const GpuInfo &other) const { return !(*this == other); }
+};
+
+// GPU 发现
+// 探测可能要启动 nvidia-smi / lspci / wmic 并等待数秒，所以只在工作线程上执行，结果缓存在 info() 中。
+// 首次探测之后，只有 drm 设备热插拔（内核 uevent）或慢速定时器到期时才重新探测，
+// 采样周期内只读取缓存，不再启动任何进程
+class GpuProbe : public QObject {
+    Q_OBJECT
+
+public:
+    explicit GpuProbe(QObject *parent = nullptr);
+    ~GpuProbe();
+
+    // 开始首次探测，并启用热插拔监听和定时复查；重复调用只会更新复查间隔
+    void start(int recheckIntervalMs = 5 * 60 * 1000);
+
+    // 安排一次重新探测；已有探测在进行时，结束后再补做一次
+    void requestProbe();
+
+    bool hasResult() const { return m_hasResult; }
+    const GpuInfo &info() const { return m_info; }
+
+    // 同步执行一次完整探测，可能阻塞数秒，只应在工作线程中调用
+    static GpuInfo detect();
+
+signals:
+    // 首次探测完成以及之后结果发生变化时发出（在 GpuProbe 所在线程）
+    void gpuInfoChanged(const GpuInfo &info);
+
+private:
+    void launchProbe();
+    void applyResult(const GpuInfo &info);
+#ifdef Q_OS_LINUX
+    void openUeventSocket();
+    void readUevents();
+
+    int m_ueventFd;
+    QSocketNotifier *m_ueventNotifier;
+#endif
+
+    QTimer *m_recheckTimer;
+    QTimer *m_debounceTimer;         // 插拔一块卡会连续产生多条 uevent，合并为一次探测
+    QThread *m_worker;
+    bool m_probePending;
+    bool m_hasResult;
+    GpuInfo m_info;
+};
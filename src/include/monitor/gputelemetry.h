@@ -0,0 +1,159 @@
+// gputelemetry.h
+#pragma once
+
+#include <QObject>
+#include <QProcess>
+#include <QTimer>
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <memory>
+#include "src/include/common/monotonicclock.h"
+#include "gpuprobe.h"
+#include "procfsreader.h"
+
+// 单个进程占用的显存
+struct GpuProcessMemory {
+    quint32 pid = 0;
+    quint64 memoryUsed = 0;          // 字节；驱动不提供（如 Windows WDDM 模式）时为 0
+};
+
+// 一次 GPU 遥测读数
+struct GpuSample {
+    bool valid = false;
+    double usage = 0.0;              // 利用率 (%)
+    double temperature = 0.0;        // 核心温度 (°C)
+    quint64 memoryUsed = 0;          // 显存（字节）
+    quint64 memoryTotal = 0;
+    double power = 0.0;              // 功耗 (W)，来源不支持时为 0
+    QVector<GpuProcessMemory> processes;  // 按显存从大到小排序；只有 NVML 提供
+    MonotonicNs timestamp = 0;
+};
+
+// GPU 遥测来源
+// Sampler / ThreadedSampler 只通过这个接口读取，具体来源由 create() 按探测结果选择，
+// 在探测结果变化时重新创建，采样周期内只调用 read()
+class GpuTelemetrySource {
+public:
+    virtual ~GpuTelemetrySource() {}
+
+    virtual const char *name() const = 0;
+
+    // 以采样间隔开始 / 停止后台采集；直接读取的来源不需要，默认为空
+    virtual void start(int intervalMs) { Q_UNUSED(intervalMs); }
+    virtual void stop() {}
+
+    // 最近一次读数；没有有效数据时返回 false，sample.valid 为 false
+    virtual bool read(GpuSample &sample) = 0;
+
+    // NVIDIA：优先使用 NVML，库不存在或初始化失败时不提示，直接改用常驻 nvidia-smi；
+    // AMD：amdgpu sysfs；其他厂商或不可用时返回空
+    static std::unique_ptr<GpuTelemetrySource> create(const GpuInfo &info);
+};
+
+// 常驻的 nvidia-smi 子进程
+// 以 -lms 循环模式运行，按间隔持续输出 CSV，标准输出到达时逐行增量解析，不再每次采样启动一个进程。
+// 子进程退出、启动失败或长时间没有输出时按指数退避重启（1 秒起，最长 60 秒），收到有效数据后退避复位。
+// 环境变量 MONITOR_NVIDIA_SMI 可以替换要启动的程序，例如用一个按相同格式输出的脚本代替真实的 nvidia-smi
+class NvidiaSmiTelemetry : public QObject, public GpuTelemetrySource {
+    Q_OBJECT
+
+public:
+    // device 原样传给 nvidia-smi -i，可以是 PCI 地址（与探测结果一致）、序号或 UUID；
+    // 为空时不限定设备，取序号为 0 的 GPU
+    explicit NvidiaSmiTelemetry(const QString &device = QString(), QObject *parent = nullptr);
+    ~NvidiaSmiTelemetry();
+
+    const char *name() const override { return "nvidia-smi"; }
+
+    // 启动（或以新的间隔重新启动）子进程
+    void start(int intervalMs = 1000) override;
+    void stop() override;
+    bool isRunning() const { return m_running; }
+    QString device() const { return m_device; }
+
+    // 子进程下一次退出后等待多久再重启；收到有效数据后复位为 1 秒
+    int nextRestartDelayMs() const { return m_backoffMs; }
+
+    bool read(GpuSample &sample) override;
+
+    // 最近一次解析到的读数；超过若干个间隔没有新数据时 valid 为 false
+    GpuSample latest() const;
+
+    // 要启动的程序：MONITOR_NVIDIA_SMI，未设置时为 nvidia-smi
+    static QString program();
+
+    // 解析一行 "index, utilization.gpu, temperature.gpu, memory.used, memory.total"（nounits，显存单位 MiB）
+    // [N/A]、[Not Supported] 等字段按 0 处理
+    static bool parseLine(const char *begin, const char *end, int &index, GpuSample &sample);
+
+signals:
+    void sampleReady(const GpuSample &sample);
+
+private:
+    void launch();
+    void readOutput();
+    void handleExit();
+    void scheduleRestart();
+
+    QProcess *m_process;
+    QTimer *m_restartTimer;
+    QTimer *m_watchdogTimer;         // 子进程还在但不再输出（驱动卡住）时强制结束并重启
+    QByteArray m_buffer;             // 尚未收到换行的残余输出
+    GpuSample m_latest;
+    int m_intervalMs;
+    QString m_device;
+    int m_backoffMs;
+    bool m_running;
+};
+
+// AMD GPU 的 sysfs 遥测（amdgpu 驱动）
+// gpu_busy_percent、mem_info_vram_used / total 和 hwmon 的 temp1_input 常驻打开，每次采样 pread 一次，不依赖 rocm-smi
+class AmdSysfsTelemetry : public GpuTelemetrySource {
+public:
+    // devicePath 为 /sys/class/drm/cardN/device
+    explicit AmdSysfsTelemetry(const QString &devicePath);
+
+    AmdSysfsTelemetry(const AmdSysfsTelemetry &) = delete;
+    AmdSysfsTelemetry &operator=(const AmdSysfsTelemetry &) = delete;
+
+    const char *name() const override { return "amdgpu-sysfs"; }
+
+    // 读取失败（设备已移除或不是 amdgpu）时 sample.valid 为 false
+    bool read(GpuSample &sample) override;
+
+private:
+    ProcfsFile m_busyFile;
+    ProcfsFile m_vramUsedFile;
+    ProcfsFile m_vramTotalFile;
+    ProcfsFile m_temperatureFile;    // 毫摄氏度；没有 hwmon 时路径为空
+};
+
+struct NvmlLibrary;
+
+// NVML 遥测（libnvidia-ml）
+// 运行时 dlopen 加载，编译和运行都不依赖 NVIDIA 驱动；读取利用率、显存、温度、功耗和各进程显存，不启动任何进程。
+// 环境变量 MONITOR_NVML_LIBRARY 可以指定要加载的库，例如一个导出相同符号的桩库；未设置时为 libnvidia-ml.so.1
+class NvmlTelemetry : public GpuTelemetrySource {
+public:
+    NvmlTelemetry();
+    ~NvmlTelemetry() override;
+
+    NvmlTelemetry(const NvmlTelemetry &) = delete;
+    NvmlTelemetry &operator=(const NvmlTelemetry &) = delete;
+
+    // 加载库、初始化 NVML 并取得设备；pciAddress 为空或找不到时使用 0 号设备。
+    // 任何一步失败都返回 false，对象保持关闭，调用方改用其他来源
+    bool open(const QString &pciAddress);
+    void close();
+    bool isOpen() const { return m_nvml != nullptr; }
+
+    const char *name() const override { return "nvml"; }
+    bool read(GpuSample &sample) override;
+
+    // 要加载的库：MONITOR_NVML_LIBRARY，未设置时为 libnvidia-ml.so.1
+    static QByteArray libraryPath();
+
+private:
+    std::unique_ptr<NvmlLibrary> m_nvml;
+};
@@ -2,11 +2,28 @@
 #pragma once
 
 #include <QObject>
+#include "counterrate.h"
+#include "procfsreader.h"
 
 #ifdef Q_OS_WIN
 #include <windows.h>
 #endif
 
+// /proc/vmstat 中反映内存压力的计数器速率（每秒）
+// 页缓存占满内存是正常的，只有下面这些速率持续不为 0 才说明内存真的不够用
+struct VmstatRates {
+    bool valid = false;
+    double majorFaults = 0.0;        // pgmajfault：需要从磁盘读回页面的缺页
+    double swapIns = 0.0;            // pswpin / pswpout：换入 / 换出的页数
+    double swapOuts = 0.0;
+    double pagesScanned = 0.0;       // pgscan_*：回收时扫描的页数（kswapd + 直接回收 + ...）
+    double pagesStolen = 0.0;        // pgsteal_*：回收成功的页数
+    double directScanned = 0.0;      // pgscan_direct：分配内存的进程自己被迫回收，会直接造成延迟
+    double compactStalls = 0.0;      // compact_stall：分配时被迫同步做内存规整的次数
+    double oomKills = 0.0;           // oom_kill
+    quint64 oomKillTotal = 0;        // 开机以来的 OOM kill 总次数
+};
+
 class MemoryMonitor : public QObject {
     Q_OBJECT
 
@@ -15,6 +32,12 @@ public:
     double getMemoryUsage() const;
     quint64 getTotalMemory() const;
     quint64 getUsedMemory() const;
+
+    // 一次读取同时得到总量和已用量（字节），避免同一采样周期内多次读取 /proc/meminfo
+    bool getMemoryStats(quint64 &total, quint64 &used) const;
+
+    // 读取一次 /proc/vmstat，返回距上一次调用的各项速率；首次调用只建立基线，速率为 0
+    bool getVmstatRates(VmstatRates &rates) const;
     
     // 内存泄漏检测功能
 #ifdef _MSC_VER
@@ -25,6 +48,23 @@ private:
 #ifdef Q_OS_WIN
     MEMORYSTATUSEX memoryStatus;
 #elif defined(Q_OS_LINUX)
-         // 无需缓存成员变量
+    // 一次遍历 /proc/meminfo，取出计算所需的字段（单位 kB）
+    bool readMeminfo(quint64 &totalKb, quint64 &freeKb, quint64 &buffersKb, quint64 &cachedKb) const;
+
+    mutable ProcfsFile m_meminfoFile;
+
+    enum VmstatCounter {
+        VmstatMajorFaults,
+        VmstatSwapIns,
+        VmstatSwapOuts,
+        VmstatScanned,
+        VmstatStolen,
+        VmstatDirectScanned,
+        VmstatCompactStalls,
+        VmstatOomKills,
+        VmstatCounterCount
+    };
+    mutable ProcfsFile m_vmstatFile;
+    mutable CounterRate m_vmstatRates[VmstatCounterCount];
 #endif
 };
@@ -3,13 +3,37 @@
 
 #include <QObject>
 #include <QPair>
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QByteArray>
+#include <memory>
+#include "procfsreader.h"
+#include "counterrate.h"
+#include "socketdiag.h"
 
 #ifdef Q_OS_WIN
-#ifdef _WIN32
-#include <windows.h>
+#ifdef _WIN32
+#include <windows.h>
 #endif
 #endif
 
+// 单个网络接口在最近一个采样间隔内的统计，速率均为每秒
+struct NetworkInterfaceStats {
+    QString name;
+    bool isVirtual = false;          // lo、veth、网桥、tun 等没有底层设备的接口
+    double rxBytesPerSec = 0.0;
+    double txBytesPerSec = 0.0;
+    double rxPacketsPerSec = 0.0;
+    double txPacketsPerSec = 0.0;
+    double rxErrorsPerSec = 0.0;
+    double txErrorsPerSec = 0.0;
+    double rxDropsPerSec = 0.0;
+    double txDropsPerSec = 0.0;
+    quint64 rxBytesTotal = 0;        // 计数器当前值
+    quint64 txBytesTotal = 0;
+};
+
 class NetworkMonitor : public QObject {
     Q_OBJECT
 
@@ -19,20 +43,54 @@ public:
     // 返回下载+上传速率的估算值（单位 MB/s）
     double getNetworkUsage() const;
     
-    // 返回上传和下载速率的分离值（单位 bytes/s）
+    // 返回上传和下载速率的分离值（单位 bytes/s），按两次读取之间实际经过的时间换算
+    // Linux 下只统计物理接口，避免同一份流量经过网桥/veth 时被重复计算；没有物理接口时统计除 lo 外的全部接口
     QPair<quint64, quint64> getNetworkUsageDetailed() const;
+
+    // 最近一次 getNetworkUsageDetailed() 同时算出的逐接口统计，不会再次读取 /proc
+    const QVector<NetworkInterfaceStats> &interfaceStats() const { return m_interfaceStats; }
+
+    // 逐进程的 TCP/UDP 流量和连接数（Linux 下通过 sock_diag 获取），按流量从高到低排列；
+    // 每次调用导出一次全部套接字，速率按两次调用之间的时间换算。其他平台返回空列表。
+    // 已经有启用了网络归属的 ProcessMonitor 时应使用 ProcessMonitor::networkStats()，避免重复导出
+    QVector<ProcessNetworkStats> getProcessNetworkStats() const;
     
     // 获取当前活跃的网络接口索引
 #ifdef Q_OS_WIN
     DWORD getActiveNetworkInterface() const;
 #else
+    // 取最近一次采样中流量最大的物理接口，返回其 ifindex
     unsigned long getActiveNetworkInterface() const;
 #endif
 
 private:
-#ifdef Q_OS_WIN
-    mutable quint64 lastRecvBytes, lastSentBytes;
-#elif defined(Q_OS_LINUX)
-    mutable quint64 lastRecvBytes, lastSentBytes;
+    mutable QVector<NetworkInterfaceStats> m_interfaceStats;
+
+#ifdef Q_OS_LINUX
+    // /proc/net/dev 冒号后的 16 列，前 8 列为接收，后 8 列为发送
+    enum NetDevField {
+        RxBytes, RxPackets, RxErrors, RxDrops, RxFifo, RxFrame, RxCompressed, RxMulticast,
+        TxBytes, TxPackets, TxErrors, TxDrops, TxFifo, TxColls, TxCarrier, TxCompressed,
+        NetDevFieldCount
+    };
+
+    // 一个接口的全部计数器，接口首次出现时查询一次 /sys/class/net 确定是否为虚拟接口
+    struct Interface {
+        CounterRate rates[NetDevFieldCount];
+        quint32 generation;
+        bool isVirtual;
+    };
+
+    Interface &networkInterface(const char *name, size_t length) const;
+    void sweepInterfaces() const;
+
+    mutable ProcfsFile m_netDevFile;
+    mutable QHash<QByteArray, Interface> m_interfaces;
+    mutable quint32 m_generation;
+    mutable std::unique_ptr<SocketDiagCollector> m_socketDiag; // 首次调用 getProcessNetworkStats() 时创建
+#else
+    // 按接口区分的收发字节计数器
+    mutable CounterRateTable m_recvRates;
+    mutable CounterRateTable m_sentRates;
 #endif
 };
@@ -0,0 +1,71 @@
+// pressuremonitor.h
+#pragma once
+
+#include <QtGlobal>
+#include <QString>
+#include <string>
+#include <vector>
+#include "counterrate.h"
+#include "procfsreader.h"
+
+enum PressureResource {
+    PressureCpu,
+    PressureMemory,
+    PressureIo,
+    PressureResourceCount
+};
+
+// 一种资源的压力停顿信息（PSI）
+// some：至少有一个任务在等待该资源的时间占比；full：所有非空闲任务同时在等待的时间占比
+struct PressureStats {
+    bool valid = false;
+    double someAvg10 = 0.0;          // 内核计算的 10 秒 / 60 秒滑动平均 (%)
+    double someAvg60 = 0.0;
+    double fullAvg10 = 0.0;          // 整机的 cpu 在 5.13 之前没有 full 行，保持为 0
+    double fullAvg60 = 0.0;
+    double someStallPercent = 0.0;   // 由 total 增量换算的最近一个采样间隔内的停顿占比 (%)
+    double fullStallPercent = 0.0;
+    quint64 someTotalUs = 0;         // 累计停顿时间（微秒）
+    quint64 fullTotalUs = 0;
+};
+
+// 读取 /proc/pressure/{cpu,memory,io}，或某个 cgroup v2 目录下的 {cpu,memory,io}.pressure
+// 文件常驻打开，每次采样 pread 一次。
+// 触发器模式向压力文件写入 "some 200000 2000000" 这样的阈值（窗口内停顿的微秒数），
+// 超过阈值时内核让该 fd 产生 POLLPRI，调用方把它加入自己的 poll / QSocketNotifier，由停顿事件唤醒采样
+class PressureMonitor {
+public:
+    // cgroupPath 为空表示整机，否则为 /sys/fs/cgroup 下的相对路径，例如 "system.slice/nginx.service"
+    explicit PressureMonitor(const QString &cgroupPath = QString());
+    ~PressureMonitor();
+
+    PressureMonitor(const PressureMonitor &) = delete;
+    PressureMonitor &operator=(const PressureMonitor &) = delete;
+
+    // 内核没有启用 PSI（CONFIG_PSI=n 或 psi=0）、cgroup 不存在或不是 Linux 时返回 false
+    bool isAvailable() const;
+
+    // 重新读取三种资源，任一种读取成功即返回 true
+    bool refresh();
+    const PressureStats &stats(PressureResource resource) const { return m_stats[resource]; }
+
+    // 注册触发器：windowMs 窗口内停顿超过 stallMs 时触发。返回可以 poll(POLLPRI) 的 fd，失败返回 -1。
+    // 窗口必须在 500ms 到 10s 之间；非特权进程的窗口还必须是 2 秒的整数倍
+    int addTrigger(PressureResource resource, bool full, int stallMs, int windowMs);
+    const std::vector<int> &triggerFds() const { return m_triggerFds; }
+    void clearTriggers();
+
+private:
+#ifdef Q_OS_LINUX
+    bool readResource(int resource, MonotonicNs now);
+    std::string resourcePath(int resource) const;
+
+    std::string m_directory;   // 以 '/' 结尾
+    bool m_cgroup;
+    ProcfsFile m_files[PressureResourceCount];
+    CounterRate m_someRates[PressureResourceCount];
+    CounterRate m_fullRates[PressureResourceCount];
+#endif
+    PressureStats m_stats[PressureResourceCount];
+    std::vector<int> m_triggerFds;
+};
@@ -0,0 +1,40 @@
+// processeventsource.h
+#pragma once
+
+#include <QObject>
+#include <QtGlobal>
+
+class QSocketNotifier;
+
+// 通过 netlink 进程连接器（NETLINK_CONNECTOR / CN_IDX_PROC）接收内核的进程事件
+// 内核在 fork、exec、exit 时主动推送消息，不需要轮询 /proc，两次扫描之间启动又退出的短命进程也不会漏掉。
+// 订阅需要 CAP_NET_ADMIN，start() 失败时调用方应继续使用全量扫描；非 Linux 平台上 start() 总是返回 false
+class ProcessEventSource : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ProcessEventSource(QObject *parent = nullptr);
+    ~ProcessEventSource();
+
+    // 打开 netlink 套接字并订阅进程事件，成功后在所属线程的事件循环中分发信号
+    bool start();
+    void stop();
+    bool isActive() const { return m_socket >= 0; }
+
+signals:
+    // 只报告进程（线程组）级别的事件，线程的创建和退出被忽略
+    void processForked(quint32 parentPid, quint32 childPid);
+    void processExeced(quint32 pid);
+    void processExited(quint32 pid, int exitStatus); // exitStatus 与 waitpid() 的 status 相同
+    // 套接字接收缓冲区溢出，期间的事件已经丢失，调用方需要做一次全量扫描
+    void eventsLost();
+
+private slots:
+    void readEvents();
+
+private:
+    bool subscribe(bool listen);
+
+    int m_socket;
+    QSocketNotifier *m_notifier;
+};
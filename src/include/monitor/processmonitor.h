@@ -4,12 +4,204 @@
 #include <QObject>
 #include <QString>
 #include <QList>
+#include <QHash>
+#include <QVector>
 #include "../common/processinfo.h"
+#include "src/include/common/monotonicclock.h"
+#include "procfsreader.h"
+#ifdef Q_OS_LINUX
+#include <dirent.h>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "procfsbatchreader.h"
+#include "socketdiag.h"
+#include "workstealingpool.h"
+#endif
+
+class ProcessEventSource;
 
 class ProcessMonitor : public QObject {
     Q_OBJECT
 
 public:
+    // 进程排名依据
+    enum RankKey {
+        RankByCpu,
+        RankByMemory,
+        RankByIo,
+        RankByThreads,
+        RankByNetwork,      // 需要先 setNetworkAttributionEnabled(true)
+        RankByPss           // 需要先 setAccurateMemoryEnabled(true)，没有读到 smaps_rollup 的进程按 RSS 计
+    };
+
+    // 读取 /proc/[pid]/ 文件的方式
+    enum ScanBackend {
+        ScanWithPread,      // 每个文件 openat + pread + close
+        ScanWithIoUring     // io_uring 批量提交，一批文件只需一次系统调用
+    };
+
     explicit ProcessMonitor(QObject *parent = nullptr);
-    QList<ProcessInfo> getTopProcesses(int maxCount = 10);
+    ~ProcessMonitor();
+
+    // 按 key 返回排名前 maxCount 的进程（从高到低），扫描时只保留前 K 名，不构造完整列表。
+    // Linux 下不触发刷新，排名的是最近一次 refresh() 的进程表
+    QList<ProcessInfo> getTopProcesses(int maxCount = 10, RankKey key = RankByMemory);
+
+#ifdef Q_OS_LINUX
+    // 增量刷新进程表：每个进程只读取一次 /proc/[pid]/stat，
+    // 已知进程只更新会变化的字段，不分配内存；消失的进程在本轮结束时清除
+    void refresh();
+    int processCount() const { return m_table.size(); }
+
+    // 是否已经刷新过至少一次，即下一次刷新能否得到真实的 CPU 占用（首次刷新时全部为 0）
+    bool hasCpuBaseline() const { return m_generation > 0; }
+
+    // 扫描 /proc 使用的线程数（包括调用线程），1 为串行扫描；进程数较少时总是串行，避免线程切换开销
+    void setScanThreadCount(int count);
+    int scanThreadCount() const { return m_scanThreadCount; }
+
+    // 切换读取方式；内核不支持 io_uring 时返回 false 并保持逐个读取。两种方式共用同一套解析代码。
+    // io_uring 在运行中提交失败（被 seccomp 拦截、资源不足）时自动切回 ScanWithPread
+    bool setScanBackend(ScanBackend backend);
+    ScanBackend scanBackend() const { return m_scanBackend; }
+
+    // 在 ProcessInfo 中附带每个进程的 TCP/UDP 流量和连接数，每次 refresh() 额外做一次 sock_diag 导出
+    void setNetworkAttributionEnabled(bool enabled);
+    // 最近一次 refresh() 导出的逐进程网络统计，按流量从高到低排列；未启用时为空。
+    // 需要逐进程网络统计的其他模块应读取这里，不要再建一个 SocketDiagCollector 重复导出
+    QVector<ProcessNetworkStats> networkStats() const;
+
+    // 精确内存统计：读取 /proc/[pid]/smaps_rollup 得到 PSS、USS 和 swap。
+    // 读取一次要遍历进程的全部内存映射，代价远高于 stat，所以只读 RSS 最大的 topN 个进程，
+    // 间隔不小于 minIntervalMs，并按实际耗时自动拉长，使其占用的时间不超过 1%
+    void setAccurateMemoryEnabled(bool enabled, int topN = 32, int minIntervalMs = 5000);
+    bool accurateMemoryEnabled() const { return m_smapsTopN > 0; }
+
+    // 最近一次 refresh() 的耗时（纳秒）
+    qint64 lastScanNs() const { return m_lastScanNs; }
+
+    // 进程表中的全部进程，不触发刷新
+    QList<ProcessInfo> processes() const;
+
+    // 已退出的进程
+    struct ExitedProcess {
+        quint64 pid;
+        QString name;
+        QString commandLine;
+        double cpuSeconds;      // 最后一次读取到的累计 CPU 时间
+        int exitStatus;         // 与 waitpid() 的 status 相同
+        MonotonicNs exitTime;
+    };
+
+    // 订阅 netlink 进程事件（fork/exec/exit）。成功后进程表在两次刷新之间随事件更新，
+    // refresh() 只重新读取表中已知的进程，不再枚举 /proc，每隔 reconcileIntervalMs 才全量扫描一次校正；
+    // 没有 CAP_NET_ADMIN 时返回 false，refresh() 照常每次全量扫描
+    bool enableProcessEvents(int reconcileIntervalMs = 30000);
+    bool processEventsActive() const;
+
+    // 最近退出的进程（最新的在前），包括两次刷新之间启动又退出的短命进程；只有启用进程事件时才会记录
+    QList<ExitedProcess> recentlyExited() const;
+#endif
+
+private:
+#ifdef Q_OS_LINUX
+    // 进程表中的一项。pid 会被复用，用 (pid, starttime) 判断是否还是同一个进程
+    struct ProcessEntry {
+        quint64 pid;
+        quint64 startTime;      // 自开机起的时钟滴答数，进程生命周期内不变
+        QString name;           // comm 和 cmdline 只在进程首次出现时读取
+        QString commandLine;
+        quint64 cpuTicks;       // utime + stime
+        double cpuPercent;      // 最近一个刷新间隔内的 CPU 占用，100% 表示占满一个核
+        quint64 rssPages;
+        int threadCount;
+        quint64 ioReadBytes;    // /proc/[pid]/io 的 read_bytes / write_bytes 累计值
+        quint64 ioWriteBytes;
+        double ioReadRate;      // 字节/秒
+        double ioWriteRate;
+        bool hasIo;             // 上一次是否读到了 io
+        bool ioDenied;          // 没有权限读取 io，该进程生命周期内不再尝试
+        quint64 pssKb;          // 最近一次读取 smaps_rollup 的结果，跌出前 N 名后保留旧值
+        quint64 ussKb;
+        quint64 swapKb;
+        bool hasSmaps;
+        bool smapsDenied;
+        quint32 generation;
+    };
+
+    // 一次 stat 读取的结果。扫描线程只读进程表，新进程额外带上 comm 和 cmdline，
+    // 写入进程表的合并步骤在调用线程中串行完成
+    struct StatSample {
+        quint64 pid;
+        quint64 startTime;
+        quint64 cpuTicks;
+        quint64 rssPages;
+        int threadCount;
+        bool isNew;
+        bool hasIo;
+        bool ioDenied;
+        quint64 ioReadBytes;
+        quint64 ioWriteBytes;
+        std::string name;
+        std::string commandLine;
+    };
+
+    // 每个扫描线程独占的读取缓冲区和结果数组；数组跨刷新复用，已知进程不产生任何分配
+    struct ScanWorker {
+        ProcfsFile file;
+        std::unique_ptr<ProcfsBatchReader> batch; // 仅 ScanWithIoUring 时创建
+        std::vector<std::pair<int, int> > batchSlots; // 本批中每个 PID 的 stat 和 io 文件序号，io 为 -1 表示不读取
+        std::vector<StatSample> samples;
+        size_t sampleCount = 0;
+    };
+
+    bool openProcDirectory();
+    void listPids();
+    void listKnownPids();
+    void scanPids(size_t begin, size_t end, ScanWorker &worker) const;
+    bool readSample(quint32 pid, ScanWorker &worker) const;
+    bool parseSample(quint32 pid, const char *begin, const char *end, ScanWorker &worker) const;
+    void readIo(quint32 pid, StatSample &sample, ScanWorker &worker) const;
+    static bool parseIo(const char *begin, const char *end, StatSample &sample);
+    void readSmapsRollup(MonotonicNs now);
+    static bool parseSmapsRollup(const char *begin, const char *end, ProcessEntry &entry);
+    bool attachBatchReaders();
+    void applySample(const StatSample &sample, double elapsedTicks);
+    double rankValue(const ProcessEntry &entry, RankKey key) const;
+    ProcessInfo toProcessInfo(const ProcessEntry &entry) const;
+
+    // 进程事件处理，在本对象所属线程的事件循环中调用
+    void handleFork(quint32 parentPid, quint32 childPid);
+    void handleExec(quint32 pid);
+    void handleExit(quint32 pid, int exitStatus);
+
+    QHash<quint64, ProcessEntry> m_table;
+    quint32 m_generation;
+    MonotonicNs m_lastRefresh;
+    double m_ticksPerSecond;
+    double m_pageMB;
+
+    DIR *m_procDir;                   // 常驻的 /proc 目录，每次刷新 rewinddir，文件用 openat 相对它打开
+    std::vector<quint32> m_pids;      // 本轮扫描到的 PID，跨刷新复用
+    std::vector<ScanWorker> m_workers;
+    std::unique_ptr<WorkStealingPool> m_pool;
+    int m_scanThreadCount;
+    ScanBackend m_scanBackend;
+    qint64 m_lastScanNs;
+
+    std::unique_ptr<SocketDiagCollector> m_socketDiag;
+
+    int m_smapsTopN;                  // 0 表示未启用精确内存统计
+    MonotonicNs m_smapsMinIntervalNs;
+    MonotonicNs m_nextSmapsRead;
+
+    ProcessEventSource *m_events;
+    MonotonicNs m_reconcileIntervalNs;
+    MonotonicNs m_lastFullScan;
+    bool m_fullScanPending;           // 事件丢失后下一次刷新必须全量扫描
+    QVector<ExitedProcess> m_exited;  // 环形缓冲区，m_exitedNext 指向下一个写入位置
+    int m_exitedNext;
+#endif
 };
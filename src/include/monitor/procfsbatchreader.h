@@ -0,0 +1,74 @@
+// procfsbatchreader.h
+#pragma once
+
+#include <QtGlobal>
+#include <vector>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+// 基于 io_uring 的 procfs 批量读取器，用于一次读取大量 /proc/[pid]/ 下的小文件
+// 每个文件提交一条 openat -> read -> close 链，fd 直接放在注册的文件槽里，不经过用户态；
+// 整批只需一次 io_uring_enter 提交并等待完成，代替逐个文件的 openat/pread/close 三次系统调用。
+// 通过原始系统调用使用 io_uring，不依赖 liburing。内核不支持（需要 5.19 以上）或被 sysctl / seccomp 禁用时
+// isAvailable() 为 false，调用方应继续使用 ProcfsFile::readOnceAt()
+class ProcfsBatchReader {
+public:
+    // capacity 为一批最多的文件数，bufferSize 为每个文件的读取缓冲区大小
+    explicit ProcfsBatchReader(int capacity = 128, size_t bufferSize = 1024);
+    ~ProcfsBatchReader();
+
+    ProcfsBatchReader(const ProcfsBatchReader &) = delete;
+    ProcfsBatchReader &operator=(const ProcfsBatchReader &) = delete;
+
+    bool isAvailable() const { return m_ringFd >= 0; }
+    int capacity() const { return m_capacity; }
+    int count() const { return m_count; }
+
+    // 开始新的一批
+    void clear() { m_count = 0; }
+
+    // 加入一个相对于 submit() 中 dirfd 的路径，返回在本批中的序号；批次已满时返回 -1
+    int add(const char *relativePath);
+
+    // 提交整批读取并等待全部完成，内核拒绝提交时返回 false
+    bool submit(int dirfd);
+
+    // 第 index 个文件的读取结果。文件不存在（进程已退出）、读取出错或内容超过缓冲区（被截断）时失败，
+    // 调用方可以对失败的文件改用普通读取
+    bool succeeded(int index) const;
+    const char *data(int index) const { return m_buffers.data() + static_cast<size_t>(index) * m_bufferSize; }
+    size_t size(int index) const { return succeeded(index) ? static_cast<size_t>(m_results[static_cast<size_t>(index)]) : 0; }
+    // 失败时的 errno，成功或被截断时为 0。打不开文件时是 openat 的错误：进程已退出为 ENOENT，无权读取为 EACCES
+    int errorCode(int index) const { return m_results[static_cast<size_t>(index)] < 0 ? -m_results[static_cast<size_t>(index)] : 0; }
+
+    // 累计发起的 io_uring_enter 次数，用于和逐个读取的系统调用次数比较
+    quint64 syscallCount() const { return m_syscalls; }
+
+private:
+    bool setup();
+    void teardown();
+    io_uring_sqe *nextSqe();
+    bool waitCompletions(unsigned toSubmit, unsigned expected);
+
+    int m_capacity;
+    size_t m_bufferSize;
+    int m_count;
+    std::vector<char> m_paths;     // 每个文件一个定长路径，提交后到完成前必须保持有效
+    std::vector<char> m_buffers;
+    std::vector<int> m_results;    // read 的返回值（字节数或 -errno）
+    quint64 m_syscalls;
+
+    int m_ringFd;
+    void *m_ringMemory;
+    size_t m_ringSize;
+    io_uring_sqe *m_sqes;
+    size_t m_sqesSize;
+    unsigned *m_sqTail;
+    unsigned m_sqMask;
+    unsigned *m_cqHead;
+    unsigned *m_cqTail;
+    unsigned m_cqMask;
+    io_uring_cqe *m_cqes;
+    unsigned m_localTail;
+};
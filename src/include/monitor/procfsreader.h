@@ -0,0 +1,94 @@
+// procfsreader.h
+#pragma once
+
+#include <QtGlobal>
+#include <string>
+#include <vector>
+
+// procfs/sysfs 文件读取器
+// 文件只打开一次，之后每次采样用 pread 从偏移 0 重新读取到复用的缓冲区，
+// 避免每次采样都构造 ifstream / istringstream
+class ProcfsFile {
+public:
+    explicit ProcfsFile(const char *path = nullptr, size_t initialCapacity = 4096);
+    ~ProcfsFile();
+
+    ProcfsFile(const ProcfsFile &) = delete;
+    ProcfsFile &operator=(const ProcfsFile &) = delete;
+    ProcfsFile(ProcfsFile &&other) noexcept;
+    ProcfsFile &operator=(ProcfsFile &&other) noexcept;
+
+    // 更换文件路径（会关闭已打开的 fd）
+    void setPath(const char *path);
+    const std::string &path() const { return m_path; }
+
+    // 重新读取整个文件，失败时返回 false（fd 失效时会自动重新打开一次）
+    bool refresh();
+
+    // 一次性读取：打开 -> 读取到复用缓冲区 -> 关闭，用于 /proc/[pid]/ 这类不适合常驻 fd 的文件
+    bool readOnce(const char *path);
+    bool readOnceAt(int dirfd, const char *relativePath);
+
+    bool isOpen() const { return m_fd >= 0; }
+    void close();
+
+    const char *data() const { return m_buffer.data(); }
+    const char *end() const { return m_buffer.data() + m_size; }
+    size_t size() const { return m_size; }
+
+private:
+    bool open();
+    bool readFd(int fd);
+
+    std::string m_path;
+    int m_fd;
+    std::vector<char> m_buffer;
+    size_t m_size;
+};
+
+// 无分配的 procfs 文本分词器，直接在 ProcfsFile 的缓冲区上移动游标
+class ProcfsTokenizer {
+public:
+    ProcfsTokenizer(const char *begin, const char *end) : m_pos(begin), m_end(end) {}
+    explicit ProcfsTokenizer(const ProcfsFile &file) : m_pos(file.data()), m_end(file.end()) {}
+
+    bool atEnd() const { return m_pos >= m_end; }
+    bool atLineEnd() const { return m_pos >= m_end || *m_pos == '\n'; }
+    const char *position() const { return m_pos; }
+
+    // 跳过空格和制表符（不跨行）
+    void skipSpaces();
+
+    // 跳到下一行行首，没有下一行时返回 false
+    bool nextLine();
+
+    // 读取下一个以空白或 ':' 结尾的单词（不跨行）
+    bool nextWord(const char *&word, size_t &length);
+
+    // 读取下一个无符号十进制整数（不跨行）
+    bool nextU64(quint64 &value);
+
+    // 读取下一个带符号十进制整数（不跨行）
+    bool nextI64(qint64 &value);
+
+    // 读取下一个非负十进制小数，例如 /proc/uptime 中的 "12345.67"
+    bool nextDouble(double &value);
+
+    // 跳过当前行中的 n 个字段
+    bool skipFields(int count);
+
+    // 在当前行中前进到字符 c 之后
+    bool skipPast(char c);
+
+    // 在当前行中前进到字符 c 最后一次出现的位置之后，用于 /proc/[pid]/stat 的 "(comm)"
+    bool skipPastLast(char c);
+
+    // 当前位置是否以给定前缀开头
+    bool startsWith(const char *prefix) const;
+
+    static bool equals(const char *word, size_t length, const char *literal);
+
+private:
+    const char *m_pos;
+    const char *m_end;
+};
@@ -3,11 +3,18 @@
 
 #include <QObject>
 #include <QTimer>
+#include <QSocketNotifier>
+#include <memory>
 #include "cpumonitor.h"
+#include "cpusensormonitor.h"
 #include "memorymonitor.h"
 #include "diskmonitor.h"
 #include "networkmonitor.h"
 #include "processmonitor.h"
+#include "pressuremonitor.h"
+#include "gpuprobe.h"
+#include "gputelemetry.h"
+#include "systemsnapshot.h"
 #include "src/include/chart/chartwidget.h"
 #include "src/include/storage/datastorage.h"
 
@@ -24,25 +31,42 @@ public:
     QString driverVersion() const { return m_driverVersion; }
     void setStorage(DataStorage *storage);
     void setChartWidgets(ChartWidget *cpu, ChartWidget *mem, ChartWidget *gpu, ChartWidget *net);
+
+    // PSI 触发器模式：CPU / 内存 / I/O 任一资源在 windowMs 内停顿超过 stallMs 时立即采集一次，
+    // 不必等到下一个定时周期。内核不支持或没有权限时返回 false，照常只按定时器采集
+    bool enablePressureTriggers(int stallMs = 200, int windowMs = 2000);
+    void disablePressureTriggers();
     
-    // ????????????????
-    double lastCpuUsage() const { return m_cpu.getCpuUsage(); }
-    double lastMemoryUsage() const { return m_memory.getMemoryUsage(); }
-    double lastDiskIO() const { return m_disk.getDiskIO(); }
-    double lastNetworkUsage() const { 
-        QPair<quint64, quint64> usage = m_network.getNetworkUsageDetailed();
-        return static_cast<double>(usage.first + usage.second) / (1024.0 * 1024.0); // ????MB
-    }
+    // 最近一次发布的快照：只读取已发布的不可变数据，不会触发 /proc 读取，
+    // 也不会移动各监视器的差值基线，可在任意线程以任意频率调用
+    std::shared_ptr<const SystemSnapshot> lastSnapshot() const { return std::atomic_load(&m_published); }
+    double lastCpuUsage() const { return lastSnapshot()->cpuUsage; }
+    double lastMemoryUsage() const { return lastSnapshot()->memoryUsage; }
+    double lastDiskIO() const { return lastSnapshot()->diskIO; }
+    double lastNetworkUsage() const { return lastSnapshot()->networkUsage; }
+
+    // 全程序共用的进程表，每个采样周期在发出信号之前刷新一次。
+    // 只能在本对象所在的线程读取；读取方只排名或遍历缓存结果，不应自行调用 refresh()
+    ProcessMonitor *processMonitor() const { return m_processes; }
 
 public slots:
     void collect();
 
 signals:
     void memoryStatsUpdated(quint64 total, quint64 used, quint64 free);
+    void vmstatUpdated(const VmstatRates &rates);
     void cpuUsageUpdated(double usage);
+    void cpuCoreStatsUpdated(const QVector<double> &usage, const QVector<double> &iowait, const QVector<double> &steal);
+    void cpuSensorStatsUpdated(const CpuSensorStats &stats);
     void networkStatsUpdated(double uploadSpeed, double downloadSpeed);
+    void networkInterfaceStatsUpdated(const QVector<NetworkInterfaceStats> &interfaces);
+    void processNetworkStatsUpdated(const QVector<ProcessNetworkStats> &processes);
+    void pressureStatsUpdated(const PressureStats &cpu, const PressureStats &memory, const PressureStats &io);
     void diskStatsUpdated(qint64 readBytes, qint64 writeBytes);
+    void diskDeviceStatsUpdated(const QVector<DiskDeviceStats> &devices);
     void gpuStatsUpdated(double usage, double temperature, quint64 memoryUsed, quint64 memoryTotal);
+    // 完整读数，包含功耗和各进程显存（来源支持时）
+    void gpuTelemetryUpdated(const GpuSample &sample);
     void gpuAvailabilityChanged(bool available, const QString& gpuName, const QString& driverVersion);
     
     // ??????????????
@@ -52,24 +76,34 @@ signals:
 private:
     QTimer *m_timer;
     CpuMonitor m_cpu;
+    CpuSensorMonitor m_cpuSensors;
     MemoryMonitor m_memory;
     DiskMonitor m_disk;
     NetworkMonitor m_network;
+    PressureMonitor m_pressure;
+    ProcessMonitor *m_processes;
+    QList<QSocketNotifier *> m_pressureNotifiers;
     DataStorage *m_storage;
+    std::shared_ptr<const SystemSnapshot> m_published; // 通过 atomic_load/atomic_store 访问
 
     ChartWidget *cpuChart;
     ChartWidget *memChart;
     ChartWidget *gpuChart;
     ChartWidget *netChart;
 
+    // GPU 发现在 GpuProbe 的工作线程中完成，这里只保存最近一次的结果
+    GpuProbe *m_gpuProbe;
+    std::unique_ptr<GpuTelemetrySource> m_gpuTelemetry;
     bool m_gpuAvailable;
     bool m_gpuCheckPerformed;
     bool m_gpuNotificationShown = false;
     QString m_gpuName;
     QString m_driverVersion;
 
-    void checkGpuAvailability();
-    bool detectGpu();
+    // 一次遍历填充本周期的快照
+    SystemSnapshot takeSnapshot();
+    void handleGpuInfo(const GpuInfo &info);
+    void configureGpuTelemetry(const GpuInfo &info);
     void sampleGpuStats();
     void showGpuNotFoundDialog();
 };
@@ -0,0 +1,34 @@
+// samplerecord.h
+#pragma once
+
+#include <QtGlobal>
+
+// 采样线程与消费者之间传递的单个数据点
+// 定长且不含 Qt 隐式共享类型，可以直接按值放入 SpscRing
+enum SampleMetric : quint32 {
+    SampleMetricCpu,
+    SampleMetricMemory,
+    SampleMetricDisk,
+    SampleMetricNetwork,
+    SampleMetricGpu,
+    SampleMetricCount
+};
+
+struct SampleRecord {
+    qint64 timestampNs;   // 采样时刻，CLOCK_MONOTONIC 纳秒
+    quint32 metricId;     // SampleMetric
+    double value;
+};
+
+// 与 samples 表中 type 列一致的指标名称
+inline const char *sampleMetricName(quint32 metricId)
+{
+    switch (metricId) {
+    case SampleMetricCpu: return "CPU";
+    case SampleMetricMemory: return "Memory";
+    case SampleMetricDisk: return "Disk";
+    case SampleMetricNetwork: return "Network";
+    case SampleMetricGpu: return "GPU";
+    default: return "Unknown";
+    }
+}
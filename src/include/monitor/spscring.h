@@ -0,0 +1,66 @@
+// spscring.h
+#pragma once
+
+#include <QtGlobal>
+#include <atomic>
+#include <cstddef>
+
+// 无锁单生产者/单消费者环形缓冲区
+// 生产者只写 m_head，消费者只写 m_tail，两端各自缓存对方的索引，
+// 只有在缓存的索引显示"满"或"空"时才去读取对方的原子变量，减少缓存行来回迁移
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+    SpscRing() = default;
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    // 生产者线程调用，缓冲区已满时返回 false（由调用方决定丢弃还是计数）
+    bool push(const T &item) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_cachedTail == Capacity) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head - m_cachedTail == Capacity) return false;
+        }
+        m_items[head & (Capacity - 1)] = item;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 消费者线程调用，一次最多取出 maxCount 个元素，返回实际取出的个数
+    size_t popBatch(T *out, size_t maxCount) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        size_t available = m_cachedHead - tail;
+        if (available == 0) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            available = m_cachedHead - tail;
+            if (available == 0) return 0;
+        }
+        const size_t count = available < maxCount ? available : maxCount;
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = m_items[(tail + i) & (Capacity - 1)];
+        }
+        m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // 近似元素个数，仅用于统计
+    size_t sizeApprox() const {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    // 生产者独占的缓存行
+    alignas(64) std::atomic<size_t> m_head{0};
+    size_t m_cachedTail = 0;
+
+    // 消费者独占的缓存行
+    alignas(64) std::atomic<size_t> m_tail{0};
+    size_t m_cachedHead = 0;
+
+    alignas(64) T m_items[Capacity];
+};
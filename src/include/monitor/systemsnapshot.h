@@ -0,0 +1,48 @@
+// systemsnapshot.h
+#pragma once
+
+#include <QtGlobal>
+#include <QVector>
+#include "cpusensormonitor.h"
+#include "diskmonitor.h"
+#include "memorymonitor.h"
+#include "networkmonitor.h"
+#include "pressuremonitor.h"
+
+// 一个采样周期内一次性采集到的系统状态
+// 同一 tick 内的所有信号和消费者都从这份快照取值，保证数据一致且不重复读取 /proc
+struct SystemSnapshot {
+    qint64 timestampNs = 0;          // 采样时刻，CLOCK_MONOTONIC 纳秒
+
+    // CPU
+    double cpuUsage = 0.0;           // 总体使用率 (%)
+    double cpuIowait = 0.0;          // 等待 I/O 的时间占比 (%)
+    double cpuSteal = 0.0;           // 被宿主机占用的时间占比 (%)
+    QVector<double> coreUsage;       // 每核使用率 (%)，下标为核编号
+    QVector<double> coreIowait;
+    QVector<double> coreSteal;
+    CpuSensorStats cpuSensors;       // 每核频率和封装温度，没有 cpufreq / 温度传感器时对应的 valid 为 false
+
+    // 内存（字节）
+    quint64 memoryTotal = 0;
+    quint64 memoryUsed = 0;
+    quint64 memoryFree = 0;
+    double memoryUsage = 0.0;        // 使用率 (%)
+    VmstatRates vmstat;              // 缺页、换页、回收速率，读取失败时 valid 为 false
+
+    // 磁盘：读写速率 (字节/秒)
+    quint64 diskReadBytes = 0;
+    quint64 diskWriteBytes = 0;
+    double diskIO = 0.0;             // 读写合计 (MB/s)
+    QVector<DiskDeviceStats> diskDevices; // 逐块设备统计，不含分区
+
+    // 网络：上传/下载速率 (字节/秒)
+    quint64 networkUploadBytes = 0;
+    quint64 networkDownloadBytes = 0;
+    double networkUsage = 0.0;       // 上传+下载合计 (MB/s)
+    QVector<NetworkInterfaceStats> networkInterfaces; // 逐接口统计
+    QVector<ProcessNetworkStats> networkProcesses;    // 逐进程 TCP/UDP 统计，按流量从高到低
+
+    // 压力停顿信息（PSI），下标为 PressureResource；内核不支持时 valid 为 false
+    PressureStats pressure[PressureResourceCount];
+};
@@ -8,15 +8,37 @@
 #include <QWaitCondition>
 #include <QQueue>
 #include <QDateTime>
+#include <atomic>
+#include <memory>
 #include "cpumonitor.h"
+#include "cpusensormonitor.h"
 #include "memorymonitor.h"
 #include "diskmonitor.h"
 #include "networkmonitor.h"
 #include "processmonitor.h"
+#include "pressuremonitor.h"
+#include "gpuprobe.h"
+#include "gputelemetry.h"
+#include "systemsnapshot.h"
+#include "samplerecord.h"
+#include "spscring.h"
 #include "src/include/chart/chartwidget.h"
 #include "src/include/storage/datastorage.h"
 
+// 采集调度的抖动统计：每次唤醒时刻相对理论截止时间的延迟
+struct SchedulerJitterStats {
+    quint64 wakeups = 0;             // 唤醒次数
+    quint64 missedDeadlines = 0;     // 因严重超时而被跳过的截止时间个数
+    qint64 lastLatenessNs = 0;       // 最近一次唤醒的延迟
+    qint64 maxLatenessNs = 0;        // 最大延迟
+    double meanLatenessNs = 0.0;     // 平均延迟
+};
+
 // 专用采集线程类
+// 所有指标共用一个线程，按绝对截止时间唤醒（Linux 下为 timerfd，其他平台为带截止时间的条件变量），
+// 周期不受采样耗时影响，也不会累积漂移；同一时刻到期的指标在一次唤醒中一起采集。
+// 采集结果不经过跨线程信号：完整快照以原子方式发布，单个数据点写入无锁环形缓冲区，
+// 由界面和存储各自按自己的节奏批量取走
 class SamplerThread : public QThread {
     Q_OBJECT
 
@@ -25,34 +47,74 @@ public:
         CPU,
         Memory,
         Disk,
-        Network
+        Network,
+        SamplerTypeCount
     };
 
-    explicit SamplerThread(SamplerType type, QObject *parent = nullptr);
+    explicit SamplerThread(QObject *parent = nullptr);
     ~SamplerThread();
 
-    void setSamplingInterval(int msecs);
+    // 修改某个指标的采样间隔，在该指标下一次到期时生效
+    void setSamplingInterval(SamplerType type, int msecs);
+    void startSampling();
     void stopSampling();
 
-signals:
-    void newDataPoint(double value, const QDateTime &timestamp);
+    SchedulerJitterStats jitterStats() const;
+
+    // PSI 触发器：资源停顿超过阈值时提前唤醒采集线程，立即采集全部指标。
+    // 只能在线程启动前调用；不支持时返回 false
+    bool enablePressureTriggers(int stallMs = 200, int windowMs = 2000);
+
+    // 最近一次发布的快照（任意线程可调用）
+    std::shared_ptr<const SystemSnapshot> lastSnapshot() const { return std::atomic_load(&m_published); }
+
+    // 每个环形缓冲区只能有一个消费者线程
+    typedef SpscRing<SampleRecord, 4096> SampleRing;
+    SampleRing &guiRing() { return m_guiRing; }
+    SampleRing &storageRing() { return m_storageRing; }
+
+    // 因缓冲区已满而丢弃的数据点个数
+    quint64 droppedSamples() const { return m_droppedSamples.load(std::memory_order_relaxed); }
 
 protected:
     void run() override;
 
 private:
-    SamplerType m_type;
-    bool m_running;
-    int m_interval;
-    QMutex m_mutex;
-    
+    std::atomic<bool> m_running;
+    int m_intervals[SamplerTypeCount];
+    mutable QMutex m_mutex;
+
+    // 每个指标下一次的绝对截止时间（单调时钟纳秒）
+    qint64 m_deadlines[SamplerTypeCount];
+    SchedulerJitterStats m_jitter;
+
+#ifdef Q_OS_LINUX
+    int m_timerFd;
+    int m_wakeFd;
+#else
+    QWaitCondition m_wakeCondition;
+#endif
+
     // 各类监视器
     CpuMonitor m_cpu;
+    CpuSensorMonitor m_cpuSensors;
     MemoryMonitor m_memory;
     DiskMonitor m_disk;
     NetworkMonitor m_network;
+    PressureMonitor m_pressure;
+    bool m_pressureWake;             // 最近一次唤醒来自 PSI 触发器而不是定时器
+
+    // 只由采集线程写入，通过 atomic_load/atomic_store 发布
+    std::shared_ptr<const SystemSnapshot> m_published;
+    SampleRing m_guiRing;
+    SampleRing m_storageRing;
+    std::atomic<quint64> m_droppedSamples;
 
-    double sampleData();
+    // 阻塞到绝对截止时间，被 stopSampling() 打断时返回 false
+    bool waitUntil(qint64 deadlineNs);
+    void recordLateness(qint64 latenessNs, quint64 missed);
+    void sampleData(int dueMask, SystemSnapshot &snapshot);
+    void pushSample(qint64 timestampNs, quint32 metricId, double value);
 };
 
 // 多线程采样器主类
@@ -72,18 +134,26 @@ public:
     QString driverVersion() const { return m_driverVersion; }
     void setStorage(DataStorage *storage);
     void setChartWidgets(ChartWidget *cpu, ChartWidget *mem, ChartWidget *gpu, ChartWidget *net);
+
+    // 在 startSampling() 之前调用，见 SamplerThread::enablePressureTriggers()
+    bool enablePressureTriggers(int stallMs = 200, int windowMs = 2000);
+    
+    // 获取最新的性能数据（读取已发布的不可变快照，任意线程可调用）
+    std::shared_ptr<const SystemSnapshot> lastSnapshot() const { return m_collectorThread->lastSnapshot(); }
+    double lastCpuUsage() const { return lastSnapshot()->cpuUsage; }
+    double lastMemoryUsage() const { return lastSnapshot()->memoryUsage; }
+    double lastDiskIO() const { return lastSnapshot()->diskIO; }
+    double lastNetworkUsage() const { return lastSnapshot()->networkUsage; }
     
-    // 获取最新的性能数据
-    double lastCpuUsage() const { return m_lastCpuUsage; }
-    double lastMemoryUsage() const { return m_lastMemoryUsage; }
-    double lastDiskIO() const { return m_lastDiskIO; }
-    double lastNetworkUsage() const { return m_lastNetworkUsage; }
+    // 采集线程的调度抖动统计
+    SchedulerJitterStats jitterStats() const { return m_collectorThread->jitterStats(); }
+    quint64 droppedSamples() const { return m_collectorThread->droppedSamples(); }
 
 public slots:
-    void processCpuData(double value, const QDateTime &timestamp);
-    void processMemoryData(double value, const QDateTime &timestamp);
-    void processDiskData(double value, const QDateTime &timestamp);
-    void processNetworkData(double value, const QDateTime &timestamp);
+    // 批量取走采集线程写入环形缓冲区的数据点
+    void drainGuiSamples();
+    void drainStorageSamples();
+    // 请求后台重新探测 GPU，结果通过 gpuAvailabilityChanged 通知
     void checkGpuAvailability();
 
 signals:
@@ -99,14 +169,15 @@ signals:
 
 private:
     // 采样线程
-    SamplerThread *m_cpuThread;
-    SamplerThread *m_memoryThread;
-    SamplerThread *m_diskThread;
-    SamplerThread *m_networkThread;
+    SamplerThread *m_collectorThread;
     QTimer *m_gpuTimer;
+    QTimer *m_guiDrainTimer;
+    QTimer *m_storageDrainTimer;
     
     // 数据存储
     DataStorage *m_storage;
+    // drainStorageSamples() 复用的缓冲区，容量为环形缓冲区大小，只在第一次取数时分配
+    QVector<SampleRecord> m_storageBatch;
     
     // 图表控件
     ChartWidget *m_cpuChart;
@@ -114,21 +185,15 @@ private:
     ChartWidget *m_gpuChart;
     ChartWidget *m_netChart;
     
-    // GPU相关
+    // GPU相关：发现在 GpuProbe 的工作线程中完成，m_gpuTimer 只负责读取遥测
+    GpuProbe *m_gpuProbe;
+    std::unique_ptr<GpuTelemetrySource> m_gpuTelemetry;
     bool m_gpuAvailable;
     QString m_gpuName;
     QString m_driverVersion;
     
-    // 最新数据
-    double m_lastCpuUsage;
-    double m_lastMemoryUsage;
-    double m_lastDiskIO;
-    double m_lastNetworkUsage;
-    
-    // 互斥锁保护数据访问
-    QMutex m_dataMutex;
-    
     // 辅助函数
-    bool detectGpu();
+    void handleGpuInfo(const GpuInfo &info);
+    void configureGpuTelemetry(const GpuInfo &info);
     void sampleGpuStats();
 };
\ No newline at end of file
@@ -0,0 +1,48 @@
+// topkselector.h
+#pragma once
+
+#include <QtGlobal>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// 前 K 名选择器：扫描过程中用容量为 K 的最小堆保留键值最大的 K 个元素，
+// 复杂度 O(n log k)，只在构造时分配一次，不需要先收集再整体排序
+template <typename T>
+class TopKSelector {
+public:
+    typedef std::pair<double, T> Entry;
+
+    explicit TopKSelector(int k) : m_k(k > 0 ? static_cast<size_t>(k) : 0) { m_heap.reserve(m_k); }
+
+    // 该键值能否进入当前的前 K 名，调用方可以据此在构造元素之前提前淘汰
+    bool accepts(double key) const {
+        return m_heap.size() < m_k || (m_k > 0 && key > m_heap.front().first);
+    }
+
+    void offer(double key, const T &item) {
+        if (!accepts(key)) return;
+        if (m_heap.size() == m_k) {
+            // 挤掉堆顶（当前第 K 名）
+            std::pop_heap(m_heap.begin(), m_heap.end(), greater);
+            m_heap.back() = Entry(key, item);
+        } else {
+            m_heap.push_back(Entry(key, item));
+        }
+        std::push_heap(m_heap.begin(), m_heap.end(), greater);
+    }
+
+    // 按键值从大到小返回结果，调用后选择器为空
+    std::vector<Entry> takeSorted() {
+        std::sort_heap(m_heap.begin(), m_heap.end(), greater);
+        std::vector<Entry> result;
+        result.swap(m_heap);
+        return result;
+    }
+
+private:
+    static bool greater(const Entry &a, const Entry &b) { return a.first > b.first; }
+
+    size_t m_k;
+    std::vector<Entry> m_heap;
+};
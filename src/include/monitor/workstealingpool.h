@@ -0,0 +1,54 @@
+// workstealingpool.h
+#pragma once
+
+#include <QtGlobal>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 简单的工作窃取线程池，用于把一批互相独立的小任务（例如按 PID 分块读取 /proc）分给多个线程
+// 每个线程有自己的任务队列，从队尾取自己的任务；自己的队列空了就从其他线程的队首窃取，
+// 某些进程的文件读取较慢时，其余线程会自动分担剩下的任务
+class WorkStealingPool {
+public:
+    typedef std::function<void(int task, int worker)> TaskFunction;
+
+    // threadCount 包含调用 run() 的线程，实际只额外创建 threadCount - 1 个线程
+    explicit WorkStealingPool(int threadCount);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    int threadCount() const { return static_cast<int>(m_queues.size()); }
+
+    // 执行 [0, taskCount) 共 taskCount 个任务，fn(task, worker) 中 worker 为 [0, threadCount) 的线程编号，
+    // 同一 worker 编号不会被两个线程同时使用；调用线程作为 0 号线程参与执行，返回时所有任务都已完成
+    void run(int taskCount, const TaskFunction &fn);
+
+private:
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<int> tasks;
+    };
+
+    void workerLoop(int worker);
+    void drain(int worker, const TaskFunction &fn);
+    bool popLocal(int worker, int &task);
+    bool steal(int worker, int &task);
+
+    std::vector<std::unique_ptr<TaskQueue>> m_queues;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_finished;
+    const TaskFunction *m_function = nullptr;
+    quint64 m_round = 0;
+    int m_busyWorkers = 0;
+    bool m_stopping = false;
+};
@@ -7,6 +7,7 @@
 #include <QMap>
 #include <QString>
 #include <QMutex>
+#include "src/include/common/monotonicclock.h"
 
 // 自适应采样与数据压缩类 - 优化数据存储效率
 class AdaptiveSampler : public QObject {
@@ -69,13 +70,13 @@ public:
     double getDeltaThreshold() const;
     
     // 添加数据点（返回是否应该存储）
-    bool addDataPoint(const QString &metricName, double value, const QDateTime &timestamp = QDateTime::currentDateTime());
+    bool addDataPoint(const QString &metricName, double value, MonotonicNs timestamp = MonotonicClock::now());
     
     // 压缩历史数据
-    QVector<QPair<QDateTime, double>> compressData(const QVector<QPair<QDateTime, double>> &data);
+    QVector<QPair<MonotonicNs, double>> compressData(const QVector<QPair<MonotonicNs, double>> &data);
     
     // 解压数据
-    QVector<QPair<QDateTime, double>> decompressData(const QVector<QPair<QDateTime, double>> &compressedData);
+    QVector<QPair<MonotonicNs, double>> decompressData(const QVector<QPair<MonotonicNs, double>> &compressedData);
     
     // 获取当前采样间隔（考虑自适应策略）
     int getCurrentSamplingInterval(const QString &metricName) const;
@@ -95,28 +96,28 @@ signals:
 
 private:
     // 根据策略决定是否应该采样
-    bool shouldSample(const QString &metricName, double value, const QDateTime &timestamp);
+    bool shouldSample(const QString &metricName, double value, MonotonicNs timestamp);
     
     // 更新自适应采样间隔
     void updateAdaptiveInterval(const QString &metricName, double value);
     
     // 游程编码压缩
-    QVector<QPair<QDateTime, double>> runLengthEncode(const QVector<QPair<QDateTime, double>> &data);
+    QVector<QPair<MonotonicNs, double>> runLengthEncode(const QVector<QPair<MonotonicNs, double>> &data);
     
     // 游程编码解压
-    QVector<QPair<QDateTime, double>> runLengthDecode(const QVector<QPair<QDateTime, double>> &compressedData);
+    QVector<QPair<MonotonicNs, double>> runLengthDecode(const QVector<QPair<MonotonicNs, double>> &compressedData);
     
     // 增量编码压缩
-    QVector<QPair<QDateTime, double>> deltaEncode(const QVector<QPair<QDateTime, double>> &data);
+    QVector<QPair<MonotonicNs, double>> deltaEncode(const QVector<QPair<MonotonicNs, double>> &data);
     
     // 增量编码解压
-    QVector<QPair<QDateTime, double>> deltaDecode(const QVector<QPair<QDateTime, double>> &compressedData);
+    QVector<QPair<MonotonicNs, double>> deltaDecode(const QVector<QPair<MonotonicNs, double>> &compressedData);
     
     // 分段线性压缩
-    QVector<QPair<QDateTime, double>> piecewiseCompress(const QVector<QPair<QDateTime, double>> &data);
+    QVector<QPair<MonotonicNs, double>> piecewiseCompress(const QVector<QPair<MonotonicNs, double>> &data);
     
     // 分段线性解压
-    QVector<QPair<QDateTime, double>> piecewiseDecompress(const QVector<QPair<QDateTime, double>> &compressedData);
+    QVector<QPair<MonotonicNs, double>> piecewiseDecompress(const QVector<QPair<MonotonicNs, double>> &compressedData);
 
 private:
     SamplingStrategy m_samplingStrategy;         // 采样策略
@@ -127,7 +128,7 @@ private:
     double m_deltaThreshold;                     // 变化阈值
     
     // 每个指标的最后一个数据点
-    QMap<QString, QPair<QDateTime, double>> m_lastDataPoints;
+    QMap<QString, QPair<MonotonicNs, double>> m_lastDataPoints;
     
     // 每个指标的当前采样间隔
     QMap<QString, int> m_currentIntervals;
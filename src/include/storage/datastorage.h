@@ -8,6 +8,8 @@
 #include <QString>
 #include <QSqlDatabase>
 #include <QSettings>
+#include "src/include/monitor/samplerecord.h"
+#include "src/include/common/monotonicclock.h"
 
 class DataStorage : public QObject
 {
@@ -18,9 +20,12 @@ public:
     ~DataStorage();
     void storeSample(const QString &type, double value);
     void storeSample(const QString &type, double value, const QDateTime &timestamp);
+    void storeSample(const QString &type, double value, MonotonicNs timestamp);
+    // 在一个事务中批量写入采样线程产生的数据点
+    void storeSamples(const QVector<SampleRecord> &samples);
     // 存储系统数据的结构体
     struct SystemData {
-        QDateTime timestamp;
+        MonotonicNs timestamp;       // 单调时钟纳秒，导出时才换算为墙上时间
         double cpuUsage;
         double memoryUsage;
         double diskUsage;
@@ -54,6 +59,7 @@ protected:
     bool openDatabase(const QString &dbPath);
     void closeDatabase();
     bool createTables();
+    bool insertSample(QSqlQuery &query, const QString &type, double value, qint64 wallMs);
 
 private:
     QVector<SystemData> m_systemData;
@@ -46,6 +46,9 @@ public slots:
     // ????????
     void updateAnomalyData(double cpuUsage, double memoryUsage, double diskIO, double networkUsage);
     
+    // 更新分页与回收速率（主缺页、换页、直接回收扫描、OOM kill，均为每秒）
+    void updatePagingData(double majorFaults, double swapPages, double directReclaimPages, double oomKills);
+    
     // ????????
     void updatePerformanceData(double cpuUsage, double memoryUsage, double diskIO, double networkUsage);
     
@@ -7,7 +7,10 @@
 #include <QTimer>
 #include <QLabel>
 #include <QProgressBar>
+#include <QGroupBox>
+#include <QTableWidget>
 #include "src/include/chart/chartwidget.h"
+#include "src/include/monitor/cpusensormonitor.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class CpuPage; }
@@ -23,11 +26,19 @@ public:
 
 public slots:
     void updateCpuData();
+    // Linux 下由 Sampler 的每核统计驱动（下标为核编号）
+    void updateCoreData(const QVector<double> &usage, const QVector<double> &iowait, const QVector<double> &steal);
+    // Linux 下的每核频率和封装温度（sysfs cpufreq / hwmon / thermal）
+    void updateSensorData(const CpuSensorStats &stats);
 
 private:
     void setupUI();
     void setupCharts();
     void setupControls();
+    void applyUsage(double cpuUsage);
+    // 每核详情表：核数变化时才调整行数，之后只改单元格文字
+    void ensureCoreRows(int count);
+    void setCoreCell(int row, int column, const QString &text);
     QChart *m_chart;
     QChartView *m_chartView;
     QLineSeries *m_series;
@@ -43,7 +54,23 @@ private:
     QLabel *m_coresLabel;
     QLabel *m_modelLabel;
     QLabel *m_freqLabel;
+    QLabel *m_tempLabel;
     QLabel *m_archLabel;
+
+    // 每核使用率：图表只画所有核的最低/平均/最高三条曲线，逐核数值放在详情表中
+    QGroupBox *m_coreGroup;
+    ChartWidget *m_coreChart;
+    QLabel *m_busiestCoreLabel;
+    QLabel *m_iowaitLabel;
+    QLabel *m_stealLabel;
+
+    // 每核频率
+    QGroupBox *m_freqGroup;
+    ChartWidget *m_freqChart;
+
+    // 每核详情（使用率、I/O 等待、Steal、频率）
+    QGroupBox *m_coreTableGroup;
+    QTableWidget *m_coreTable;
 };
 
 
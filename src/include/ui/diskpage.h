@@ -10,6 +10,7 @@
 #include <QProgressBar>
 #include <QFrame>
 #include "src/include/chart/chartwidget.h"
+#include "src/include/monitor/diskmonitor.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class DiskPage; }
@@ -25,6 +26,7 @@ public:
 
 public slots:
     void updateDiskData();
+    void updateDeviceData(const QVector<DiskDeviceStats> &devices);
 
 private slots:
     void updateDiskTable();
@@ -42,6 +44,7 @@ private:
     QTimer *m_updateTimer;
     ChartWidget *m_chartWidget;
     QVector<double> m_diskUsage;
+    QVector<DiskDeviceStats> m_devices; // Linux: 最近一次采样的逐设备统计
     QLabel *m_detailLabel;
     QFrame *m_progressFrame;
     QProgressBar *m_diskProgressBar;
@@ -8,6 +8,7 @@
 #include <QFrame>
 #include <QProgressBar>
 #include "src/include/chart/chartwidget.h"
+#include "src/include/monitor/gputelemetry.h"
 #include <QDebug>
 
 class GpuPage : public QWidget
@@ -30,6 +31,9 @@ public slots:
         updateGpuStats(usage, temperature, memoryUsed, memoryTotal);
     }
 
+    // 更新功耗和各进程显存（只有 NVML 来源提供）
+    void updateGpuTelemetry(const GpuSample &sample);
+
 private:
     void setupUi();
     
@@ -37,6 +41,8 @@ private:
     QFrame *gpuStatusFrame;
     QLabel *gpuInfoLabel;
     QLabel *gpuDriverLabel;
+    QLabel *gpuPowerLabel;
+    QLabel *gpuProcessLabel;
     
     QFrame *gpuUsageFrame;
     QLabel *gpuUsageTextLabel;
@@ -6,7 +6,12 @@
 #include <QProgressBar>
 #include <QLabel>
 #include <QtCharts>
+#include <QTableWidget>
 #include "src/include/chart/chartwidget.h"
+#include "src/include/monitor/memorymonitor.h"
+#ifdef Q_OS_LINUX
+#include "src/include/monitor/processmonitor.h"
+#endif
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MemoryPage; }
@@ -19,14 +24,22 @@ class MemoryPage : public QWidget
 public:
     explicit MemoryPage(QWidget *parent = nullptr);
     ~MemoryPage();
+#ifdef Q_OS_LINUX
+    // 进程内存表读取的共享进程表，由采样器刷新；需要启用 setAccurateMemoryEnabled 才有 PSS
+    void setProcessMonitor(ProcessMonitor *monitor);
+#endif
 
 public slots:
     void updateMemoryData();
     void updateLabels(quint64 total, quint64 used, quint64 free);
+    void updateVmstat(const VmstatRates &rates);
 
 private:
     void setupUI();
     QString formatSize(quint64 bytes);
+#ifdef Q_OS_LINUX
+    void updateProcessMemory();
+#endif
 
     QLabel *m_totalMemLabel;
     QLabel *m_usedMemLabel;
@@ -42,6 +55,30 @@ private:
     QLabel *m_usagePercentLabel;
     QLabel *m_memTypeLabel;
     QLabel *m_pageFileLabel;
+
+#ifdef Q_OS_LINUX
+    // 按 PSS 排列的进程内存占用，RSS 会把共享库和共享内存重复计入每个进程
+    MemoryMonitor *m_memoryMonitor;
+    ProcessMonitor *m_processMonitor; // 与其他页面共用，不归本页面所有
+    QTimer *m_processTimer;
+    QTableWidget *m_processTable;
+    QLabel *m_processSummaryLabel;
+
+    // 缺页、换页和回收速率曲线，使用率高不一定缺内存，这些速率持续升高才说明内存不足
+    enum PagingSeries {
+        PagingMajorFaults,
+        PagingSwapIns,
+        PagingSwapOuts,
+        PagingScanned,
+        PagingSeriesCount
+    };
+    QChart *m_pagingChart;
+    QChartView *m_pagingChartView;
+    QValueAxis *m_pagingAxisY;
+    QLineSeries *m_pagingSeries[PagingSeriesCount];
+    QVector<qreal> m_pagingHistory[PagingSeriesCount];
+    QLabel *m_reclaimLabel;
+#endif
 };
 
 
@@ -5,10 +5,14 @@
 #include <QVBoxLayout>
 #include <QComboBox>
 #include <QLabel>
+#include <QTableWidget>
 #include <QtCharts>
 #include "src/include/chart/chartwidget.h"
+#include "src/include/monitor/networkmonitor.h"
+#ifdef Q_OS_WIN
 #include <windows.h>
 #include <iphlpapi.h>
+#endif
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class NetworkPage; }
@@ -24,6 +28,8 @@ public:
 
 public slots:
     void updateNetworkData();
+    void updateInterfaceData(const QVector<NetworkInterfaceStats> &interfaces);
+    void updateProcessData(const QVector<ProcessNetworkStats> &processes);
 
 private slots:
     void refreshInterfaces();
@@ -32,8 +38,13 @@ private slots:
 private:
     void setupUI();
     QString formatSpeed(qint64 bytes);
+#ifdef Q_OS_WIN
     void updateDetailInfo(const MIB_IFROW& ifRow, qint64 uploadSpeed, qint64 downloadSpeed);
     QString formatMacAddress(const BYTE* addr, DWORD len);
+#else
+    void updateDetailInfo(const NetworkInterfaceStats &stats);
+    const NetworkInterfaceStats *selectedInterface() const;
+#endif
     QString formatDataSize(qint64 bytes);
 
     QComboBox *m_interfaceCombo;
@@ -45,6 +56,10 @@ private:
     qint64 m_lastUploadBytes;
     qint64 m_lastDownloadBytes;
     QLabel *m_detailLabel;
+#ifndef Q_OS_WIN
+    QVector<NetworkInterfaceStats> m_interfaces; // 最近一次采样的逐接口统计
+    QTableWidget *m_processTable;                // 流量最大的进程
+#endif
 };
 
 #endif // NETWORKPAGE_H
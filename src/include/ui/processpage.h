@@ -8,6 +8,11 @@
 #include <QLineEdit>
 #include <QPushButton>
 #include <QLabel>
+#ifdef Q_OS_LINUX
+#include "src/include/monitor/processmonitor.h"
+#include "src/include/monitor/cpumonitor.h"
+#include "src/include/monitor/memorymonitor.h"
+#endif
 
 class ProcessPage : public QWidget
 {
@@ -28,6 +33,11 @@ public:
     // 获取当前进程数据列表
     QList<ProcessData> getCurrentProcessData() const;
 
+#ifdef Q_OS_LINUX
+    // 进程列表读取的共享进程表，由采样器刷新，本页面只读取不刷新
+    void setProcessMonitor(ProcessMonitor *monitor);
+#endif
+
 signals:
     // 添加终止进程请求信号
     void processTerminationRequested(quint64 pid);
@@ -49,10 +59,19 @@ private:
     QLabel *m_totalProcessesLabel;
     QLabel *m_cpuUsageLabel;
     QLabel *m_memoryUsageLabel;
+#ifdef Q_OS_LINUX
+    // 进程表由 netlink 进程事件维护（没有权限时退回每次全量扫描），与其他页面共用，不归本页面所有
+    ProcessMonitor *m_processMonitor;
+    CpuMonitor *m_cpuMonitor;
+    MemoryMonitor *m_memoryMonitor;
+#endif
     
     void setupUI();
     QString formatMemorySize(quint64 bytes);
     void updateSystemStats();
+#ifdef Q_OS_LINUX
+    int appendProcessRow(const QMap<quint64, bool> &checkedPids, const ProcessInfo &info, const QString &status);
+#endif
 };
 
 #endif // PROCESSPAGE_H
\ No newline at end of file
@@ -0,0 +1,19 @@
+QT += core testlib
+QT -= gui
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_counterrate
+TEMPLATE = app
+
+# 源文件按仓库根目录引用头文件
+ROOT = $$PWD/../..
+INCLUDEPATH += $$ROOT
+
+SOURCES += \
+    tst_counterrate.cpp \
+    $$ROOT/src/code/monitor/counterrate.cpp
+
+HEADERS += \
+    $$ROOT/src/include/monitor/counterrate.h
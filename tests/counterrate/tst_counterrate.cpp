@@ -0,0 +1,152 @@
+// tst_counterrate.cpp
+// CounterRate / CounterRateTable 的测试：首次读数、按实际经过时间换算、32 位回绕、计数器重置、时间不前进、来源清除。
+// 磁盘、网络、进程 I/O 和套接字的速率都由它计算
+#include <QtTest>
+#include "src/include/monitor/counterrate.h"
+
+class CounterRateTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void firstSampleIsZero();
+    void rateUsesElapsedTime();
+    void wrap32_data();
+    void wrap32();
+    void decreaseIsReset_data();
+    void decreaseIsReset();
+    void valueIsMaskedToCounterWidth();
+    void staleTimestampRebaselines();
+    void resetDropsBaseline();
+    void tableSweepsMissingKeys();
+};
+
+static MonotonicNs secs(double s)
+{
+    return static_cast<MonotonicNs>(s * MonotonicClock::NsPerSec);
+}
+
+void CounterRateTest::firstSampleIsZero()
+{
+    CounterRate rate;
+    QVERIFY(!rate.hasBaseline());
+    QCOMPARE(rate.update(123456789, secs(10)), 0.0);
+    QVERIFY(rate.hasBaseline());
+    QCOMPARE(rate.lastDelta(), quint64(0));
+}
+
+void CounterRateTest::rateUsesElapsedTime()
+{
+    // 间隔有抖动：速率按两次读数之间的实际时间计算
+    CounterRate rate;
+    rate.update(1000, secs(1));
+    QCOMPARE(rate.update(3000, secs(3)), 1000.0);
+    QCOMPARE(rate.lastDelta(), quint64(2000));
+    QCOMPARE(rate.update(3500, secs(3.5)), 1000.0);
+    QCOMPARE(rate.update(3500, secs(4.5)), 0.0);
+    QCOMPARE(rate.lastDelta(), quint64(0));
+}
+
+void CounterRateTest::wrap32_data()
+{
+    QTest::addColumn<quint64>("before");
+    QTest::addColumn<quint64>("after");
+    QTest::addColumn<quint64>("delta");
+
+    QTest::newRow("just past zero") << quint64(0xFFFFFF00) << quint64(0x100) << quint64(0x200);
+    QTest::newRow("to zero") << quint64(0xFFFFFFFF) << quint64(0) << quint64(1);
+    QTest::newRow("from upper half") << quint64(0x80000000) << quint64(0x10) << quint64(0x80000010);
+}
+
+void CounterRateTest::wrap32()
+{
+    QFETCH(quint64, before);
+    QFETCH(quint64, after);
+    QFETCH(quint64, delta);
+
+    CounterRate rate(32);
+    rate.update(before, secs(1));
+    QCOMPARE(rate.update(after, secs(2)), double(delta));
+    QCOMPARE(rate.lastDelta(), delta);
+}
+
+void CounterRateTest::decreaseIsReset_data()
+{
+    QTest::addColumn<int>("bits");
+    QTest::addColumn<quint64>("before");
+    QTest::addColumn<quint64>("after");
+
+    // 64 位计数器实际不会回绕，变小只能是重置；32 位计数器在下半区间变小也按重置处理
+    QTest::newRow("64-bit") << 64 << quint64(0xFFFFFFFFFFFFFF00ULL) << quint64(0x100);
+    QTest::newRow("64-bit small") << 64 << quint64(5000) << quint64(10);
+    QTest::newRow("32-bit lower half") << 32 << quint64(0x7FFFFFFF) << quint64(10);
+}
+
+void CounterRateTest::decreaseIsReset()
+{
+    QFETCH(int, bits);
+    QFETCH(quint64, before);
+    QFETCH(quint64, after);
+
+    CounterRate rate(bits);
+    rate.update(before, secs(1));
+    QCOMPARE(rate.update(after, secs(2)), 0.0);
+    QCOMPARE(rate.lastDelta(), quint64(0));
+    // 重置后以新读数为基线继续计算
+    QCOMPARE(rate.update(after + 500, secs(3)), 500.0);
+}
+
+void CounterRateTest::valueIsMaskedToCounterWidth()
+{
+    // 驱动用 64 位字段导出 32 位计数器时，高位不参与计算
+    CounterRate rate(32);
+    rate.update(0x100000010ULL, secs(1));
+    QCOMPARE(rate.update(0x100000020ULL, secs(2)), 16.0);
+}
+
+void CounterRateTest::staleTimestampRebaselines()
+{
+    CounterRate rate;
+    rate.update(100, secs(5));
+    QCOMPARE(rate.update(200, secs(5)), 0.0);
+    QCOMPARE(rate.update(300, secs(4)), 0.0);
+    // 基线换成了最近一次读数
+    QCOMPARE(rate.update(400, secs(5)), 100.0);
+}
+
+void CounterRateTest::resetDropsBaseline()
+{
+    CounterRate rate;
+    rate.update(100, secs(1));
+    rate.update(200, secs(2));
+    rate.reset();
+    QVERIFY(!rate.hasBaseline());
+    QCOMPARE(rate.lastDelta(), quint64(0));
+    QCOMPARE(rate.update(10000, secs(3)), 0.0);
+    QCOMPARE(rate.update(10100, secs(4)), 100.0);
+}
+
+void CounterRateTest::tableSweepsMissingKeys()
+{
+    CounterRateTable table;
+    QCOMPARE(table.update(QByteArray("sda"), 100, secs(1)), 0.0);
+    QCOMPARE(table.update(QByteArray("sdb"), 100, secs(1)), 0.0);
+    table.sweep();
+    QCOMPARE(table.size(), 2);
+
+    // sdb 本轮没有出现，被清除；按指针加长度查找与按 QByteArray 查找是同一项
+    QCOMPARE(table.update("sda", 3, 300, secs(2)), 200.0);
+    table.sweep();
+    QCOMPARE(table.size(), 1);
+
+    // 重新出现的设备从新基线开始，不会拿旧读数算出假峰值
+    QCOMPARE(table.update(QByteArray("sdb"), 100000, secs(3)), 0.0);
+    QCOMPARE(table.update(QByteArray("sda"), 400, secs(3)), 100.0);
+    table.sweep();
+    QCOMPARE(table.size(), 2);
+
+    table.clear();
+    QCOMPARE(table.size(), 0);
+}
+
+QTEST_GUILESS_MAIN(CounterRateTest)
+#include "tst_counterrate.moc"
@@ -0,0 +1,43 @@
+#!/bin/sh
+# 代替 nvidia-smi 的脚本，供 NvidiaSmiTelemetry 的测试使用
+# 按 --query-gpu=index,... --format=csv,noheader,nounits -lms <间隔> 的格式持续输出两块 GPU 的读数，
+# 带 -i 时与真实的 nvidia-smi 一样只输出选中的设备（按序号或 PCI 地址）
+#
+# FAKE_SMI_ARGS    收到的参数写入该文件
+# FAKE_SMI_MODE    stream（默认）持续输出；fail 不输出直接退出；
+#                  flaky 第一次启动时创建 FAKE_SMI_MARKER 后直接退出，之后正常输出
+
+[ -n "$FAKE_SMI_ARGS" ] && echo "$*" > "$FAKE_SMI_ARGS"
+
+device=""
+interval=1000
+while [ $# -gt 0 ]; do
+    case "$1" in
+        -i) device="$2"; shift ;;
+        -lms) interval="$2"; shift ;;
+    esac
+    shift
+done
+
+case "${FAKE_SMI_MODE:-stream}" in
+    fail)
+        exit 1
+        ;;
+    flaky)
+        if [ ! -e "$FAKE_SMI_MARKER" ]; then
+            : > "$FAKE_SMI_MARKER"
+            exit 1
+        fi
+        ;;
+esac
+
+delay=$(awk "BEGIN { print $interval / 1000 }")
+while :; do
+    case "$device" in
+        ""|0|0000:01:00.0) echo "0, 35, 61, 1234, 8192" ;;
+    esac
+    case "$device" in
+        ""|1|0000:02:00.0) echo "1, 99, 70, [N/A], 16384" ;;
+    esac
+    sleep "$delay"
+done
@@ -0,0 +1,25 @@
+QT += core testlib
+QT -= gui
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_nvidiasmitelemetry
+TEMPLATE = app
+
+# 源文件按仓库根目录引用头文件
+ROOT = $$PWD/../..
+INCLUDEPATH += $$ROOT
+
+# 代替 nvidia-smi 的脚本，通过 MONITOR_NVIDIA_SMI 传给被测对象
+DEFINES += FAKE_NVIDIA_SMI=\\\"$$PWD/fake-nvidia-smi.sh\\\"
+
+SOURCES += \
+    tst_nvidiasmitelemetry.cpp \
+    $$ROOT/src/code/monitor/gputelemetry.cpp \
+    $$ROOT/src/code/monitor/procfsreader.cpp
+
+HEADERS += \
+    $$ROOT/src/include/monitor/gputelemetry.h
+
+unix: LIBS += -ldl
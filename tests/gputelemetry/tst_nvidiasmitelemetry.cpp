@@ -0,0 +1,185 @@
+// tst_nvidiasmitelemetry.cpp
+// NvidiaSmiTelemetry 的测试：逐行解析、按 PCI 地址选择设备、子进程退出后的指数退避。
+// 用 fake-nvidia-smi.sh 代替真实的 nvidia-smi（通过 MONITOR_NVIDIA_SMI 指定），不需要 NVIDIA 显卡
+#include <QtTest>
+#include <QFile>
+#include <QTemporaryDir>
+#include <cstring>
+#include "src/include/monitor/gputelemetry.h"
+
+class NvidiaSmiTelemetryTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+
+    void parseLine_data();
+    void parseLine();
+    void programOverride();
+
+    void defaultDeviceReadsIndexZero();
+    void pciAddressSelectsDevice();
+    void createPassesPciAddress();
+    void restartBacksOff();
+    void validDataResetsBackoff();
+
+private:
+    QString argumentsPassed() const;
+
+    QTemporaryDir m_dir;
+};
+
+void NvidiaSmiTelemetryTest::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    QVERIFY(QFile::exists(FAKE_NVIDIA_SMI));
+    qputenv("MONITOR_NVIDIA_SMI", FAKE_NVIDIA_SMI);
+    qputenv("FAKE_SMI_ARGS", m_dir.filePath("args").toUtf8());
+    qputenv("FAKE_SMI_MARKER", m_dir.filePath("marker").toUtf8());
+}
+
+void NvidiaSmiTelemetryTest::init()
+{
+    qputenv("FAKE_SMI_MODE", "stream");
+    QFile::remove(m_dir.filePath("args"));
+    QFile::remove(m_dir.filePath("marker"));
+}
+
+QString NvidiaSmiTelemetryTest::argumentsPassed() const
+{
+    QFile file(m_dir.filePath("args"));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) return QString();
+    return QString::fromUtf8(file.readAll()).trimmed();
+}
+
+void NvidiaSmiTelemetryTest::parseLine_data()
+{
+    QTest::addColumn<QByteArray>("line");
+    QTest::addColumn<bool>("ok");
+    QTest::addColumn<int>("index");
+    QTest::addColumn<double>("usage");
+    QTest::addColumn<double>("temperature");
+    QTest::addColumn<quint64>("memoryUsedMiB");
+    QTest::addColumn<quint64>("memoryTotalMiB");
+
+    QTest::newRow("normal") << QByteArray("0, 35, 61, 1234, 8192") << true << 0 << 35.0 << 61.0 << quint64(1234) << quint64(8192);
+    QTest::newRow("crlf") << QByteArray("2, 7, 40, 10, 20\r") << true << 2 << 7.0 << 40.0 << quint64(10) << quint64(20);
+    QTest::newRow("not available") << QByteArray("1, [N/A], 55, [Not Supported], 16384")
+                                   << true << 1 << 0.0 << 55.0 << quint64(0) << quint64(16384);
+    QTest::newRow("missing fields") << QByteArray("0, 35") << false << 0 << 0.0 << 0.0 << quint64(0) << quint64(0);
+    QTest::newRow("error message") << QByteArray("No devices were found") << false << 0 << 0.0 << 0.0 << quint64(0) << quint64(0);
+    QTest::newRow("empty") << QByteArray() << false << 0 << 0.0 << 0.0 << quint64(0) << quint64(0);
+}
+
+void NvidiaSmiTelemetryTest::parseLine()
+{
+    QFETCH(QByteArray, line);
+    QFETCH(bool, ok);
+
+    int parsedIndex = -1;
+    GpuSample sample;
+    QCOMPARE(NvidiaSmiTelemetry::parseLine(line.constData(), line.constData() + line.size(), parsedIndex, sample), ok);
+    if (!ok) return;
+
+    QFETCH(int, index);
+    QFETCH(double, usage);
+    QFETCH(double, temperature);
+    QFETCH(quint64, memoryUsedMiB);
+    QFETCH(quint64, memoryTotalMiB);
+    QCOMPARE(parsedIndex, index);
+    QVERIFY(sample.valid);
+    QCOMPARE(sample.usage, usage);
+    QCOMPARE(sample.temperature, temperature);
+    QCOMPARE(sample.memoryUsed, memoryUsedMiB * 1024 * 1024);
+    QCOMPARE(sample.memoryTotal, memoryTotalMiB * 1024 * 1024);
+}
+
+void NvidiaSmiTelemetryTest::programOverride()
+{
+    QCOMPARE(NvidiaSmiTelemetry::program(), QString(FAKE_NVIDIA_SMI));
+}
+
+void NvidiaSmiTelemetryTest::defaultDeviceReadsIndexZero()
+{
+    // 不指定设备时脚本输出两块 GPU，只取序号 0
+    NvidiaSmiTelemetry telemetry;
+    telemetry.start(100);
+
+    GpuSample sample;
+    QTRY_VERIFY_WITH_TIMEOUT(telemetry.read(sample), 5000);
+    QCOMPARE(sample.usage, 35.0);
+    QCOMPARE(sample.temperature, 61.0);
+    QCOMPARE(sample.memoryTotal, quint64(8192) * 1024 * 1024);
+
+    const QString arguments = argumentsPassed();
+    QVERIFY2(!arguments.contains("-i "), qPrintable(arguments));
+    QVERIFY2(arguments.contains("-lms 100"), qPrintable(arguments));
+    telemetry.stop();
+    QVERIFY(!telemetry.read(sample));
+}
+
+void NvidiaSmiTelemetryTest::pciAddressSelectsDevice()
+{
+    // 指定 PCI 地址时 nvidia-smi 只输出这一块卡，它的序号是 1 也要接受
+    NvidiaSmiTelemetry telemetry("0000:02:00.0");
+    telemetry.start(100);
+
+    GpuSample sample;
+    QTRY_VERIFY_WITH_TIMEOUT(telemetry.read(sample), 5000);
+    QCOMPARE(sample.usage, 99.0);
+    QCOMPARE(sample.temperature, 70.0);
+    QCOMPARE(sample.memoryUsed, quint64(0));
+    QCOMPARE(sample.memoryTotal, quint64(16384) * 1024 * 1024);
+    QVERIFY2(argumentsPassed().startsWith("-i 0000:02:00.0 "), qPrintable(argumentsPassed()));
+}
+
+void NvidiaSmiTelemetryTest::createPassesPciAddress()
+{
+    // NVML 不可用时改用 nvidia-smi，设备仍按探测到的 PCI 地址选择
+    qputenv("MONITOR_NVML_LIBRARY", m_dir.filePath("missing-libnvidia-ml.so").toUtf8());
+    GpuInfo info;
+    info.available = true;
+    info.vendor = GpuVendorNvidia;
+    info.pciAddress = "0000:02:00.0";
+    std::unique_ptr<GpuTelemetrySource> source = GpuTelemetrySource::create(info);
+    qunsetenv("MONITOR_NVML_LIBRARY");
+
+    QVERIFY(source);
+    QCOMPARE(source->name(), "nvidia-smi");
+    NvidiaSmiTelemetry *smi = dynamic_cast<NvidiaSmiTelemetry *>(source.get());
+    QVERIFY(smi);
+    QCOMPARE(smi->device(), QString("0000:02:00.0"));
+}
+
+void NvidiaSmiTelemetryTest::restartBacksOff()
+{
+    // 每次退出后等待时间翻倍：1 秒后第一次重启，再失败则下一次等 4 秒
+    qputenv("FAKE_SMI_MODE", "fail");
+    NvidiaSmiTelemetry telemetry;
+    QCOMPARE(telemetry.nextRestartDelayMs(), 1000);
+    telemetry.start(100);
+
+    QTRY_COMPARE_WITH_TIMEOUT(telemetry.nextRestartDelayMs(), 2000, 3000);
+    QTRY_COMPARE_WITH_TIMEOUT(telemetry.nextRestartDelayMs(), 4000, 4000);
+    QVERIFY(telemetry.isRunning());
+    GpuSample sample;
+    QVERIFY(!telemetry.read(sample));
+}
+
+void NvidiaSmiTelemetryTest::validDataResetsBackoff()
+{
+    // 第一次启动失败，1 秒后重启成功，收到数据后退避复位
+    qputenv("FAKE_SMI_MODE", "flaky");
+    NvidiaSmiTelemetry telemetry;
+    telemetry.start(100);
+
+    QTRY_COMPARE_WITH_TIMEOUT(telemetry.nextRestartDelayMs(), 2000, 3000);
+    GpuSample sample;
+    QTRY_VERIFY_WITH_TIMEOUT(telemetry.read(sample), 5000);
+    QCOMPARE(telemetry.nextRestartDelayMs(), 1000);
+    QCOMPARE(sample.usage, 35.0);
+}
+
+QTEST_GUILESS_MAIN(NvidiaSmiTelemetryTest)
+#include "tst_nvidiasmitelemetry.moc"
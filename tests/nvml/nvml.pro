@@ -0,0 +1,6 @@
+# 先编译桩库，再编译加载它的测试
+TEMPLATE = subdirs
+SUBDIRS += \
+    stub \
+    test
+test.depends = stub
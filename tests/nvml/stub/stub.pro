@@ -0,0 +1,11 @@
+# 代替 libnvidia-ml 的桩库，只在测试时通过 MONITOR_NVML_LIBRARY 加载
+TEMPLATE = lib
+CONFIG += plugin
+CONFIG -= qt
+
+TARGET = stubnvml
+DESTDIR = $$OUT_PWD
+
+SOURCES += stubnvml.c
+
+unix: QMAKE_CFLAGS += -fvisibility=hidden
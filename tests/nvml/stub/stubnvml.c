@@ -0,0 +1,154 @@
+/* stubnvml.c
+ * 代替 libnvidia-ml 的桩库，供 NvmlTelemetry 的测试通过 MONITOR_NVML_LIBRARY 加载。
+ * 只导出 NvmlTelemetry 用到的符号，按 nvml.h 的 ABI 声明；行为由环境变量控制：
+ *   STUB_NVML_INIT_FAIL       nvmlInit_v2 返回 NVML_ERROR_UNKNOWN
+ *   STUB_NVML_PROCESS_COUNT   计算进程数（默认 40，超过 NvmlTelemetry 的初始容量 32，触发 INSUFFICIENT_SIZE）
+ * 设备：0 号按序号取得，PCI 地址 0000:01:00.0 对应另一块卡，两者利用率不同，便于区分按哪种方式取到。
+ * 图形进程列表固定为两项：pid 1000（与计算进程重复）和 pid 5（显存为 NVML_VALUE_NOT_AVAILABLE）。
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#define STUB_EXPORT __declspec(dllexport)
+#else
+#define STUB_EXPORT __attribute__((visibility("default")))
+#endif
+
+#define NVML_SUCCESS 0
+#define NVML_ERROR_INVALID_ARGUMENT 2
+#define NVML_ERROR_INSUFFICIENT_SIZE 7
+#define NVML_ERROR_UNKNOWN 999
+#define NVML_VALUE_NOT_AVAILABLE (~0ULL)
+
+/* 与 nvml.h 的 nvmlProcessInfo_t 相同，_v3 查询按这个 24 字节的步长填写数组 */
+typedef struct {
+    unsigned int pid;
+    unsigned long long usedGpuMemory;
+    unsigned int gpuInstanceId;
+    unsigned int computeInstanceId;
+} StubProcessInfo;
+
+typedef struct {
+    unsigned int gpu;
+    unsigned int memory;
+} StubUtilization;
+
+typedef struct {
+    unsigned long long total;
+    unsigned long long free;
+    unsigned long long used;
+} StubMemory;
+
+/* 设备句柄只用来区分两块卡，不会被解引用 */
+static char indexDevice;
+static char pciDevice;
+
+static int initCount;
+static int insufficientSizeCount;
+
+STUB_EXPORT int nvmlInit_v2(void)
+{
+    if (getenv("STUB_NVML_INIT_FAIL")) return NVML_ERROR_UNKNOWN;
+    ++initCount;
+    return NVML_SUCCESS;
+}
+
+STUB_EXPORT int nvmlShutdown(void)
+{
+    --initCount;
+    return NVML_SUCCESS;
+}
+
+STUB_EXPORT int nvmlDeviceGetHandleByIndex_v2(unsigned int index, void **device)
+{
+    if (index != 0) return NVML_ERROR_INVALID_ARGUMENT;
+    *device = &indexDevice;
+    return NVML_SUCCESS;
+}
+
+STUB_EXPORT int nvmlDeviceGetHandleByPciBusId_v2(const char *busId, void **device)
+{
+    if (strcmp(busId, "0000:01:00.0") != 0) return NVML_ERROR_INVALID_ARGUMENT;
+    *device = &pciDevice;
+    return NVML_SUCCESS;
+}
+
+STUB_EXPORT int nvmlDeviceGetUtilizationRates(void *device, StubUtilization *utilization)
+{
+    utilization->gpu = device == &pciDevice ? 77 : 11;
+    utilization->memory = 3;
+    return NVML_SUCCESS;
+}
+
+STUB_EXPORT int nvmlDeviceGetMemoryInfo(void *device, StubMemory *memory)
+{
+    (void)device;
+    memory->total = 8ULL << 30;
+    memory->used = 1ULL << 30;
+    memory->free = memory->total - memory->used;
+    return NVML_SUCCESS;
+}
+
+STUB_EXPORT int nvmlDeviceGetTemperature(void *device, unsigned int sensor, unsigned int *temperature)
+{
+    (void)device;
+    (void)sensor;
+    *temperature = 64;
+    return NVML_SUCCESS;
+}
+
+STUB_EXPORT int nvmlDeviceGetPowerUsage(void *device, unsigned int *milliwatts)
+{
+    (void)device;
+    *milliwatts = 123456;
+    return NVML_SUCCESS;
+}
+
+STUB_EXPORT int nvmlDeviceGetComputeRunningProcesses_v3(void *device, unsigned int *count, StubProcessInfo *infos)
+{
+    const char *configured = getenv("STUB_NVML_PROCESS_COUNT");
+    const unsigned int processCount = configured ? (unsigned int)atoi(configured) : 40;
+    unsigned int i;
+    (void)device;
+    if (*count < processCount) {
+        *count = processCount;
+        ++insufficientSizeCount;
+        return NVML_ERROR_INSUFFICIENT_SIZE;
+    }
+    for (i = 0; i < processCount; ++i) {
+        memset(&infos[i], 0, sizeof(infos[i]));
+        infos[i].pid = 1000 + i;
+        infos[i].usedGpuMemory = (unsigned long long)(i + 1) << 20;
+    }
+    *count = processCount;
+    return NVML_SUCCESS;
+}
+
+STUB_EXPORT int nvmlDeviceGetGraphicsRunningProcesses_v3(void *device, unsigned int *count, StubProcessInfo *infos)
+{
+    (void)device;
+    if (*count < 2) {
+        *count = 2;
+        ++insufficientSizeCount;
+        return NVML_ERROR_INSUFFICIENT_SIZE;
+    }
+    memset(infos, 0, 2 * sizeof(infos[0]));
+    infos[0].pid = 1000;
+    infos[0].usedGpuMemory = 500ULL << 20;
+    infos[1].pid = 5;
+    infos[1].usedGpuMemory = NVML_VALUE_NOT_AVAILABLE;
+    *count = 2;
+    return NVML_SUCCESS;
+}
+
+/* 以下两个不是 NVML 的符号，测试用来检查 nvmlInit / nvmlShutdown 是否配对以及缓冲区扩容次数 */
+STUB_EXPORT int stubNvmlInitCount(void)
+{
+    return initCount;
+}
+
+STUB_EXPORT int stubNvmlInsufficientSizeCount(void)
+{
+    return insufficientSizeCount;
+}
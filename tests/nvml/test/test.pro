@@ -0,0 +1,26 @@
+QT += core testlib
+QT -= gui
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_nvmltelemetry
+TEMPLATE = app
+
+# 源文件按仓库根目录引用头文件
+ROOT = $$PWD/../../..
+INCLUDEPATH += $$ROOT
+
+# 桩库由 ../stub 编译到它自己的输出目录
+unix: DEFINES += STUB_NVML_LIBRARY=\\\"$$OUT_PWD/../stub/libstubnvml.so\\\"
+win32: DEFINES += STUB_NVML_LIBRARY=\\\"$$OUT_PWD/../stub/stubnvml.dll\\\"
+
+SOURCES += \
+    tst_nvmltelemetry.cpp \
+    $$ROOT/src/code/monitor/gputelemetry.cpp \
+    $$ROOT/src/code/monitor/procfsreader.cpp
+
+HEADERS += \
+    $$ROOT/src/include/monitor/gputelemetry.h
+
+unix: LIBS += -ldl
@@ -0,0 +1,198 @@
+// tst_nvmltelemetry.cpp
+// NvmlTelemetry 的测试：通过 MONITOR_NVML_LIBRARY 加载 stub/stubnvml.c 编译出的桩库，不需要 NVIDIA 驱动。
+// 覆盖库不存在和 nvmlInit 失败时改用 nvidia-smi、按 PCI 地址和按序号取设备、
+// 进程缓冲区不足（INSUFFICIENT_SIZE）时扩容重试、显存为 NOT_AVAILABLE 的进程
+#include <QtTest>
+#include <QLibrary>
+#include <QTemporaryDir>
+#include "src/include/monitor/gputelemetry.h"
+
+class NvmlTelemetryTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanupTestCase();
+
+    void missingLibraryFallsBack();
+    void initFailureFallsBack();
+    void lookupByPciAddress();
+    void lookupByIndex();
+    void processBufferGrows();
+    void unavailableProcessMemoryIsZero();
+    void shutdownIsBalanced();
+
+private:
+    static GpuInfo nvidiaInfo(const QString &pciAddress);
+
+    QTemporaryDir m_dir;
+    QLibrary m_stub;
+    int (*m_initCount)() = nullptr;
+    int (*m_insufficientSizeCount)() = nullptr;
+};
+
+GpuInfo NvmlTelemetryTest::nvidiaInfo(const QString &pciAddress)
+{
+    GpuInfo info;
+    info.available = true;
+    info.vendor = GpuVendorNvidia;
+    info.name = "Stub GPU";
+    info.pciAddress = pciAddress;
+    return info;
+}
+
+void NvmlTelemetryTest::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    // 与 NvmlTelemetry 加载同一个文件，拿到的是同一份库，可以读取桩库内部的计数
+    m_stub.setFileName(STUB_NVML_LIBRARY);
+    QVERIFY2(m_stub.load(), qPrintable(m_stub.errorString()));
+    m_initCount = reinterpret_cast<int (*)()>(m_stub.resolve("stubNvmlInitCount"));
+    m_insufficientSizeCount = reinterpret_cast<int (*)()>(m_stub.resolve("stubNvmlInsufficientSizeCount"));
+    QVERIFY(m_initCount);
+    QVERIFY(m_insufficientSizeCount);
+}
+
+void NvmlTelemetryTest::init()
+{
+    qputenv("MONITOR_NVML_LIBRARY", STUB_NVML_LIBRARY);
+    qunsetenv("STUB_NVML_INIT_FAIL");
+    qunsetenv("STUB_NVML_PROCESS_COUNT");
+}
+
+void NvmlTelemetryTest::cleanupTestCase()
+{
+    m_stub.unload();
+}
+
+void NvmlTelemetryTest::missingLibraryFallsBack()
+{
+    qputenv("MONITOR_NVML_LIBRARY", m_dir.filePath("libnvidia-ml-missing.so").toUtf8());
+
+    NvmlTelemetry nvml;
+    QVERIFY(!nvml.open("0000:01:00.0"));
+    QVERIFY(!nvml.isOpen());
+    GpuSample sample;
+    QVERIFY(!nvml.read(sample));
+
+    std::unique_ptr<GpuTelemetrySource> source = GpuTelemetrySource::create(nvidiaInfo("0000:01:00.0"));
+    QVERIFY(source);
+    QCOMPARE(source->name(), "nvidia-smi");
+}
+
+void NvmlTelemetryTest::initFailureFallsBack()
+{
+    qputenv("STUB_NVML_INIT_FAIL", "1");
+    const int initCount = m_initCount();
+
+    NvmlTelemetry nvml;
+    QVERIFY(!nvml.open("0000:01:00.0"));
+    std::unique_ptr<GpuTelemetrySource> source = GpuTelemetrySource::create(nvidiaInfo("0000:01:00.0"));
+    QVERIFY(source);
+    QCOMPARE(source->name(), "nvidia-smi");
+    // 初始化失败时不能调用 nvmlShutdown
+    QCOMPARE(m_initCount(), initCount);
+}
+
+void NvmlTelemetryTest::lookupByPciAddress()
+{
+    std::unique_ptr<GpuTelemetrySource> source = GpuTelemetrySource::create(nvidiaInfo("0000:01:00.0"));
+    QVERIFY(source);
+    QCOMPARE(source->name(), "nvml");
+
+    GpuSample sample;
+    QVERIFY(source->read(sample));
+    QVERIFY(sample.valid);
+    QCOMPARE(sample.usage, 77.0);
+    QCOMPARE(sample.temperature, 64.0);
+    QCOMPARE(sample.memoryUsed, quint64(1) << 30);
+    QCOMPARE(sample.memoryTotal, quint64(8) << 30);
+    QCOMPARE(sample.power, 123.456);
+}
+
+void NvmlTelemetryTest::lookupByIndex()
+{
+    // 没有 PCI 地址，或桩库不认识这个地址时，都退回 0 号设备
+    NvmlTelemetry nvml;
+    GpuSample sample;
+    QVERIFY(nvml.open(QString()));
+    QVERIFY(nvml.read(sample));
+    QCOMPARE(sample.usage, 11.0);
+
+    QVERIFY(nvml.open("0000:65:00.0"));
+    QVERIFY(nvml.read(sample));
+    QCOMPARE(sample.usage, 11.0);
+}
+
+void NvmlTelemetryTest::processBufferGrows()
+{
+    // 40 个计算进程超过初始容量 32：第一次读取扩容重试一次，之后复用扩大后的缓冲区
+    NvmlTelemetry nvml;
+    QVERIFY(nvml.open("0000:01:00.0"));
+    const int insufficientBefore = m_insufficientSizeCount();
+
+    GpuSample sample;
+    QVERIFY(nvml.read(sample));
+    QCOMPARE(m_insufficientSizeCount(), insufficientBefore + 1);
+    // 40 个计算进程加一个只出现在图形列表中的进程，pid 1000 两个列表都有，只算一次
+    QCOMPARE(sample.processes.size(), qsizetype(41));
+
+    QVERIFY(nvml.read(sample));
+    QCOMPARE(m_insufficientSizeCount(), insufficientBefore + 1);
+    QCOMPARE(sample.processes.size(), qsizetype(41));
+
+    // 按显存从大到小：pid 1000 取两个列表中较大的 500 MiB，其次是 pid 1039 的 40 MiB
+    QCOMPARE(sample.processes[0].pid, quint32(1000));
+    QCOMPARE(sample.processes[0].memoryUsed, quint64(500) << 20);
+    QCOMPARE(sample.processes[1].pid, quint32(1039));
+    QCOMPARE(sample.processes[1].memoryUsed, quint64(40) << 20);
+
+    // 逐项检查数组中下标 0 以外的条目，步长不对时 pid 和显存会错位
+    QHash<quint32, quint64> memoryByPid;
+    for (const GpuProcessMemory &process : sample.processes) memoryByPid.insert(process.pid, process.memoryUsed);
+    QCOMPARE(memoryByPid.size(), qsizetype(41));
+    for (quint32 i = 1; i < 40; ++i) {
+        QVERIFY2(memoryByPid.contains(1000 + i), qPrintable(QString::number(1000 + i)));
+        QCOMPARE(memoryByPid.value(1000 + i), quint64(i + 1) << 20);
+    }
+    QVERIFY(memoryByPid.contains(5));
+}
+
+void NvmlTelemetryTest::unavailableProcessMemoryIsZero()
+{
+    qputenv("STUB_NVML_PROCESS_COUNT", "3");
+    NvmlTelemetry nvml;
+    QVERIFY(nvml.open("0000:01:00.0"));
+
+    GpuSample sample;
+    QVERIFY(nvml.read(sample));
+    QCOMPARE(sample.processes.size(), qsizetype(4));
+    // 驱动不提供显存（NVML_VALUE_NOT_AVAILABLE）的进程按 0 处理，排在最后
+    QCOMPARE(sample.processes.last().pid, quint32(5));
+    QCOMPARE(sample.processes.last().memoryUsed, quint64(0));
+}
+
+void NvmlTelemetryTest::shutdownIsBalanced()
+{
+    const int initCount = m_initCount();
+    {
+        NvmlTelemetry first;
+        NvmlTelemetry second;
+        QVERIFY(first.open("0000:01:00.0"));
+        QVERIFY(second.open(QString()));
+        QCOMPARE(m_initCount(), initCount + 2);
+
+        // 重新打开先关闭旧的
+        QVERIFY(first.open(QString()));
+        QCOMPARE(m_initCount(), initCount + 2);
+
+        second.close();
+        QVERIFY(!second.isOpen());
+        QCOMPARE(m_initCount(), initCount + 1);
+    }
+    QCOMPARE(m_initCount(), initCount);
+}
+
+QTEST_GUILESS_MAIN(NvmlTelemetryTest)
+#include "tst_nvmltelemetry.moc"
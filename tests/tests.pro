@@ -0,0 +1,7 @@
+# 单元测试：qmake tests.pro && make check
+TEMPLATE = subdirs
+SUBDIRS += \
+    counterrate \
+    gputelemetry \
+    nvml \
+    procfsbatch